@@ -0,0 +1,835 @@
+#ifndef S21_CONTAINERS_SRC_S21_BTREE_H_
+#define S21_CONTAINERS_SRC_S21_BTREE_H_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__SSE4_2__)
+#include <nmmintrin.h>
+#endif
+
+#include "s21_tree.h"
+
+namespace s21 {
+
+namespace btree_detail {
+
+// Значение незанятых слотов узла. Оно не меньше любого ключа, поэтому
+// подсчет "сколько ключей меньше искомого" можно вести по целым группам
+// слотов, не проверяя границу заполненной части.
+template <typename Key>
+constexpr Key padKey() noexcept {
+  return std::numeric_limits<Key>::has_infinity
+             ? std::numeric_limits<Key>::infinity()
+             : std::numeric_limits<Key>::max();
+}
+
+// Число ключей меньше key среди первых n слотов, n кратно 4. Цикл без
+// ветвлений с постоянным шагом компилятор векторизует сам, а для 32- и
+// 64-битных целых ниже есть явные SSE-версии.
+template <typename Key>
+inline std::size_t countLess(const Key *keys, std::size_t n,
+                             Key key) noexcept {
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < n; ++i) count += keys[i] < key;
+  return count;
+}
+
+#if defined(__SSE2__)
+// каждое сравнение дает -1 в совпавших дорожках, поэтому счетчик вычитает
+inline std::size_t countLess(const std::int32_t *keys, std::size_t n,
+                             std::int32_t key) noexcept {
+  const __m128i needle = _mm_set1_epi32(key);
+  __m128i count = _mm_setzero_si128();
+  for (std::size_t i = 0; i < n; i += 4) {
+    const __m128i block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(keys + i));
+    count = _mm_sub_epi32(count, _mm_cmplt_epi32(block, needle));
+  }
+  count = _mm_add_epi32(count, _mm_shuffle_epi32(count, 0x4E));
+  count = _mm_add_epi32(count, _mm_shuffle_epi32(count, 0xB1));
+  return static_cast<std::size_t>(_mm_cvtsi128_si32(count));
+}
+#endif
+
+#if defined(__SSE4_2__) && defined(__x86_64__)
+inline std::size_t countLess(const std::int64_t *keys, std::size_t n,
+                             std::int64_t key) noexcept {
+  const __m128i needle = _mm_set1_epi64x(key);
+  __m128i count = _mm_setzero_si128();
+  for (std::size_t i = 0; i < n; i += 2) {
+    const __m128i block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(keys + i));
+    count = _mm_sub_epi64(count, _mm_cmpgt_epi64(needle, block));
+  }
+  count = _mm_add_epi64(count, _mm_unpackhi_epi64(count, count));
+  return static_cast<std::size_t>(_mm_cvtsi128_si64(count));
+}
+#endif
+
+}  // namespace btree_detail
+
+// B+-дерево с широкими узлами, на котором построены btree_set и btree_map.
+//
+// Key        - тип ключа
+// Value      - тип хранимого значения; для множества совпадает с Key
+// KeyOfValue - функтор, возвращающий ключ хранимого значения
+// Compare    - строгое слабое упорядочивание ключей
+// NodeBytes  - примерный размер узла в байтах, по нему считается число
+//              слотов; узел из нескольких кеш-линий читается подряд, и
+//              аппаратная предвыборка успевает подтянуть его целиком
+//
+// Все элементы лежат в листьях, листья связаны в двусвязный список, так что
+// обход диапазона - это проход по массивам без подъема к корню.
+// Внутренние узлы хранят только разделители: в поддереве children[i] все
+// ключи меньше keys[i], в children[i + 1] - не меньше.
+//
+// Ключи каждого узла лежат подряд в отдельном массиве. Для арифметических
+// ключей с std::less поиск в узле - это подсчет ключей меньше искомого по
+// всему массиву (SSE или автовекторизация), а хвост массива заполнен
+// padKey(); для остальных - двоичный поиск. В листе словаря рядом с
+// массивом ключей лежат сами пары, и ключ в них дублируется: итератор
+// возвращает настоящую ссылку на пару, как у map.
+//
+// Ключ и значение должны конструироваться по умолчанию и перемещаться без
+// исключений: слоты узла - обычные массивы, элементы переезжают при
+// вставке, удалении, делении и слиянии узлов. Поэтому вставка и удаление
+// делают недействительными все итераторы.
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Compare = std::less<Key>, std::size_t NodeBytes = 512>
+class btree {
+ public:
+  using key_type = Key;
+  using value_type = Value;
+  using size_type = std::size_t;
+  using key_compare = Compare;
+
+ private:
+  static constexpr bool kStoresValues = !std::is_same_v<Key, Value>;
+  static constexpr bool kLinearSearch =
+      std::is_arithmetic_v<Key> && std::is_same_v<Compare, std::less<Key>>;
+  static constexpr size_type kHeaderBytes = 4 * sizeof(void *);
+
+  // сколько записей по entry_bytes помещается в узел, с шагом 4 под SIMD
+  static constexpr size_type slotsFor(size_type entry_bytes) {
+    size_type slots = NodeBytes > kHeaderBytes
+                          ? (NodeBytes - kHeaderBytes) / entry_bytes / 4 * 4
+                          : 0;
+    return slots < 4 ? 4 : slots;
+  }
+
+  static constexpr size_type kLeafSlots =
+      slotsFor(sizeof(Key) + (kStoresValues ? sizeof(Value) : 0));
+  static constexpr size_type kInnerSlots =
+      slotsFor(sizeof(Key) + sizeof(void *));
+  // меньше минимума может быть только корень
+  static constexpr size_type kLeafMin = (kLeafSlots - 1) / 2;
+  static constexpr size_type kInnerMin = (kInnerSlots - 1) / 2;
+  // в каждом внутреннем узле хотя бы два ребенка, а элементов меньше 2^64
+  static constexpr size_type kMaxDepth = 64;
+
+  static_assert(kLeafSlots <= std::numeric_limits<std::uint16_t>::max() &&
+                    kInnerSlots <= std::numeric_limits<std::uint16_t>::max(),
+                "NodeBytes is too large");
+
+  struct Node {
+    std::uint16_t count = 0;
+    bool leaf;
+
+    explicit Node(bool is_leaf) noexcept : leaf(is_leaf) {}
+  };
+
+  struct NoValues {};
+
+  struct Leaf : Node {
+    Leaf *prev = nullptr;
+    Leaf *next = nullptr;
+    Key keys[kLeafSlots];
+    std::conditional_t<kStoresValues, std::array<Value, kLeafSlots>, NoValues>
+        values;
+
+    Leaf() : Node(true) { resetKeys(keys, 0, kLeafSlots); }
+  };
+
+  struct Inner : Node {
+    Key keys[kInnerSlots];
+    Node *children[kInnerSlots + 1];
+
+    Inner() : Node(false) { resetKeys(keys, 0, kInnerSlots); }
+  };
+
+  // Путь от корня к листу: внутренние узлы и номера детей, по которым шел
+  // спуск. Заменяет указатели на родителя при делении и слиянии узлов.
+  struct Path {
+    Inner *nodes[kMaxDepth];
+    size_type slots[kMaxDepth];
+    size_type depth = 0;
+  };
+
+ public:
+  template <typename Reference, typename Pointer>
+  class Iterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Value;
+    using difference_type = std::ptrdiff_t;
+    using reference = Reference;
+    using pointer = Pointer;
+
+    inline Iterator() noexcept : leaf_(nullptr), index_(0) {}
+
+    // iterator -> const_iterator
+    template <typename OtherReference, typename OtherPointer,
+              std::enable_if_t<std::is_convertible_v<OtherPointer, Pointer>,
+                               int> = 0>
+    inline Iterator(
+        const Iterator<OtherReference, OtherPointer> &other) noexcept
+        : leaf_(other.leaf_), index_(other.index_) {}
+
+    inline Reference operator*() const noexcept {
+      return valueAt(leaf_, index_);
+    }
+    inline Pointer operator->() const noexcept {
+      return &valueAt(leaf_, index_);
+    }
+
+    // end() - позиция за последним элементом последнего листа
+    inline Iterator &operator++() noexcept {
+      if (++index_ == leaf_->count && leaf_->next != nullptr) {
+        leaf_ = leaf_->next;
+        index_ = 0;
+      }
+      return *this;
+    }
+
+    inline Iterator operator++(int) noexcept {
+      Iterator temp = *this;
+      ++(*this);
+      return temp;
+    }
+
+    inline Iterator &operator--() noexcept {
+      if (index_ == 0) {
+        leaf_ = leaf_->prev;
+        index_ = leaf_->count;
+      }
+      --index_;
+      return *this;
+    }
+
+    inline Iterator operator--(int) noexcept {
+      Iterator temp = *this;
+      --(*this);
+      return temp;
+    }
+
+    inline bool operator==(const Iterator &other) const noexcept {
+      return leaf_ == other.leaf_ && index_ == other.index_;
+    }
+
+    inline bool operator!=(const Iterator &other) const noexcept {
+      return !(*this == other);
+    }
+
+   private:
+    inline Iterator(Leaf *leaf, size_type index) noexcept
+        : leaf_(leaf), index_(index) {}
+
+    Leaf *leaf_;
+    size_type index_;
+
+    template <typename, typename>
+    friend class Iterator;
+    friend class btree;
+  };
+
+  using iterator = Iterator<Value &, Value *>;
+  using const_iterator = Iterator<const Value &, const Value *>;
+
+  btree() noexcept {}
+
+  btree(const btree &other) : comp_(other.comp_) {
+    if (other.root_ == nullptr) return;
+    Leaf *prev = nullptr;
+    root_ = clone(other.root_, prev);
+    last_ = prev;
+    size_ = other.size_;
+  }
+
+  btree(btree &&other) noexcept : btree() { swap(other); }
+
+  ~btree() { clear(); }
+
+  btree &operator=(const btree &other) {
+    if (this != &other) {
+      btree copy(other);
+      swap(copy);
+    }
+    return *this;
+  }
+
+  btree &operator=(btree &&other) noexcept {
+    if (this != &other) {
+      btree moved(std::move(other));
+      swap(moved);
+    }
+    return *this;
+  }
+
+  inline iterator begin() const noexcept {
+    return first_ == nullptr ? iterator() : iterator(first_, 0);
+  }
+
+  inline iterator end() const noexcept {
+    return last_ == nullptr ? iterator() : iterator(last_, last_->count);
+  }
+
+  inline bool empty() const noexcept { return size_ == 0; }
+  inline size_type size() const noexcept { return size_; }
+  inline size_type max_size() const noexcept {
+    return std::numeric_limits<size_type>::max() / sizeof(Leaf) * kLeafMin;
+  }
+  inline key_compare key_comp() const { return comp_; }
+
+  void clear() noexcept {
+    if (root_ != nullptr) destroy(root_);
+    root_ = nullptr;
+    first_ = last_ = nullptr;
+    size_ = 0;
+  }
+
+  void swap(btree &other) noexcept {
+    std::swap(root_, other.root_);
+    std::swap(first_, other.first_);
+    std::swap(last_, other.last_);
+    std::swap(size_, other.size_);
+    std::swap(comp_, other.comp_);
+  }
+
+  template <typename Arg>
+  std::pair<iterator, bool> insert(Arg &&value) {
+    const Key &key = KeyOfValue()(value);
+    return emplaceKey(key, std::forward<Arg>(value));
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    Value value(std::forward<Args>(args)...);
+    return insert(std::move(value));
+  }
+
+  // конструирует значение из args, только если ключа еще нет
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key &key, Args &&...args) {
+    return emplaceKey(key, std::forward<Args>(args)...);
+  }
+
+  // Переносит из other элементы с ключами, которых здесь нет; остальные
+  // остаются в other. Путь к записи в other ищется до переноса: у set
+  // ключ и есть значение, и после перемещения по нему уже не найти.
+  void merge(btree &other) {
+    if (this == &other) return;
+    iterator it = other.begin();
+    while (it != other.end()) {
+      Leaf *leaf = it.leaf_;
+      const size_type index = it.index_;
+      const Key &key = leaf->keys[index];
+      if (contains(key)) {
+        ++it;
+        continue;
+      }
+      Path path;
+      other.descend(key, &path);
+      emplaceKey(key, std::move(valueAt(leaf, index)));
+      it = other.eraseAt(path, leaf, index);
+    }
+  }
+
+  // возвращает итератор на элемент, следовавший за удаленным
+  iterator erase(const_iterator pos) {
+    Path path;
+    Leaf *leaf = descend(pos.leaf_->keys[pos.index_], &path);
+    return eraseAt(path, leaf, pos.index_);
+  }
+
+  size_type erase(const Key &key) {
+    if (root_ == nullptr) return 0;
+    Path path;
+    Leaf *leaf = descend(key, &path);
+    size_type index = lowerIndex(leaf->keys, leaf->count, key);
+    if (index == leaf->count || comp_(key, leaf->keys[index])) return 0;
+    eraseAt(path, leaf, index);
+    return 1;
+  }
+
+  iterator find(const Key &key) const {
+    if (root_ == nullptr) return end();
+    Leaf *leaf = descend(key, nullptr);
+    size_type index = lowerIndex(leaf->keys, leaf->count, key);
+    if (index == leaf->count || comp_(key, leaf->keys[index])) return end();
+    return iterator(leaf, index);
+  }
+
+  bool contains(const Key &key) const {
+    if (root_ == nullptr) return false;
+    const Leaf *leaf = descend(key, nullptr);
+    size_type index = lowerIndex(leaf->keys, leaf->count, key);
+    return index != leaf->count && !comp_(key, leaf->keys[index]);
+  }
+
+  inline size_type count(const Key &key) const { return contains(key); }
+
+  iterator lower_bound(const Key &key) const {
+    if (root_ == nullptr) return end();
+    Leaf *leaf = descend(key, nullptr);
+    return normalize(leaf, lowerIndex(leaf->keys, leaf->count, key));
+  }
+
+  iterator upper_bound(const Key &key) const {
+    iterator pos = lower_bound(key);
+    if (pos != end() && !comp_(key, KeyOfValue()(*pos))) ++pos;
+    return pos;
+  }
+
+  std::pair<iterator, iterator> equal_range(const Key &key) const {
+    return {lower_bound(key), upper_bound(key)};
+  }
+
+ private:
+  static inline Value &valueAt(Leaf *leaf, size_type index) noexcept {
+    if constexpr (kStoresValues) {
+      return leaf->values[index];
+    } else {
+      return leaf->keys[index];
+    }
+  }
+
+  static inline void resetKeys(Key *keys, size_type first, size_type last) {
+    if constexpr (kLinearSearch) {
+      std::fill(keys + first, keys + last, btree_detail::padKey<Key>());
+    } else {
+      for (size_type i = first; i < last; ++i) keys[i] = Key();
+    }
+  }
+
+  // Первый слот с ключом не меньше key. Для линейного поиска хвост массива
+  // за count заполнен padKey(), поэтому считаем по count, округленному до 4.
+  template <std::size_t N>
+  inline size_type lowerIndex(const Key (&keys)[N], size_type count,
+                              const Key &key) const {
+    if constexpr (kLinearSearch) {
+      return btree_detail::countLess(keys, (count + 3) & ~size_type(3), key);
+    } else {
+      size_type base = 0;
+      while (count > 0) {
+        const size_type half = count / 2;
+        if (comp_(keys[base + half], key)) {
+          base += half + 1;
+          count -= half + 1;
+        } else {
+          count = half;
+        }
+      }
+      return base;
+    }
+  }
+
+  // ребенок, в поддереве которого лежит key: равный разделитель ведет вправо
+  inline size_type childIndex(const Inner *inner, const Key &key) const {
+    size_type index = lowerIndex(inner->keys, inner->count, key);
+    return index + (index < inner->count && !comp_(key, inner->keys[index]));
+  }
+
+  Leaf *descend(const Key &key, Path *path) const {
+    Node *node = root_;
+    while (!node->leaf) {
+      Inner *inner = static_cast<Inner *>(node);
+      const size_type child = childIndex(inner, key);
+      if (path != nullptr) {
+        path->nodes[path->depth] = inner;
+        path->slots[path->depth++] = child;
+      }
+      node = inner->children[child];
+    }
+    return static_cast<Leaf *>(node);
+  }
+
+  // позиция index == count означает первый элемент следующего листа
+  inline iterator normalize(Leaf *leaf, size_type index) const noexcept {
+    if (index == leaf->count && leaf->next != nullptr) {
+      return iterator(leaf->next, 0);
+    }
+    return iterator(leaf, index);
+  }
+
+  //________________________ записи листа ________________________
+
+  static void moveEntries(Leaf *from, size_type first, size_type last,
+                          Leaf *to, size_type dest) noexcept {
+    std::move(from->keys + first, from->keys + last, to->keys + dest);
+    if constexpr (kStoresValues) {
+      std::move(from->values.begin() + first, from->values.begin() + last,
+                to->values.begin() + dest);
+    }
+  }
+
+  // сдвигает записи [first, count) на одну вправо
+  static void shiftRight(Leaf *leaf, size_type first) noexcept {
+    std::move_backward(leaf->keys + first, leaf->keys + leaf->count,
+                       leaf->keys + leaf->count + 1);
+    if constexpr (kStoresValues) {
+      std::move_backward(leaf->values.begin() + first,
+                         leaf->values.begin() + leaf->count,
+                         leaf->values.begin() + leaf->count + 1);
+    }
+  }
+
+  // освобожденные слоты снова становятся пустыми
+  static void resetEntries(Leaf *leaf, size_type first, size_type last) {
+    resetKeys(leaf->keys, first, last);
+    if constexpr (kStoresValues) {
+      for (size_type i = first; i < last; ++i) leaf->values[i] = Value();
+    }
+  }
+
+  static void removeEntry(Leaf *leaf, size_type index) {
+    moveEntries(leaf, index + 1, leaf->count, leaf, index);
+    --leaf->count;
+    resetEntries(leaf, leaf->count, leaf->count + 1);
+  }
+
+  //_______________________ вставка _______________________
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplaceKey(const Key &key, Args &&...args) {
+    Path path;
+    Leaf *leaf = nullptr;
+    size_type index = 0;
+    if (root_ != nullptr) {
+      leaf = descend(key, &path);
+      index = lowerIndex(leaf->keys, leaf->count, key);
+      if (index < leaf->count && !comp_(key, leaf->keys[index])) {
+        return {iterator(leaf, index), false};
+      }
+    }
+
+    // Значение, конструктор которого может бросить, строится до первого
+    // изменения дерева. Остальные - после выделения узлов: если бросит
+    // выделение, источник (элемент другого дерева при merge) еще не
+    // перемещен. Деление без вставки оставляет дерево корректным.
+    auto makeRoom = [&] {
+      if (root_ == nullptr) {
+        leaf = new Leaf;
+        root_ = first_ = last_ = leaf;
+      } else if (leaf->count == kLeafSlots) {
+        split(path, leaf, index);
+      }
+    };
+    constexpr bool kNothrowBuild =
+        std::is_nothrow_constructible_v<Value, Args &&...>;
+    if constexpr (kNothrowBuild) makeRoom();
+    Value value(std::forward<Args>(args)...);
+    if constexpr (!kNothrowBuild) makeRoom();
+
+    shiftRight(leaf, index);
+    if constexpr (kStoresValues) {
+      leaf->keys[index] = KeyOfValue()(value);
+      leaf->values[index] = std::move(value);
+    } else {
+      leaf->keys[index] = std::move(value);
+    }
+    ++leaf->count;
+    ++size_;
+    return {iterator(leaf, index), true};
+  }
+
+  // Делит полный лист и столько полных предков, сколько нужно, чтобы в
+  // листе освободилось место под вставку в позицию index. leaf и index
+  // указывают на место вставки после деления.
+  void split(const Path &path, Leaf *&leaf, size_type &index) {
+    size_type full = 0;
+    while (full < path.depth &&
+           path.nodes[path.depth - 1 - full]->count == kInnerSlots) {
+      ++full;
+    }
+    const size_type inners = full + (full == path.depth);
+
+    // память под все новые узлы берется заранее
+    std::unique_ptr<Leaf> spare_leaf(new Leaf);
+    std::unique_ptr<Inner> spare[kMaxDepth + 1];
+    for (size_type i = 0; i < inners; ++i) spare[i].reset(new Inner);
+    size_type used = 0;
+
+    Leaf *right = spare_leaf.release();
+    const size_type keep = kLeafSlots - kLeafSlots / 2;
+    moveEntries(leaf, keep, kLeafSlots, right, 0);
+    resetEntries(leaf, keep, kLeafSlots);
+    right->count = kLeafSlots - keep;
+    leaf->count = keep;
+    right->prev = leaf;
+    right->next = leaf->next;
+    if (leaf->next != nullptr) leaf->next->prev = right;
+    leaf->next = right;
+    if (last_ == leaf) last_ = right;
+    if (index > keep) {
+      leaf = right;
+      index -= keep;
+    }
+
+    Key separator = right->keys[0];
+    Node *child = right;
+    for (size_type level = path.depth;; --level) {
+      if (level == 0) {
+        Inner *root = spare[used++].release();
+        root->keys[0] = std::move(separator);
+        root->children[0] = root_;
+        root->children[1] = child;
+        root->count = 1;
+        root_ = root;
+        return;
+      }
+
+      Inner *parent = path.nodes[level - 1];
+      const size_type pos = path.slots[level - 1];
+      if (parent->count < kInnerSlots) {
+        insertChild(parent, pos, std::move(separator), child);
+        return;
+      }
+
+      // средний ключ уходит наверх, правая половина - в новый узел
+      Inner *sibling = spare[used++].release();
+      const size_type mid = kInnerSlots / 2;
+      Key up = std::move(parent->keys[mid]);
+      std::move(parent->keys + mid + 1, parent->keys + kInnerSlots,
+                sibling->keys);
+      std::copy(parent->children + mid + 1,
+                parent->children + kInnerSlots + 1, sibling->children);
+      resetKeys(parent->keys, mid, kInnerSlots);
+      sibling->count = kInnerSlots - mid - 1;
+      parent->count = mid;
+      if (pos <= mid) {
+        insertChild(parent, pos, std::move(separator), child);
+      } else {
+        insertChild(sibling, pos - mid - 1, std::move(separator), child);
+      }
+      separator = std::move(up);
+      child = sibling;
+    }
+  }
+
+  // вставляет разделитель в позицию pos и ребенка справа от него
+  static void insertChild(Inner *inner, size_type pos, Key &&separator,
+                          Node *child) noexcept {
+    std::move_backward(inner->keys + pos, inner->keys + inner->count,
+                       inner->keys + inner->count + 1);
+    std::copy_backward(inner->children + pos + 1,
+                       inner->children + inner->count + 1,
+                       inner->children + inner->count + 2);
+    inner->keys[pos] = std::move(separator);
+    inner->children[pos + 1] = child;
+    ++inner->count;
+  }
+
+  //_______________________ удаление _______________________
+
+  // удаляет разделитель pos и ребенка справа от него
+  static void removeChild(Inner *inner, size_type pos) {
+    std::move(inner->keys + pos + 1, inner->keys + inner->count,
+              inner->keys + pos);
+    std::copy(inner->children + pos + 2, inner->children + inner->count + 1,
+              inner->children + pos + 1);
+    --inner->count;
+    resetKeys(inner->keys, inner->count, inner->count + 1);
+  }
+
+  iterator eraseAt(Path &path, Leaf *leaf, size_type index) {
+    removeEntry(leaf, index);
+    --size_;
+    if (leaf == root_) {
+      if (leaf->count == 0) {
+        delete leaf;
+        root_ = first_ = last_ = nullptr;
+        return end();
+      }
+    } else if (leaf->count < kLeafMin) {
+      rebalanceLeaf(path, leaf, index);
+    }
+    return normalize(leaf, index);
+  }
+
+  // Лист стал меньше минимума: занимаем запись у соседа с тем же родителем
+  // или сливаемся с ним. leaf и index следят за элементом после удаленного.
+  void rebalanceLeaf(Path &path, Leaf *&leaf, size_type &index) {
+    Inner *parent = path.nodes[path.depth - 1];
+    const size_type pos = path.slots[path.depth - 1];
+    Leaf *left =
+        pos > 0 ? static_cast<Leaf *>(parent->children[pos - 1]) : nullptr;
+    Leaf *right = pos < parent->count
+                      ? static_cast<Leaf *>(parent->children[pos + 1])
+                      : nullptr;
+
+    if (left != nullptr && left->count > kLeafMin) {
+      shiftRight(leaf, 0);
+      moveEntries(left, left->count - 1, left->count, leaf, 0);
+      --left->count;
+      resetEntries(left, left->count, left->count + 1);
+      ++leaf->count;
+      parent->keys[pos - 1] = leaf->keys[0];
+      ++index;
+    } else if (right != nullptr && right->count > kLeafMin) {
+      moveEntries(right, 0, 1, leaf, leaf->count);
+      ++leaf->count;
+      removeEntry(right, 0);
+      parent->keys[pos] = right->keys[0];
+    } else if (left != nullptr) {
+      index += left->count;
+      mergeLeaves(left, leaf);
+      removeChild(parent, pos - 1);
+      leaf = left;
+      rebalanceInner(path, path.depth - 1);
+    } else {
+      mergeLeaves(leaf, right);
+      removeChild(parent, pos);
+      rebalanceInner(path, path.depth - 1);
+    }
+  }
+
+  // переносит все записи right в конец left и удаляет right
+  void mergeLeaves(Leaf *left, Leaf *right) noexcept {
+    moveEntries(right, 0, right->count, left, left->count);
+    left->count += right->count;
+    left->next = right->next;
+    if (right->next != nullptr) right->next->prev = left;
+    if (last_ == right) last_ = left;
+    delete right;
+  }
+
+  // из внутреннего узла path.nodes[level] удалили разделитель
+  void rebalanceInner(Path &path, size_type level) {
+    Inner *node = path.nodes[level];
+    if (level == 0) {
+      if (node->count == 0) {
+        root_ = node->children[0];
+        delete node;
+      }
+      return;
+    }
+    if (node->count >= kInnerMin) return;
+
+    Inner *parent = path.nodes[level - 1];
+    const size_type pos = path.slots[level - 1];
+    Inner *left =
+        pos > 0 ? static_cast<Inner *>(parent->children[pos - 1]) : nullptr;
+    Inner *right = pos < parent->count
+                       ? static_cast<Inner *>(parent->children[pos + 1])
+                       : nullptr;
+
+    if (left != nullptr && left->count > kInnerMin) {
+      // разделитель родителя спускается, последний ключ соседа поднимается
+      std::move_backward(node->keys, node->keys + node->count,
+                         node->keys + node->count + 1);
+      std::copy_backward(node->children, node->children + node->count + 1,
+                         node->children + node->count + 2);
+      node->keys[0] = std::move(parent->keys[pos - 1]);
+      node->children[0] = left->children[left->count];
+      ++node->count;
+      parent->keys[pos - 1] = std::move(left->keys[left->count - 1]);
+      --left->count;
+      resetKeys(left->keys, left->count, left->count + 1);
+    } else if (right != nullptr && right->count > kInnerMin) {
+      node->keys[node->count] = std::move(parent->keys[pos]);
+      node->children[node->count + 1] = right->children[0];
+      ++node->count;
+      parent->keys[pos] = std::move(right->keys[0]);
+      std::move(right->keys + 1, right->keys + right->count, right->keys);
+      std::copy(right->children + 1, right->children + right->count + 1,
+                right->children);
+      --right->count;
+      resetKeys(right->keys, right->count, right->count + 1);
+    } else if (left != nullptr) {
+      mergeInners(left, std::move(parent->keys[pos - 1]), node);
+      removeChild(parent, pos - 1);
+      rebalanceInner(path, level - 1);
+    } else {
+      mergeInners(node, std::move(parent->keys[pos]), right);
+      removeChild(parent, pos);
+      rebalanceInner(path, level - 1);
+    }
+  }
+
+  // left, разделитель и right становятся одним узлом
+  static void mergeInners(Inner *left, Key &&separator, Inner *right) {
+    left->keys[left->count] = std::move(separator);
+    std::move(right->keys, right->keys + right->count,
+              left->keys + left->count + 1);
+    std::copy(right->children, right->children + right->count + 1,
+              left->children + left->count + 1);
+    left->count += right->count + 1;
+    delete right;
+  }
+
+  //____________________ копирование и удаление ____________________
+
+  // копирует поддерево и пристегивает его листья к списку после prev
+  Node *clone(const Node *node, Leaf *&prev) {
+    if (node->leaf) {
+      Leaf *copy = new Leaf(*static_cast<const Leaf *>(node));
+      copy->prev = prev;
+      copy->next = nullptr;
+      if (prev != nullptr) {
+        prev->next = copy;
+      } else {
+        first_ = copy;
+      }
+      prev = copy;
+      return copy;
+    }
+
+    const Inner *inner = static_cast<const Inner *>(node);
+    Inner *copy = new Inner;
+    std::copy(inner->keys, inner->keys + inner->count, copy->keys);
+    size_type done = 0;
+    try {
+      for (; done <= inner->count; ++done) {
+        copy->children[done] = clone(inner->children[done], prev);
+      }
+    } catch (...) {
+      for (size_type i = 0; i < done; ++i) destroy(copy->children[i]);
+      delete copy;
+      throw;
+    }
+    copy->count = inner->count;
+    return copy;
+  }
+
+  static void destroy(Node *node) noexcept {
+    if (node->leaf) {
+      delete static_cast<Leaf *>(node);
+      return;
+    }
+    Inner *inner = static_cast<Inner *>(node);
+    for (size_type i = 0; i <= inner->count; ++i) destroy(inner->children[i]);
+    delete inner;
+  }
+
+  Node *root_ = nullptr;
+  Leaf *first_ = nullptr;  // самый левый лист, begin()
+  Leaf *last_ = nullptr;   // самый правый лист, end() стоит за ним
+  size_type size_ = 0;
+  Compare comp_;
+};
+
+}  // namespace s21
+
+#endif  // S21_CONTAINERS_SRC_S21_BTREE_H_
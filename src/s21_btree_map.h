@@ -0,0 +1,253 @@
+#ifndef S21_CONTAINERS_SRC_S21_BTREE_MAP_H_
+#define S21_CONTAINERS_SRC_S21_BTREE_MAP_H_
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+
+#include "s21_btree.h"
+
+namespace s21 {
+
+// Словарь на B+-дереве с широкими узлами: на каждом уровне поиск читает
+// один узел из нескольких соседних кеш-линий вместо узла на уровень, как в
+// map. Лист хранит ключи для поиска отдельным массивом, а пары - во
+// втором массиве, который при вставке и делении сдвигается присваиванием;
+// поэтому value_type - std::pair<Key, T>. Поиск идет по массиву ключей и
+// изменения ключа в паре не увидит, так что итератор, как у flat_map,
+// отдает пару ссылок pair<const Key &, T &>. Вставка и удаление делают
+// итераторы недействительными.
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          std::size_t NodeBytes = 512>
+class btree_map {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<Key, T>;
+  using reference = std::pair<const Key &, T &>;
+  using const_reference = std::pair<const Key &, const T &>;
+  using size_type = size_t;
+  using key_compare = Compare;
+
+ private:
+  using tree_type =
+      btree<Key, value_type, pair_first_key<value_type>, Compare, NodeBytes>;
+
+  // Двунаправленный итератор поверх итератора дерева; operator->
+  // возвращает временную пару ссылок.
+  template <bool Const>
+  class MapIterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = btree_map::value_type;
+    using difference_type = std::ptrdiff_t;
+    using reference = std::conditional_t<Const, btree_map::const_reference,
+                                         btree_map::reference>;
+
+    struct pointer {
+      reference pair;
+      inline const reference *operator->() const noexcept { return &pair; }
+    };
+
+    MapIterator() noexcept = default;
+    explicit MapIterator(typename tree_type::iterator it) noexcept : it_(it) {}
+    // iterator -> const_iterator
+    template <bool Other, typename = std::enable_if_t<Const && !Other>>
+    MapIterator(const MapIterator<Other> &other) noexcept
+        : it_(other.base()) {}
+
+    inline typename tree_type::iterator base() const noexcept { return it_; }
+
+    inline reference operator*() const noexcept {
+      return reference(it_->first, it_->second);
+    }
+    inline pointer operator->() const noexcept { return pointer{**this}; }
+
+    inline MapIterator &operator++() noexcept {
+      ++it_;
+      return *this;
+    }
+    inline MapIterator operator++(int) noexcept { return MapIterator(it_++); }
+    inline MapIterator &operator--() noexcept {
+      --it_;
+      return *this;
+    }
+    inline MapIterator operator--(int) noexcept { return MapIterator(it_--); }
+
+    inline bool operator==(MapIterator other) const noexcept {
+      return it_ == other.it_;
+    }
+    inline bool operator!=(MapIterator other) const noexcept {
+      return it_ != other.it_;
+    }
+
+   private:
+    typename tree_type::iterator it_;
+  };
+
+ public:
+  using iterator = MapIterator<false>;
+  using const_iterator = MapIterator<true>;
+
+  // default constructor, creates empty map
+  btree_map() noexcept {}
+  // initializer list constructor; on duplicate keys the first one wins
+  btree_map(std::initializer_list<value_type> const &items)
+      : btree_map(items.begin(), items.end()) {}
+  // range constructor
+  template <typename InputIt>
+  btree_map(InputIt first, InputIt last) {
+    insert(first, last);
+  }
+  // copy constructor
+  btree_map(const btree_map &other) = default;
+  // move constructor
+  btree_map(btree_map &&other) noexcept : btree_map() { swap(other); }
+  // destructor
+  ~btree_map() {}
+
+  btree_map &operator=(const btree_map &other) = default;
+  // assignment operator overload for moving object
+  btree_map &operator=(btree_map &&other) noexcept {
+    tree_ = std::move(other.tree_);
+    return *this;
+  }
+
+  // access specified element with bounds checking
+  T &at(const Key &key) const {
+    auto it = tree_.find(key);
+    if (it == tree_.end()) throw std::out_of_range("Key not found");
+
+    return it->second;
+  }
+
+  // access or insert specified element
+  inline T &operator[](const Key &key) {
+    return try_emplace(key).first->second;
+  }
+
+  inline T &operator[](Key &&key) {
+    return try_emplace(std::move(key)).first->second;
+  }
+
+  // returns an iterator to the beginning
+  inline iterator begin() const noexcept { return iterator(tree_.begin()); }
+  // returns an iterator to the end
+  inline iterator end() const noexcept { return iterator(tree_.end()); }
+
+  // checks whether the container is empty
+  inline bool empty() const noexcept { return tree_.empty(); }
+  // returns the number of elements
+  inline size_t size() const noexcept { return tree_.size(); }
+  // returns the maximum possible number of elements
+  inline size_t max_size() const noexcept { return tree_.max_size(); }
+  inline key_compare key_comp() const { return tree_.key_comp(); }
+
+  // clears the contents
+  inline void clear() noexcept { tree_.clear(); }
+
+  // inserts value and returns iterator to where the element is in the
+  // container and bool denoting whether the insertion took place
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return wrap(tree_.insert(value));
+  }
+
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return wrap(tree_.insert(std::move(value)));
+  }
+
+  // inserts value by key
+  std::pair<iterator, bool> insert(const Key &key, const T &obj) {
+    return try_emplace(key, obj);
+  }
+
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last) {
+    for (; first != last; ++first) tree_.insert(*first);
+  }
+
+  // inserts an element or assigns to the current element if the key already
+  // exists
+  std::pair<iterator, bool> insert_or_assign(const Key &key, const T &obj) {
+    auto result = try_emplace(key, obj);
+    if (!result.second) result.first->second = obj;
+
+    return result;
+  }
+
+  // constructs the element and inserts it if the key is not present
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    return wrap(tree_.emplace(std::forward<Args>(args)...));
+  }
+
+  // constructs the mapped value from args only if key is not present yet
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key &key, Args &&...args) {
+    return wrap(tree_.try_emplace(
+        key, std::piecewise_construct, std::forward_as_tuple(key),
+        std::forward_as_tuple(std::forward<Args>(args)...)));
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(Key &&key, Args &&...args) {
+    return wrap(tree_.try_emplace(
+        key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+        std::forward_as_tuple(std::forward<Args>(args)...)));
+  }
+
+  // erases element at pos, returns the iterator following it
+  iterator erase(const_iterator pos) {
+    return iterator(tree_.erase(pos.base()));
+  }
+  // erases element by key
+  size_type erase(const Key &key) { return tree_.erase(key); }
+
+  // swaps the contents
+  inline void swap(btree_map &other) noexcept { tree_.swap(other.tree_); }
+
+  // moves elements of other whose keys are not present here; the rest
+  // stay in other, as with map::merge
+  void merge(btree_map &other) { tree_.merge(other.tree_); }
+
+  iterator find(const Key &key) const { return iterator(tree_.find(key)); }
+
+  bool contains(const Key &key) const { return tree_.contains(key); }
+
+  size_type count(const Key &key) const { return tree_.count(key); }
+
+  iterator lower_bound(const Key &key) const {
+    return iterator(tree_.lower_bound(key));
+  }
+
+  iterator upper_bound(const Key &key) const {
+    return iterator(tree_.upper_bound(key));
+  }
+
+  std::pair<iterator, iterator> equal_range(const Key &key) const {
+    return {lower_bound(key), upper_bound(key)};
+  }
+
+ private:
+  static inline std::pair<iterator, bool> wrap(
+      std::pair<typename tree_type::iterator, bool> result) noexcept {
+    return {iterator(result.first), result.second};
+  }
+
+  tree_type tree_;
+};
+
+template <typename Key, typename T, typename Compare, std::size_t NodeBytes,
+          typename... Args>
+inline void insert_many(btree_map<Key, T, Compare, NodeBytes> &myMap,
+                        Args &&...args) {
+  (myMap.emplace(std::forward<Args>(args)), ...);
+}
+
+}  // namespace s21
+
+#endif  //  S21_CONTAINERS_SRC_S21_BTREE_MAP_H_
@@ -0,0 +1,126 @@
+#ifndef S21_CONTAINERS_SRC_S21_BTREE_SET_H_
+#define S21_CONTAINERS_SRC_S21_BTREE_SET_H_
+
+#include <functional>
+#include <initializer_list>
+
+#include "s21_btree.h"
+
+namespace s21 {
+
+// Множество на B+-дереве с широкими узлами: ключи каждого узла лежат
+// подряд, а для арифметических ключей поиск в узле идет SIMD-сравнением.
+// Вставка и удаление сдвигают ключи внутри узлов и делают итераторы
+// недействительными.
+template <typename Key, typename Compare = std::less<Key>,
+          std::size_t NodeBytes = 512>
+class btree_set {
+ private:
+  using tree_type = btree<Key, Key, identity_key<Key>, Compare, NodeBytes>;
+
+  tree_type tree_;
+
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+  using key_compare = Compare;
+
+  // ключи нельзя менять на месте, поэтому оба итератора константные
+  using iterator = typename tree_type::const_iterator;
+  using const_iterator = typename tree_type::const_iterator;
+
+  btree_set() noexcept {}
+
+  btree_set(std::initializer_list<value_type> const &items)
+      : btree_set(items.begin(), items.end()) {}
+
+  template <typename InputIt>
+  btree_set(InputIt first, InputIt last) {
+    insert(first, last);
+  }
+
+  btree_set(const btree_set &s) = default;
+
+  btree_set(btree_set &&s) noexcept : btree_set() { swap(s); }
+
+  ~btree_set() {}
+
+  btree_set &operator=(const btree_set &s) = default;
+
+  btree_set &operator=(btree_set &&s) noexcept {
+    tree_ = std::move(s.tree_);
+    return *this;
+  }
+
+  inline iterator begin() const noexcept { return tree_.begin(); }
+
+  inline iterator end() const noexcept { return tree_.end(); }
+
+  inline bool empty() const noexcept { return tree_.empty(); }
+
+  inline size_type size() const noexcept { return tree_.size(); }
+
+  inline size_type max_size() const noexcept { return tree_.max_size(); }
+
+  inline key_compare key_comp() const { return tree_.key_comp(); }
+
+  inline void clear() noexcept { tree_.clear(); }
+
+  inline std::pair<iterator, bool> insert(const value_type &value) {
+    return tree_.insert(value);
+  }
+
+  inline std::pair<iterator, bool> insert(value_type &&value) {
+    return tree_.insert(std::move(value));
+  }
+
+  template <typename InputIt>
+  inline void insert(InputIt first, InputIt last) {
+    for (; first != last; ++first) tree_.insert(*first);
+  }
+
+  template <typename... Args>
+  inline std::pair<iterator, bool> emplace(Args &&...args) {
+    return tree_.emplace(std::forward<Args>(args)...);
+  }
+
+  inline iterator erase(iterator pos) { return tree_.erase(pos); }
+
+  inline size_type erase(const Key &key) { return tree_.erase(key); }
+
+  inline void swap(btree_set &other) noexcept { tree_.swap(other.tree_); }
+
+  // moves keys of other that are not present here; duplicates stay in other
+  void merge(btree_set &other) { tree_.merge(other.tree_); }
+
+  inline iterator find(const Key &key) const { return tree_.find(key); }
+
+  inline bool contains(const Key &key) const { return tree_.contains(key); }
+
+  inline size_type count(const Key &key) const { return tree_.count(key); }
+
+  inline iterator lower_bound(const Key &key) const {
+    return tree_.lower_bound(key);
+  }
+
+  inline iterator upper_bound(const Key &key) const {
+    return tree_.upper_bound(key);
+  }
+
+  inline std::pair<iterator, iterator> equal_range(const Key &key) const {
+    return tree_.equal_range(key);
+  }
+};
+
+template <typename Key, typename Compare, std::size_t NodeBytes,
+          typename... Args>
+void insert_many(btree_set<Key, Compare, NodeBytes> &s, Args &&...args) {
+  (s.emplace(std::forward<Args>(args)), ...);
+}
+
+}  // namespace s21
+
+#endif  //  S21_CONTAINERS_SRC_S21_BTREE_SET_H_
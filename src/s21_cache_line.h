@@ -0,0 +1,16 @@
+#ifndef S21_CONTAINERS_SRC_S21_CACHE_LINE_H_
+#define S21_CONTAINERS_SRC_S21_CACHE_LINE_H_
+
+#include <cstddef>
+
+namespace s21 {
+
+// Размер строки кэша для разнесения данных, которые пишут разные потоки.
+// std::hardware_destructive_interference_size зависит от флагов сборки и
+// дает предупреждение в GCC, поэтому значение зафиксировано: 64 байта у
+// x86-64 и большинства ARM.
+inline constexpr std::size_t kCacheLineSize = 64;
+
+}  // namespace s21
+
+#endif  // S21_CONTAINERS_SRC_S21_CACHE_LINE_H_
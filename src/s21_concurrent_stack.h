@@ -0,0 +1,216 @@
+#ifndef S21_CONTAINERS_SRC_S21_CONCURRENT_STACK_H_
+#define S21_CONTAINERS_SRC_S21_CONCURRENT_STACK_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "s21_cache_line.h"
+
+namespace s21 {
+
+// Стек Трайбера без блокировок: вершина - один атомарный указатель,
+// push и pop меняют его CAS-ом.
+//
+// ABA: в старших 16 битах вершины лежит счетчик изменений, поэтому CAS
+// не пройдет, даже если по тому же адресу успел появиться новый узел.
+// Используется то, что адреса пользовательского пространства на x86-64 и
+// AArch64 занимают не больше 48 бит.
+//
+// Освобождение памяти - по эпохам, отдельно для каждого стека. Поток,
+// читающий узлы (pop, top), входит в текущую эпоху e и увеличивает
+// счетчик active_[e % 4]. Снятый им узел не удаляется сразу, а попадает в
+// список retired_[e % 4]. Эпоха сдвигается с e на e + 1, только когда в
+// e - 1 никого не осталось, поэтому одновременно живут потоки не больше
+// чем двух соседних эпох. Узел, снятый потоком эпохи k, могли видеть
+// потоки эпох k - 1..k + 1; после сдвига на k + 3 их не осталось, и при
+// этом сдвиге список эпохи k освобождается.
+//
+// Пока узел в стеке, его значение не меняется: pop копирует его, а не
+// перемещает, чтобы параллельный top читал целое значение. Для типов
+// только с перемещением pop перемещает, а top недоступен. Само значение
+// разрушается вместе с узлом, когда тот освобождается.
+template <typename T>
+class concurrent_stack {
+  static_assert(sizeof(void *) == 8,
+                "concurrent_stack packs a tag into 64-bit pointers");
+
+ public:
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = std::size_t;
+
+  concurrent_stack() noexcept = default;
+  concurrent_stack(const concurrent_stack &) = delete;
+  concurrent_stack &operator=(const concurrent_stack &) = delete;
+
+  ~concurrent_stack() {
+    freeChain(pointer(head_.load(std::memory_order_relaxed)), &Node::next);
+    for (std::atomic<Node *> &retired : retired_)
+      freeChain(retired.load(std::memory_order_relaxed), &Node::retired_next);
+  }
+
+  inline void push(const_reference value) { emplace(value); }
+  inline void push(value_type &&value) { emplace(std::move(value)); }
+
+  template <typename... Args>
+  void emplace(Args &&...args) {
+    Node *node = new Node(std::forward<Args>(args)...);
+    // push не читает чужие узлы, поэтому обходится без эпохи
+    std::uint64_t head = head_.load(std::memory_order_relaxed);
+    do {
+      node->next = pointer(head);
+    } while (!head_.compare_exchange_weak(head, tagged(node, head),
+                                          std::memory_order_release,
+                                          std::memory_order_relaxed));
+  }
+
+  // takes the top value; returns false when the stack is empty
+  bool try_pop(reference out) {
+    Epoch epoch(*this);
+    std::uint64_t head = head_.load(std::memory_order_acquire);
+    Node *node;
+    do {
+      node = pointer(head);
+      if (node == nullptr) return false;
+    } while (!head_.compare_exchange_weak(head, tagged(node->next, head),
+                                          std::memory_order_acquire,
+                                          std::memory_order_acquire));
+    // узел удалится не раньше выхода из эпохи, даже если копия бросит
+    epoch.retire(node);
+    if constexpr (std::is_copy_constructible_v<T>)
+      out = node->value;
+    else
+      out = std::move(node->value);
+    return true;
+  }
+
+  // throws std::out_of_range on an empty stack, use try_pop when other
+  // threads may empty it first
+  void pop() {
+    Epoch epoch(*this);
+    std::uint64_t head = head_.load(std::memory_order_acquire);
+    Node *node;
+    do {
+      node = pointer(head);
+      if (node == nullptr) throw std::out_of_range("concurrent_stack::pop");
+    } while (!head_.compare_exchange_weak(head, tagged(node->next, head),
+                                          std::memory_order_acquire,
+                                          std::memory_order_acquire));
+    epoch.retire(node);
+  }
+
+  // a copy: another thread may pop the element right after the call
+  value_type top() const {
+    Epoch epoch(*this);
+    Node *node = pointer(head_.load(std::memory_order_acquire));
+    if (node == nullptr) throw std::out_of_range("concurrent_stack::top");
+    return node->value;
+  }
+
+  inline bool empty() const noexcept {
+    return pointer(head_.load(std::memory_order_acquire)) == nullptr;
+  }
+
+ private:
+  struct Node {
+    template <typename... Args>
+    explicit Node(Args &&...args) : value(std::forward<Args>(args)...) {}
+
+    T value;
+    Node *next = nullptr;          // следующий в стеке, не меняется
+    Node *retired_next = nullptr;  // следующий в списке на удаление
+  };
+
+  // эпохи k и k + 4 делят счетчик и список; к моменту, когда появится
+  // k + 4, список k уже освобожден
+  static constexpr std::uint64_t kEpochs = 4;
+  static constexpr unsigned kAdvancePeriod = 32;
+  static constexpr int kTagShift = 48;
+  static constexpr std::uint64_t kPointerMask =
+      (std::uint64_t{1} << kTagShift) - 1;
+
+  static inline Node *pointer(std::uint64_t head) noexcept {
+    return reinterpret_cast<Node *>(head & kPointerMask);
+  }
+
+  // новая вершина с увеличенным счетчиком
+  static inline std::uint64_t tagged(Node *node,
+                                     std::uint64_t previous) noexcept {
+    const std::uint64_t tag = (previous >> kTagShift) + 1;
+    return tag << kTagShift | reinterpret_cast<std::uint64_t>(node);
+  }
+
+  static void freeChain(Node *node, Node *Node::*link) noexcept {
+    while (node != nullptr) {
+      Node *next = node->*link;
+      delete node;
+      node = next;
+    }
+  }
+
+  // Пребывание потока в эпохе на время одной операции.
+  class Epoch {
+   public:
+    explicit Epoch(const concurrent_stack &stack) noexcept : stack_(stack) {
+      for (;;) {
+        epoch_ = stack_.epoch_.load();
+        stack_.active_[epoch_ % kEpochs].count.fetch_add(1);
+        // эпоха могла сдвинуться до того, как нас стало видно
+        if (stack_.epoch_.load() == epoch_) break;
+        stack_.active_[epoch_ % kEpochs].count.fetch_sub(1);
+      }
+    }
+    Epoch(const Epoch &) = delete;
+    Epoch &operator=(const Epoch &) = delete;
+
+    // Сдвиг эпохи делается до выхода: пока мы в epoch_, эпоха не уйдет
+    // дальше epoch_ + 1 и никто не пишет в освобождаемый список. Сдвиг
+    // стоит CAS-а по общей строке, поэтому поток пробует его раз в
+    // kAdvancePeriod операций.
+    ~Epoch() {
+      static thread_local unsigned operations = 0;
+      if (++operations % kAdvancePeriod == 0) stack_.tryAdvance(epoch_);
+      stack_.active_[epoch_ % kEpochs].count.fetch_sub(1);
+    }
+
+    void retire(Node *node) noexcept {
+      std::atomic<Node *> &list = stack_.retired_[epoch_ % kEpochs];
+      node->retired_next = list.load(std::memory_order_relaxed);
+      while (!list.compare_exchange_weak(node->retired_next, node,
+                                         std::memory_order_release,
+                                         std::memory_order_relaxed)) {
+      }
+    }
+
+   private:
+    const concurrent_stack &stack_;
+    std::uint64_t epoch_;
+  };
+
+  // e -> e + 1, освобождая список эпохи e - 2 = (e + 1) - 3
+  void tryAdvance(std::uint64_t epoch) const noexcept {
+    if (active_[(epoch + kEpochs - 1) % kEpochs].count.load() != 0) return;
+    if (!epoch_.compare_exchange_strong(epoch, epoch + 1)) return;
+    freeChain(retired_[(epoch + kEpochs - 2) % kEpochs].exchange(nullptr),
+              &Node::retired_next);
+  }
+
+  struct alignas(kCacheLineSize) Counter {
+    std::atomic<size_type> count{0};
+  };
+
+  alignas(kCacheLineSize) std::atomic<std::uint64_t> head_{0};
+  // состояние эпох меняют и читатели (top), поэтому mutable
+  alignas(kCacheLineSize) mutable std::atomic<std::uint64_t> epoch_{0};
+  mutable Counter active_[kEpochs];
+  mutable std::atomic<Node *> retired_[kEpochs] = {};
+};
+
+}  // namespace s21
+
+#endif  // S21_CONTAINERS_SRC_S21_CONCURRENT_STACK_H_
@@ -1,6 +1,7 @@
 #ifndef S21_CONTAINERS_SRC_S21_CONTAINERS_H_
 #define S21_CONTAINERS_SRC_S21_CONTAINERS_H_
 
+#include "s21_deque.h"
 #include "s21_list.h"
 #include "s21_map.h"
 #include "s21_queue.h"
@@ -0,0 +1,1162 @@
+// Benchmarks for s21 containers.
+//
+// Usage: ./bench [filter] [scale]
+//   filter - run only benchmarks whose name contains this substring
+//   scale  - multiplier applied to the default element counts (e.g. 0.01 for
+//            a quick smoke run)
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <queue>
+#include <random>
+#include <set>
+#include <stack>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "s21_containers.h"
+#include "s21_containersplus.h"
+
+namespace {
+// number of operator new calls made so far by this binary
+size_t g_allocations = 0;
+}  // namespace
+
+void *operator new(std::size_t size) {
+  ++g_allocations;
+  if (void *p = std::malloc(size > 0 ? size : 1)) return p;
+  throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, std::align_val_t align) {
+  ++g_allocations;
+  const std::size_t alignment = static_cast<std::size_t>(align);
+  const std::size_t rounded = (size + alignment - 1) / alignment * alignment;
+  void *p = std::aligned_alloc(alignment, rounded > 0 ? rounded : alignment);
+  if (p != nullptr) return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete(void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept {
+  std::free(p);
+}
+
+namespace {
+
+const char *g_filter = nullptr;
+double g_scale = 1.0;
+
+size_t Scaled(size_t n) {
+  size_t scaled = static_cast<size_t>(static_cast<double>(n) * g_scale);
+  return scaled > 0 ? scaled : 1;
+}
+
+bool Enabled(const char *name) {
+  return g_filter == nullptr || std::strstr(name, g_filter) != nullptr;
+}
+
+template <typename F>
+double MeasureMs(F &&body) {
+  auto start = std::chrono::steady_clock::now();
+  body();
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+void Report(const char *name, size_t ops, double ms) {
+  std::printf("%-44s %12zu ops %10.2f ms %9.1f ns/op\n", name, ops, ms,
+              ms * 1e6 / static_cast<double>(ops));
+}
+
+void ReportAllocations(size_t allocations) {
+  std::printf("  allocations %34zu\n", allocations);
+}
+
+// prevents the optimizer from discarding a computed value
+volatile size_t g_sink = 0;
+
+// std containers gain contains() only in C++20
+template <typename Container, typename Key>
+auto ContainsImpl(const Container &c, const Key &key, int)
+    -> decltype(c.contains(key)) {
+  return c.contains(key);
+}
+
+template <typename Container, typename Key>
+bool ContainsImpl(const Container &c, const Key &key, long) {
+  return c.find(key) != c.end();
+}
+
+template <typename Container, typename Key>
+bool Contains(const Container &c, const Key &key) {
+  return ContainsImpl(c, key, 0);
+}
+
+std::vector<long> ShuffledKeys(size_t n) {
+  std::vector<long> keys(n);
+  for (size_t i = 0; i < n; ++i) keys[i] = static_cast<long>(i);
+  std::shuffle(keys.begin(), keys.end(), std::mt19937_64(42));
+  return keys;
+}
+
+//_________________>>VECTOR>>_________________
+
+// reserve alone, then reserve + push_back of non-trivial elements
+template <typename Vector>
+void VectorReservePushBack(const std::string &name, size_t n) {
+  if (!Enabled(name.c_str())) return;
+  const std::string sample(32, 'x');  // longer than the SSO buffer
+
+  Report((name + "/reserve").c_str(), n, MeasureMs([&] {
+           Vector v;
+           v.reserve(n);
+           g_sink = g_sink + v.capacity();
+         }));
+
+  Report((name + "/reserve+push_back").c_str(), n, MeasureMs([&] {
+           Vector v;
+           v.reserve(n);
+           for (size_t i = 0; i < n; ++i) v.push_back(sample);
+           g_sink = g_sink + v.size();
+         }));
+
+  Report((name + "/push_back").c_str(), n, MeasureMs([&] {
+           Vector v;
+           for (size_t i = 0; i < n; ++i) v.push_back(sample);
+           g_sink = g_sink + v.size();
+         }));
+}
+
+// fixed-size POD message; growth should be a bulk memory copy
+struct PodMessage {
+  long id;
+  char payload[56];
+};
+
+// grows the vector from empty through repeated reallocation
+template <typename Vector>
+void VectorGrowPod(const std::string &name, size_t n) {
+  if (!Enabled(name.c_str())) return;
+  PodMessage message = {};
+  Report(name.c_str(), n, MeasureMs([&] {
+           Vector v;
+           for (size_t i = 0; i < n; ++i) {
+             message.id = static_cast<long>(i);
+             v.push_back(message);
+           }
+           g_sink = g_sink + v.size();
+         }));
+}
+
+// order book style middle inserts and erases on a 100k element vector
+template <typename Vector>
+void VectorMiddleInsertErase(const std::string &name, size_t n, size_t ops) {
+  if (!Enabled(name.c_str())) return;
+  Vector v;
+  for (size_t i = 0; i < n; ++i) v.push_back(static_cast<long>(i));
+
+  Report((name + "/insert").c_str(), ops, MeasureMs([&] {
+           for (size_t i = 0; i < ops; ++i)
+             v.insert(v.begin() + (i * 7919) % v.size(), static_cast<long>(i));
+         }));
+  Report((name + "/erase").c_str(), ops, MeasureMs([&] {
+           for (size_t i = 0; i < ops; ++i)
+             v.erase(v.begin() + (i * 7919) % v.size());
+         }));
+
+  std::vector<long> batch(64, 1);
+  Report((name + "/insert_range64").c_str(), ops, MeasureMs([&] {
+           for (size_t i = 0; i < ops; ++i) {
+             auto pos = v.begin() + (i * 7919) % v.size();
+             v.insert(pos, batch.begin(), batch.end());
+             pos = v.begin() + (i * 7919) % v.size();
+             v.erase(pos, pos + 64);
+           }
+         }));
+  g_sink = g_sink + v.size();
+}
+
+void BenchVector() {
+  const size_t n = Scaled(1000000);
+  VectorReservePushBack<s21::vector<std::string>>("vector/string/s21", n);
+  VectorReservePushBack<std::vector<std::string>>("vector/string/std", n);
+
+  const size_t book = Scaled(100000);
+  VectorMiddleInsertErase<s21::vector<long>>("vector/middle/s21", book, 10000);
+  VectorMiddleInsertErase<std::vector<long>>("vector/middle/std", book, 10000);
+
+  // 4M * 64 bytes = 256 MB; scale 4 reaches 1 GB
+  const size_t pods = Scaled(4000000);
+  VectorGrowPod<s21::vector<PodMessage>>("vector/grow_pod/s21", pods);
+  VectorGrowPod<std::vector<PodMessage>>("vector/grow_pod/std", pods);
+}
+
+//__________________<<VECTOR<<________________
+
+//__________________>>LIST>>__________________
+
+// queue-like push_back/pop_front cycles over a small resident window
+template <typename Queue, typename Push, typename Pop>
+void ListPushPop(const char *name, size_t cycles, Push push, Pop pop) {
+  if (!Enabled(name)) return;
+  const size_t window = 1024;
+  const size_t allocations_before = g_allocations;
+  size_t sum = 0;
+  double ms = MeasureMs([&] {
+    Queue q;
+    for (size_t i = 0; i < window; ++i) push(q, static_cast<long>(i));
+    for (size_t i = 0; i < cycles; ++i) {
+      push(q, static_cast<long>(i));
+      sum += static_cast<size_t>(pop(q));
+    }
+  });
+  g_sink = g_sink + sum;
+  Report(name, cycles, ms);
+  ReportAllocations(g_allocations - allocations_before);
+}
+
+// sums a list front to back and back to front
+template <typename List>
+void ListIterate(const char *name, size_t n, size_t passes) {
+  if (!Enabled(name)) return;
+  List list;
+  for (size_t i = 0; i < n; ++i) list.push_back(static_cast<long>(i));
+  long sum = 0;
+  Report(name, n * passes, MeasureMs([&] {
+           for (size_t pass = 0; pass < passes; ++pass) {
+             for (auto it = list.begin(); it != list.end(); ++it) sum += *it;
+             for (auto it = list.end(); it != list.begin();) sum -= *--it;
+           }
+         }));
+  g_sink = g_sink + static_cast<size_t>(sum);
+}
+
+// sorts a list of shuffled keys in place
+template <typename List>
+void ListSort(const char *name, const std::vector<long> &keys) {
+  if (!Enabled(name)) return;
+  List list;
+  for (long key : keys) list.push_back(key);
+  Report(name, keys.size(), MeasureMs([&] { list.sort(); }));
+  g_sink = g_sink + static_cast<size_t>(list.front());
+}
+
+// merges two sorted lists of n elements each
+template <typename List>
+void ListMerge(const char *name, size_t n) {
+  if (!Enabled(name)) return;
+  List evens;
+  List odds;
+  for (size_t i = 0; i < n; ++i) {
+    evens.push_back(static_cast<long>(2 * i));
+    odds.push_back(static_cast<long>(2 * i + 1));
+  }
+  const size_t allocations_before = g_allocations;
+  Report(name, 2 * n, MeasureMs([&] { evens.merge(odds); }));
+  ReportAllocations(g_allocations - allocations_before);
+  g_sink = g_sink + evens.size();
+}
+
+void BenchList() {
+  const size_t cycles = Scaled(100000000);
+  auto push_back = [](auto &q, long v) { q.push_back(v); };
+  auto pop_front = [](auto &q) {
+    long v = q.front();
+    q.pop_front();
+    return v;
+  };
+  ListPushPop<s21::list<long>>("list/push_pop/s21", cycles, push_back,
+                               pop_front);
+  ListPushPop<std::list<long>>("list/push_pop/std", cycles, push_back,
+                               pop_front);
+
+  ListIterate<s21::list<long>>("list/iterate/s21", Scaled(1000000), 50);
+  ListIterate<std::list<long>>("list/iterate/std", Scaled(1000000), 50);
+
+  const std::vector<long> keys = ShuffledKeys(Scaled(1000000));
+  ListSort<s21::list<long>>("list/sort/s21", keys);
+  ListSort<std::list<long>>("list/sort/std", keys);
+
+  ListMerge<s21::list<long>>("list/merge/s21", Scaled(1000000));
+  ListMerge<std::list<long>>("list/merge/std", Scaled(1000000));
+}
+
+//__________________<<LIST<<__________________
+
+//__________________>>DEQUE>>_________________
+
+// the same push/pop cycles as for the list; the adaptors now default to
+// s21::deque, the list-backed rows show what they used to cost
+void BenchDeque() {
+  const size_t cycles = Scaled(100000000);
+  auto push_back = [](auto &q, long v) { q.push_back(v); };
+  auto pop_front = [](auto &q) {
+    long v = q.front();
+    q.pop_front();
+    return v;
+  };
+  auto push = [](auto &q, long v) { q.push(v); };
+  auto pop = [](auto &q) {
+    long v = q.front();
+    q.pop();
+    return v;
+  };
+  auto pop_top = [](auto &s) {
+    long v = s.top();
+    s.pop();
+    return v;
+  };
+  ListPushPop<s21::deque<long>>("deque/push_pop/s21", cycles, push_back,
+                                pop_front);
+  ListPushPop<std::deque<long>>("deque/push_pop/std", cycles, push_back,
+                                pop_front);
+
+  ListPushPop<s21::queue<long>>("queue/push_pop/s21", cycles, push, pop);
+  ListPushPop<s21::queue<long, s21::list<long>>>("queue/push_pop/s21_list",
+                                                 cycles, push, pop);
+  ListPushPop<std::queue<long>>("queue/push_pop/std", cycles, push, pop);
+
+  ListPushPop<s21::stack<long>>("stack/push_pop/s21", cycles, push, pop_top);
+  ListPushPop<s21::stack<long, s21::list<long>>>("stack/push_pop/s21_list",
+                                                 cycles, push, pop_top);
+  ListPushPop<std::stack<long>>("stack/push_pop/std", cycles, push, pop_top);
+}
+
+//__________________<<DEQUE<<_________________
+
+//_________________>>MAP>>__________________
+
+template <typename Map>
+void MapMonotonic(const char *name, size_t n) {
+  if (!Enabled(name)) return;
+  Map m;
+  double insert_ms = MeasureMs([&] {
+    for (size_t i = 0; i < n; ++i) m.insert({static_cast<long>(i), 0});
+  });
+  Report(name, n, insert_ms);
+
+  size_t found = 0;
+  double lookup_ms = MeasureMs([&] {
+    for (size_t i = 0; i < n; ++i) found += Contains(m, static_cast<long>(i));
+  });
+  g_sink = g_sink + found;
+  Report("  lookup", n, lookup_ms);
+}
+
+// O(n) construction from sorted input vs inserting the same keys one by one
+void MapBulkLoad(size_t n) {
+  std::vector<std::pair<long, int>> sorted(n);
+  for (size_t i = 0; i < n; ++i) sorted[i] = {static_cast<long>(i), 0};
+
+  if (Enabled("map/from_sorted/s21")) {
+    s21::map<long, int> m;
+    Report("map/from_sorted/s21", n, MeasureMs([&] {
+             m.assign_sorted(sorted.begin(), sorted.end());
+           }));
+    g_sink = g_sink + m.size();
+  }
+
+  // an unsorted batch into a half-full map: one sort, merge and rebuild
+  std::vector<std::pair<long, int>> batch(sorted.begin() + n / 2,
+                                          sorted.end());
+  std::shuffle(batch.begin(), batch.end(), std::mt19937_64(5));
+  if (Enabled("map/bulk_insert/s21")) {
+    s21::map<long, int> m;
+    m.assign_sorted(sorted.begin(), sorted.begin() + n / 2);
+    Report("map/bulk_insert/s21", batch.size(), MeasureMs([&] {
+             m.insert(batch.begin(), batch.end());
+           }));
+    g_sink = g_sink + m.size();
+  }
+  if (Enabled("map/bulk_insert/std")) {
+    std::map<long, int> m(sorted.begin(), sorted.begin() + n / 2);
+    Report("map/bulk_insert/std", batch.size(), MeasureMs([&] {
+             m.insert(batch.begin(), batch.end());
+           }));
+    g_sink = g_sink + m.size();
+  }
+}
+
+// merge a map of odd keys into a map of even keys
+template <typename Map>
+void MapMerge(const char *name, size_t n) {
+  if (!Enabled(name)) return;
+  Map evens;
+  Map odds;
+  for (size_t i = 0; i < n; ++i) {
+    evens.insert({static_cast<long>(2 * i), 0});
+    odds.insert({static_cast<long>(2 * i + 1), 0});
+  }
+  const size_t allocations_before = g_allocations;
+  Report(name, n, MeasureMs([&] { evens.merge(odds); }));
+  ReportAllocations(g_allocations - allocations_before);
+  g_sink = g_sink + evens.size();
+}
+
+// cost of keeping subtree sizes on insert, and rank() against counting
+// elements of std::map with std::distance
+template <typename Map>
+void MapRank(const char *name, size_t n, size_t probes) {
+  if (!Enabled(name)) return;
+  const std::vector<long> keys = ShuffledKeys(n);
+  Map m;
+  Report(name, n, MeasureMs([&] {
+           for (long key : keys) m.insert({key, 0});
+         }));
+
+  size_t total = 0;
+  double rank_ms = MeasureMs([&] {
+    for (size_t i = 0; i < probes; ++i) {
+      const long key = keys[i % n];
+      if constexpr (std::is_same_v<Map, s21::ranked_map<long, int>>) {
+        total += m.rank(key);
+      } else {
+        total += static_cast<size_t>(
+            std::distance(m.begin(), m.lower_bound(key)));
+      }
+    }
+  });
+  g_sink = g_sink + total;
+  Report("  rank", probes, rank_ms);
+}
+
+// expire the older half of a time-keyed map with one range erase
+template <typename Map>
+void MapExpire(const char *name, size_t n, bool one_by_one) {
+  if (!Enabled(name)) return;
+  Map m;
+  for (long key : ShuffledKeys(n)) m.insert({key, 0});
+  const long cutoff = static_cast<long>(n / 2);
+  Report(name, n / 2, MeasureMs([&] {
+           if (one_by_one) {
+             while (m.begin() != m.lower_bound(cutoff)) m.erase(m.begin());
+           } else {
+             m.erase(m.begin(), m.lower_bound(cutoff));
+           }
+         }));
+  g_sink = g_sink + m.size();
+}
+
+// lookups by std::string_view into string keys longer than the small
+// string buffer: a plain map needs a temporary std::string per probe
+template <typename Map, bool Transparent>
+void MapStringViewLookup(const char *name, size_t n) {
+  if (!Enabled(name)) return;
+  std::vector<std::string> keys(n);
+  for (size_t i = 0; i < n; ++i)
+    keys[i] = "session-token-" + std::to_string(i * 7919);
+  Map m;
+  for (const std::string &key : keys) m.insert({key, 0});
+  std::vector<std::string_view> probes(keys.begin(), keys.end());
+  std::shuffle(probes.begin(), probes.end(), std::mt19937_64(3));
+
+  size_t found = 0;
+  const size_t allocations_before = g_allocations;
+  Report(name, n, MeasureMs([&] {
+           for (std::string_view probe : probes) {
+             if constexpr (Transparent)
+               found += m.contains(probe);
+             else
+               found += m.contains(std::string(probe));
+           }
+         }));
+  ReportAllocations(g_allocations - allocations_before);
+  g_sink = g_sink + found;
+}
+
+void BenchMap() {
+  const size_t n = Scaled(10000000);
+  MapMonotonic<s21::map<long, int>>("map/monotonic_insert/s21", n);
+  MapMonotonic<std::map<long, int>>("map/monotonic_insert/std", n);
+  MapBulkLoad(n);
+  MapMerge<s21::map<long, int>>("map/merge/s21", Scaled(1000000));
+  MapMerge<std::map<long, int>>("map/merge/std", Scaled(1000000));
+  MapExpire<s21::map<long, int>>("map/expire/s21_range", Scaled(1000000),
+                                 false);
+  MapExpire<s21::map<long, int>>("map/expire/s21_one_by_one",
+                                 Scaled(1000000), true);
+  MapExpire<std::map<long, int>>("map/expire/std_range", Scaled(1000000),
+                                 false);
+  MapStringViewLookup<s21::map<std::string, int>, false>(
+      "map/string_view_find/s21", Scaled(1000000));
+  MapStringViewLookup<s21::map<std::string, int, std::less<>>, true>(
+      "map/string_view_find/s21_transparent", Scaled(1000000));
+  MapRank<s21::ranked_map<long, int>>("map/rank/ranked", Scaled(1000000),
+                                      Scaled(1000000));
+  MapRank<std::map<long, int>>("map/rank/std_distance", Scaled(1000000),
+                                Scaled(100));
+}
+
+//__________________<<MAP<<__________________
+
+//_______________>>MULTISET>>________________
+
+// histogram of few distinct values over many samples: one node per sample
+// against one counted node per distinct value
+template <typename Multiset>
+void MultisetHistogram(const char *name, size_t samples, size_t distinct) {
+  if (!Enabled(name)) return;
+  std::mt19937_64 gen(9);
+  std::vector<long> values(samples);
+  for (long &value : values) value = static_cast<long>(gen() % distinct);
+
+  Multiset ms;
+  const size_t allocations_before = g_allocations;
+  Report(name, samples, MeasureMs([&] {
+           for (long value : values) ms.insert(value);
+         }));
+  ReportAllocations(g_allocations - allocations_before);
+
+  size_t total = 0;
+  Report("  count", distinct, MeasureMs([&] {
+           for (size_t i = 0; i < distinct; ++i)
+             total += ms.count(static_cast<long>(i));
+         }));
+  g_sink = g_sink + total;
+}
+
+void BenchMultiset() {
+  const size_t samples = Scaled(10000000);
+  MultisetHistogram<s21::compact_multiset<long>>(
+      "multiset/histogram/compact", samples, 4096);
+  MultisetHistogram<s21::multiset<long>>("multiset/histogram/s21", samples,
+                                         4096);
+  MultisetHistogram<std::multiset<long>>("multiset/histogram/std", samples,
+                                         4096);
+}
+
+//_______________<<MULTISET<<________________
+
+//_______________>>ASSOCIATIVE>>______________
+
+// insert, lookup, full iteration and erase-from-begin over shuffled keys
+template <typename Container, typename MakeValue>
+void AssociativeWorkload(const std::string &name,
+                         const std::vector<long> &keys, MakeValue make) {
+  if (!Enabled(name.c_str())) return;
+  Container c;
+  Report((name + "/insert").c_str(), keys.size(), MeasureMs([&] {
+           for (long key : keys) c.insert(make(key));
+         }));
+
+  size_t found = 0;
+  Report((name + "/lookup").c_str(), keys.size(), MeasureMs([&] {
+           for (long key : keys) found += Contains(c, key);
+         }));
+
+  size_t visited = 0;
+  Report((name + "/iterate").c_str(), c.size(), MeasureMs([&] {
+           for (auto it = c.begin(); it != c.end(); ++it) ++visited;
+         }));
+
+  size_t erased = c.size();
+  Report((name + "/erase").c_str(), erased, MeasureMs([&] {
+           while (!c.empty()) c.erase(c.begin());
+         }));
+  g_sink = g_sink + found + visited;
+}
+
+void BenchAssociative() {
+  const std::vector<long> keys = ShuffledKeys(Scaled(1000000));
+  auto key = [](long k) { return k; };
+  auto pair = [](long k) { return std::pair<const long, int>(k, 0); };
+
+  AssociativeWorkload<s21::set<long>>("set/random/s21", keys, key);
+  AssociativeWorkload<std::set<long>>("set/random/std", keys, key);
+  AssociativeWorkload<s21::multiset<long>>("multiset/random/s21", keys, key);
+  AssociativeWorkload<std::multiset<long>>("multiset/random/std", keys, key);
+  AssociativeWorkload<s21::map<long, int>>("map/random/s21", keys, pair);
+  AssociativeWorkload<std::map<long, int>>("map/random/std", keys, pair);
+}
+
+//_______________<<ASSOCIATIVE<<______________
+
+//__________________>>FLAT>>__________________
+
+// flat containers take the whole range at once, trees insert one by one
+template <typename Container, typename It>
+auto BuildImpl(Container &c, It first, It last, int)
+    -> decltype(c.insert(first, last), void()) {
+  c.insert(first, last);
+}
+
+template <typename Container, typename It>
+void BuildImpl(Container &c, It first, It last, long) {
+  for (; first != last; ++first) c.insert(*first);
+}
+
+// random point lookups into n shuffled keys, half of them misses
+template <typename Container, typename MakeValue>
+void LookupLatency(const std::string &name, size_t n, size_t probes,
+                   size_t node_bytes, MakeValue make) {
+  if (!Enabled(name.c_str())) return;
+  // tree nodes carry three pointers and a malloc header each
+  const size_t kNodeBudgetBytes = size_t(2) << 30;
+  if (node_bytes != 0 && n > kNodeBudgetBytes / node_bytes) {
+    std::printf("%-44s skipped: needs about %zu MB of nodes\n", name.c_str(),
+                n / (1 << 20) * node_bytes);
+    return;
+  }
+
+  Container c;
+  {
+    std::vector<long> keys(n);
+    for (size_t i = 0; i < n; ++i) keys[i] = static_cast<long>(2 * i);
+    std::shuffle(keys.begin(), keys.end(), std::mt19937_64(42));
+    std::vector<typename Container::value_type> values;
+    values.reserve(n);
+    for (long key : keys) values.push_back(make(key));
+    Report((name + "/build").c_str(), n, MeasureMs([&] {
+             BuildImpl(c, values.begin(), values.end(), 0);
+           }));
+  }
+
+  std::vector<long> queries(probes);
+  std::mt19937_64 gen(7);
+  for (long &q : queries) q = static_cast<long>(gen() % (2 * n));
+  size_t found = 0;
+  Report((name + "/lookup").c_str(), probes, MeasureMs([&] {
+           for (long q : queries) found += Contains(c, q);
+         }));
+  g_sink = g_sink + found;
+}
+
+void BenchFlat() {
+  const size_t probes = Scaled(10000000);
+  auto key = [](long k) { return k; };
+  auto pair = [](long k) { return std::pair<long, int>(k, 0); };
+  auto const_pair = [](long k) { return std::pair<const long, int>(k, 0); };
+  const size_t tree_node = 64;
+
+  for (size_t n : {size_t(1000), size_t(1000000), size_t(100000000)}) {
+    n = Scaled(n);
+    const std::string suffix = "/" + std::to_string(n);
+    LookupLatency<s21::flat_set<long>>("flat_set" + suffix, n, probes, 0, key);
+    LookupLatency<s21::set<long>>("set" + suffix, n, probes, tree_node, key);
+    LookupLatency<s21::flat_map<long, int>>("flat_map" + suffix, n, probes, 0,
+                                            pair);
+    LookupLatency<s21::map<long, int>>("map" + suffix, n, probes, tree_node,
+                                       const_pair);
+  }
+}
+
+//__________________<<FLAT<<__________________
+
+//_________________>>BTREE>>__________________
+
+// key of a set element or of a map pair
+inline long ScanKey(long key) { return key; }
+
+template <typename Pair>
+inline long ScanKey(const Pair &item) {
+  return item.first;
+}
+
+// find a random present key, then walk `width` elements in order
+template <typename Container, typename MakeValue>
+void RangeScan(const std::string &name, size_t n, size_t scans, size_t width,
+               MakeValue make) {
+  if (!Enabled(name.c_str())) return;
+  Container c;
+  for (size_t i = 0; i < n; ++i) c.insert(make(static_cast<long>(2 * i)));
+
+  std::vector<long> starts(scans);
+  std::mt19937_64 gen(9);
+  for (long &start : starts) start = static_cast<long>(2 * (gen() % n));
+  size_t visited = 0;
+  Report(name.c_str(), scans * width, MeasureMs([&] {
+           for (long start : starts) {
+             auto it = c.find(start);
+             for (size_t i = 0; i < width && it != c.end(); ++i, ++it) {
+               visited += static_cast<size_t>(ScanKey(*it));
+             }
+           }
+         }));
+  g_sink = g_sink + visited;
+}
+
+void BenchBtree() {
+  const size_t probes = Scaled(10000000);
+  auto key = [](long k) { return k; };
+  auto pair = [](long k) { return std::pair<long, int>(k, 1); };
+  auto const_pair = [](long k) { return std::pair<const long, int>(k, 1); };
+  const size_t tree_node = 64;
+
+  for (size_t n : {size_t(1000), size_t(1000000), size_t(10000000)}) {
+    n = Scaled(n);
+    const std::string suffix = "/" + std::to_string(n);
+    LookupLatency<s21::btree_set<long>>("btree_set" + suffix, n, probes, 0,
+                                        key);
+    LookupLatency<s21::set<long>>("btree/set" + suffix, n, probes, tree_node,
+                                  key);
+    LookupLatency<s21::btree_map<long, int>>("btree_map" + suffix, n, probes,
+                                             0, pair);
+    LookupLatency<s21::map<long, int>>("btree/map" + suffix, n, probes,
+                                       tree_node, const_pair);
+  }
+
+  const size_t n = Scaled(1000000);
+  const size_t scans = Scaled(100000);
+  for (size_t width : {size_t(10), size_t(1000)}) {
+    const std::string suffix = "/" + std::to_string(width);
+    RangeScan<s21::btree_set<long>>("btree_set/scan" + suffix, n, scans,
+                                    width, key);
+    RangeScan<s21::set<long>>("btree/set/scan" + suffix, n, scans, width,
+                              key);
+    RangeScan<s21::btree_map<long, int>>("btree_map/scan" + suffix, n, scans,
+                                         width, pair);
+    RangeScan<s21::map<long, int>>("btree/map/scan" + suffix, n, scans,
+                                   width, const_pair);
+  }
+}
+
+//_________________<<BTREE<<__________________
+
+//_______________>>UNORDERED>>________________
+
+// erase a random present key and insert a fresh one, keeping the size fixed
+// at n; live[] remembers which keys are present
+template <typename Map>
+void HashChurn(const std::string &name, size_t n, size_t ops) {
+  if (!Enabled(name.c_str())) return;
+  Map m;
+  std::vector<long> live(n);
+  for (size_t i = 0; i < n; ++i) {
+    live[i] = static_cast<long>(i);
+    m.insert({live[i], 0});
+  }
+  std::mt19937_64 gen(3);
+  long next = static_cast<long>(n);
+  size_t erased = 0;
+  Report(name.c_str(), ops, MeasureMs([&] {
+           for (size_t i = 0; i < ops; ++i) {
+             long &victim = live[gen() % n];
+             erased += m.erase(victim);
+             victim = next++;
+             m.insert({victim, 0});
+           }
+         }));
+  if (erased != ops || m.size() != n)
+    std::printf("%-44s size drifted\n", name.c_str());
+  g_sink = g_sink + m.size();
+}
+
+void BenchUnordered() {
+  const size_t probes = Scaled(10000000);
+  auto const_pair = [](long k) { return std::pair<const long, int>(k, 0); };
+  const size_t no_limit = 0;
+
+  for (size_t n : {size_t(1000000), size_t(10000000)}) {
+    n = Scaled(n);
+    const std::string suffix = "/" + std::to_string(n);
+    LookupLatency<s21::unordered_map<long, int>>(
+        "unordered_map/s21" + suffix, n, probes, no_limit, const_pair);
+    LookupLatency<std::unordered_map<long, int>>(
+        "unordered_map/std" + suffix, n, probes, no_limit, const_pair);
+    LookupLatency<s21::map<long, int>>("unordered_map/tree" + suffix, n,
+                                       probes, no_limit, const_pair);
+  }
+
+  const size_t n = Scaled(1000000);
+  HashChurn<s21::unordered_map<long, int>>("unordered_map/churn/s21", n, n);
+  HashChurn<std::unordered_map<long, int>>("unordered_map/churn/std", n, n);
+}
+
+//_______________<<UNORDERED<<________________
+
+//__________________>>PMR>>__________________
+
+// A request builds a few small containers and drops them. With the default
+// allocator every node and buffer is freed one by one; with std::pmr the
+// containers sit on a per-request arena that is released in one call.
+template <typename Map, typename Vector, typename List, typename MakeArena>
+void RequestScoped(const char *name, size_t requests, size_t items,
+                   MakeArena make_arena) {
+  if (!Enabled(name)) return;
+  const size_t allocations_before = g_allocations;
+  size_t total = 0;
+  Report(name, requests, MeasureMs([&] {
+           for (size_t r = 0; r < requests; ++r) {
+             auto arena = make_arena();
+             Map m(arena.get());
+             Vector v(arena.get());
+             List l(arena.get());
+             for (size_t i = 0; i < items; ++i) {
+               const long key = static_cast<long>((i * 7919) % items);
+               m.insert({key, 0});
+               v.push_back(key);
+               l.push_back(key);
+             }
+             total += m.size() + v.size() + l.size();
+           }
+         }));
+  ReportAllocations(g_allocations - allocations_before);
+  g_sink = g_sink + total;
+}
+
+// default-allocated containers ignore the arena argument
+struct NoArena {
+  std::allocator<char> get() const { return {}; }
+};
+
+void BenchPmr() {
+  const size_t requests = Scaled(10000);
+  const size_t items = 1000;
+  RequestScoped<s21::map<long, int>, s21::vector<long>, s21::list<long>>(
+      "pmr/request/default", requests, items, [] { return NoArena(); });
+
+  // one buffer reused across requests; release() rewinds the arena
+  std::vector<unsigned char> buffer(1 << 20);
+  std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+  struct Rewind {
+    std::pmr::monotonic_buffer_resource *resource;
+    ~Rewind() { resource->release(); }
+    std::pmr::memory_resource *get() const { return resource; }
+  };
+  RequestScoped<s21::pmr::map<long, int>, s21::pmr::vector<long>,
+                s21::pmr::list<long>>("pmr/request/monotonic", requests,
+                                      items, [&] { return Rewind{&arena}; });
+}
+
+//__________________<<PMR<<__________________
+
+//__________________>>SPSC>>__________________
+
+// the baseline handoff: s21::queue behind a mutex
+struct LockedQueue {
+  std::mutex mutex;
+  s21::queue<long> queue;
+
+  bool push(long value) {
+    std::lock_guard<std::mutex> lock(mutex);
+    queue.push(value);
+    return true;
+  }
+
+  bool try_push(long value) { return push(value); }
+
+  bool try_pop(long &out) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (queue.empty()) return false;
+    out = queue.front();
+    queue.pop();
+    return true;
+  }
+};
+
+using SpscLong = s21::spsc_queue<long, 4096>;
+
+// A producer thread hands n values to the consumer (this thread). Both
+// sides yield instead of spinning when the queue is full or empty, so the
+// numbers stay meaningful on machines with fewer cores than threads.
+template <typename Queue, typename Push, typename Pop>
+void SpscThroughput(const char *name, size_t n, Push push, Pop pop) {
+  if (!Enabled(name)) return;
+  auto queue = std::make_unique<Queue>();
+  long sum = 0;
+  Report(name, n, MeasureMs([&] {
+           std::thread producer([&] {
+             for (size_t i = 0; i < n;) {
+               size_t pushed = push(*queue, static_cast<long>(i), n - i);
+               if (pushed == 0) std::this_thread::yield();
+               i += pushed;
+             }
+           });
+           for (size_t received = 0; received < n;) {
+             size_t popped = pop(*queue, sum);
+             if (popped == 0) std::this_thread::yield();
+             received += popped;
+           }
+           producer.join();
+         }));
+  g_sink = g_sink + static_cast<size_t>(sum);
+}
+
+// One-way latency: a value travels to an echo thread and back through two
+// queues; each op is one round trip halved.
+template <typename Queue>
+void SpscPingPong(const char *name, size_t round_trips) {
+  if (!Enabled(name)) return;
+  auto there = std::make_unique<Queue>();
+  auto back = std::make_unique<Queue>();
+  double ms = MeasureMs([&] {
+    std::thread echo([&] {
+      for (size_t i = 0; i < round_trips; ++i) {
+        long value;
+        while (!there->try_pop(value)) std::this_thread::yield();
+        back->push(value);
+      }
+    });
+    for (size_t i = 0; i < round_trips; ++i) {
+      there->push(static_cast<long>(i));
+      long value;
+      while (!back->try_pop(value)) std::this_thread::yield();
+    }
+    echo.join();
+  });
+  Report(name, round_trips, ms / 2);
+}
+
+void BenchSpsc() {
+  const size_t n = Scaled(20000000);
+  auto push_one = [](auto &q, long value, size_t) {
+    return q.push(value) ? size_t{1} : size_t{0};
+  };
+  auto pop_one = [](auto &q, long &sum) {
+    long value;
+    if (!q.try_pop(value)) return size_t{0};
+    sum += value;
+    return size_t{1};
+  };
+  SpscThroughput<SpscLong>("spsc/throughput/s21", n, push_one, pop_one);
+  SpscThroughput<SpscLong>(
+      "spsc/throughput/s21_batch", n,
+      [](SpscLong &q, long first, size_t left) {
+        long batch[64];
+        size_t count = std::min<size_t>(64, left);
+        for (size_t k = 0; k < count; ++k)
+          batch[k] = first + static_cast<long>(k);
+        return q.push_n(batch, count);
+      },
+      [](SpscLong &q, long &sum) {
+        long batch[64];
+        size_t count = q.pop_n(batch, 64);
+        for (size_t k = 0; k < count; ++k) sum += batch[k];
+        return count;
+      });
+  SpscThroughput<LockedQueue>("spsc/throughput/mutex_queue", n, push_one,
+                              pop_one);
+
+  SpscPingPong<SpscLong>("spsc/ping_pong/s21", Scaled(200000));
+  SpscPingPong<LockedQueue>("spsc/ping_pong/mutex_queue", Scaled(200000));
+}
+
+//__________________<<SPSC<<__________________
+
+//__________________>>MPMC>>__________________
+
+// n values go from threads / 2 producers to threads / 2 consumers; a single
+// thread alternates push and pop. Blocked threads yield, see SpscThroughput.
+template <typename Queue>
+void MpmcScaling(const char *name, size_t threads, size_t n) {
+  if (!Enabled(name)) return;
+  auto queue = std::make_unique<Queue>();
+  std::atomic<long> total{0};
+  double ms = MeasureMs([&] {
+    if (threads == 1) {
+      long sum = 0;
+      for (size_t i = 0; i < n; ++i) {
+        long value = 0;
+        queue->try_push(static_cast<long>(i));
+        queue->try_pop(value);
+        sum += value;
+      }
+      total += sum;
+      return;
+    }
+    const size_t pairs = threads / 2;
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < pairs; ++t) {
+      const size_t begin = n * t / pairs;
+      const size_t end = n * (t + 1) / pairs;
+      workers.emplace_back([&, begin, end] {
+        for (size_t i = begin; i < end; ++i)
+          while (!queue->try_push(static_cast<long>(i)))
+            std::this_thread::yield();
+      });
+      workers.emplace_back([&, count = end - begin] {
+        long sum = 0;
+        for (size_t i = 0; i < count; ++i) {
+          long value;
+          while (!queue->try_pop(value)) std::this_thread::yield();
+          sum += value;
+        }
+        total += sum;
+      });
+    }
+    for (std::thread &worker : workers) worker.join();
+  });
+  char label[64];
+  std::snprintf(label, sizeof(label), "%s/%zu", name, threads);
+  Report(label, n, ms);
+  g_sink = g_sink + static_cast<size_t>(total.load());
+}
+
+void BenchMpmc() {
+  const size_t n = Scaled(4000000);
+  for (size_t threads = 1; threads <= 64; threads *= 2) {
+    MpmcScaling<s21::mpmc_queue<long, 1024>>("mpmc/scaling/s21", threads, n);
+    MpmcScaling<LockedQueue>("mpmc/scaling/mutex_queue", threads, n);
+  }
+}
+
+//__________________<<MPMC<<__________________
+
+//______________>>WORK_STEALING>>______________
+
+// owner-side push/pop cycles, the fast path of every worker
+void WorkStealingPushPop(const char *name, size_t cycles) {
+  if (!Enabled(name)) return;
+  s21::work_stealing_deque<long> deque;
+  long sum = 0;
+  Report(name, cycles, MeasureMs([&] {
+           long value = 0;
+           for (size_t i = 0; i < cycles; ++i) {
+             deque.push(static_cast<long>(i));
+             deque.push(static_cast<long>(i));
+             deque.try_pop(value);
+             sum += value;
+             deque.try_pop(value);
+             sum += value;
+           }
+         }));
+  g_sink = g_sink + static_cast<size_t>(sum);
+}
+
+// Uneven loop: the cost of element i grows with i, so static equal
+// partitions would leave most threads idle near the end.
+// pool_workers < 0 runs the plain loop on this thread
+void ParallelForUneven(const char *name, size_t n, long pool_workers) {
+  if (!Enabled(name)) return;
+  s21::vector<double> values(n);
+  for (size_t i = 0; i < n; ++i) values[i] = static_cast<double>(i % 1000);
+  auto body = [n](double *first, double *last, double *begin) {
+    for (double *it = first; it != last; ++it) {
+      const size_t rounds = 1 + 16 * static_cast<size_t>(it - begin) / n;
+      double x = *it;
+      for (size_t r = 0; r < rounds; ++r) x = x * 0.5 + 1.0;
+      *it = x;
+    }
+  };
+  double *begin = values.begin();
+  double ms;
+  if (pool_workers < 0) {
+    ms = MeasureMs([&] { body(values.begin(), values.end(), begin); });
+  } else {
+    s21::thread_pool pool(static_cast<size_t>(pool_workers));
+    ms = MeasureMs([&] {
+      pool.parallel_for(values.begin(), values.end(),
+                        [&](double *first, double *last) {
+                          body(first, last, begin);
+                        });
+    });
+  }
+  Report(name, n, ms);
+  g_sink = g_sink + static_cast<size_t>(values[n / 2]);
+}
+
+void BenchWorkStealing() {
+  WorkStealingPushPop("wsdeque/push_pop/s21", Scaled(50000000));
+
+  const size_t n = Scaled(20000000);
+  const long hardware = std::max(1U, std::thread::hardware_concurrency());
+  ParallelForUneven("thread_pool/parallel_for/serial", n, -1);
+  ParallelForUneven("thread_pool/parallel_for/pool", n, hardware - 1);
+  ParallelForUneven("thread_pool/parallel_for/pool_x4", n, 4 * hardware - 1);
+}
+
+//______________<<WORK_STEALING<<______________
+
+//______________>>CONCURRENT_STACK>>__________
+
+// the shared free-object stack as it is used today: s21::stack + mutex
+struct LockedStack {
+  std::mutex mutex;
+  s21::stack<long> stack;
+
+  void push(long value) {
+    std::lock_guard<std::mutex> lock(mutex);
+    stack.push(value);
+  }
+
+  bool try_pop(long &out) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (stack.empty()) return false;
+    out = stack.top();
+    stack.pop();
+    return true;
+  }
+};
+
+// every thread returns an object to the stack and takes one back, n pairs
+// in total; the stack is pre-filled so pops rarely find it empty
+template <typename Stack>
+void StackContention(const char *name, size_t threads, size_t n) {
+  if (!Enabled(name)) return;
+  Stack stack;
+  for (long i = 0; i < 1024; ++i) stack.push(i);
+  std::atomic<long> total{0};
+  double ms = MeasureMs([&] {
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; ++t) {
+      workers.emplace_back([&, count = n / threads] {
+        long sum = 0;
+        long value = 0;
+        for (size_t i = 0; i < count; ++i) {
+          stack.push(static_cast<long>(i));
+          if (stack.try_pop(value)) sum += value;
+        }
+        total += sum;
+      });
+    }
+    for (std::thread &worker : workers) worker.join();
+  });
+  char label[64];
+  std::snprintf(label, sizeof(label), "%s/%zu", name, threads);
+  Report(label, n, ms);
+  g_sink = g_sink + static_cast<size_t>(total.load());
+}
+
+void BenchConcurrentStack() {
+  const size_t n = Scaled(4000000);
+  for (size_t threads = 1; threads <= 16; threads *= 2) {
+    StackContention<s21::concurrent_stack<long>>("concurrent_stack/s21",
+                                                 threads, n);
+    StackContention<LockedStack>("concurrent_stack/mutex_stack", threads, n);
+  }
+}
+
+//______________<<CONCURRENT_STACK<<__________
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  if (argc > 1) g_filter = argv[1];
+  if (argc > 2) g_scale = std::atof(argv[2]);
+
+  BenchVector();
+  BenchList();
+  BenchDeque();
+  BenchMap();
+  BenchMultiset();
+  BenchAssociative();
+  BenchFlat();
+  BenchBtree();
+  BenchUnordered();
+  BenchPmr();
+  BenchSpsc();
+  BenchMpmc();
+  BenchWorkStealing();
+  BenchConcurrentStack();
+  return 0;
+}
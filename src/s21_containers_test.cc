@@ -2,11 +2,53 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <list>
+#include <map>
+#include <memory>
+#include <memory_resource>
 #include <queue>
+#include <random>
+#include <set>
 #include <stack>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "s21_containersplus.h"
 
+// Ресурс std::pmr, который считает выделения и еще не освобожденные байты,
+// чтобы проверить, что контейнер берет всю память у своего аллокатора.
+class CountingResource : public std::pmr::memory_resource {
+ public:
+  size_t allocations = 0;
+  size_t outstanding = 0;
+
+ private:
+  void *do_allocate(size_t bytes, size_t align) override {
+    ++allocations;
+    outstanding += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, align);
+  }
+
+  void do_deallocate(void *p, size_t bytes, size_t align) override {
+    outstanding -= bytes;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+  }
+
+  bool do_is_equal(
+      const std::pmr::memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+};
+
 //_________________>>VECTOR>>____________________________________
 
 TEST(VectorTest, DefaultConstructor) {
@@ -229,6 +271,55 @@ TEST(VectorTest, Erase) {
   EXPECT_EQ(v[1], 3);
 }
 
+TEST(VectorTest, InsertWithinCapacityKeepsBuffer) {
+  s21::vector<std::string> v = {"a", "b", "c"};
+  v.reserve(10);
+  std::string *buffer = v.data();
+
+  auto it = v.insert(v.begin() + 1, v[2]);
+  EXPECT_EQ(*it, "c");
+  EXPECT_EQ(v.data(), buffer);
+  ASSERT_EQ(v.size(), 4);
+  EXPECT_EQ(v[0], "a");
+  EXPECT_EQ(v[1], "c");
+  EXPECT_EQ(v[2], "b");
+  EXPECT_EQ(v[3], "c");
+}
+
+TEST(VectorTest, InsertRange) {
+  s21::vector<int> v = {1, 2, 6};
+  int middle[] = {3, 4, 5};
+  auto it = v.insert(v.begin() + 2, middle, middle + 3);
+  EXPECT_EQ(*it, 3);
+
+  std::list<int> tail = {7, 8};
+  v.insert(v.end(), tail.begin(), tail.end());
+
+  s21::vector<std::string> words = {"x", "y"};
+  std::string front[] = {"u", "v", "w"};
+  words.insert(words.begin(), front, front + 3);
+
+  ASSERT_EQ(v.size(), 8);
+  for (int i = 0; i < 8; ++i) EXPECT_EQ(v[i], i + 1);
+  ASSERT_EQ(words.size(), 5);
+  EXPECT_EQ(words[0], "u");
+  EXPECT_EQ(words[3], "x");
+}
+
+TEST(VectorTest, EraseRange) {
+  s21::vector<std::string> v = {"0", "1", "2", "3", "4", "5"};
+  auto it = v.erase(v.begin() + 1, v.begin() + 4);
+  EXPECT_EQ(*it, "4");
+  ASSERT_EQ(v.size(), 3);
+  EXPECT_EQ(v[0], "0");
+  EXPECT_EQ(v[1], "4");
+  EXPECT_EQ(v[2], "5");
+
+  it = v.erase(v.begin(), v.end());
+  EXPECT_EQ(it, v.end());
+  EXPECT_TRUE(v.empty());
+}
+
 TEST(VectorTest, PushBack) {
   s21::vector<int> v;
 
@@ -267,6 +358,172 @@ TEST(VectorTest, Swap) {
   EXPECT_EQ(v2[2], 3);
 }
 
+namespace {
+// counts live instances to check which vector slots are really constructed
+struct Tracked {
+  static int alive;
+  int value;
+  Tracked(int v = 0) : value(v) { ++alive; }
+  Tracked(const Tracked &other) : value(other.value) { ++alive; }
+  Tracked(Tracked &&other) noexcept : value(other.value) { ++alive; }
+  Tracked &operator=(const Tracked &) = default;
+  Tracked &operator=(Tracked &&) = default;
+  ~Tracked() { --alive; }
+};
+int Tracked::alive = 0;
+}  // namespace
+
+TEST(VectorTest, ReserveConstructsOnlyLiveElements) {
+  {
+    s21::vector<Tracked> v;
+    v.reserve(1000);
+    EXPECT_EQ(Tracked::alive, 0);
+
+    for (int i = 0; i < 10; ++i) v.push_back(Tracked(i));
+    EXPECT_EQ(Tracked::alive, 10);
+
+    v.insert(v.begin() + 5, Tracked(42));
+    v.erase(v.begin());
+    v.pop_back();
+    EXPECT_EQ(Tracked::alive, 9);
+    EXPECT_EQ(v[4].value, 42);
+
+    v.shrink_to_fit();
+    EXPECT_EQ(v.capacity(), 9);
+    EXPECT_EQ(Tracked::alive, 9);
+
+    v.clear();
+    EXPECT_EQ(Tracked::alive, 0);
+    EXPECT_EQ(v.capacity(), 9);
+  }
+  EXPECT_EQ(Tracked::alive, 0);
+}
+
+namespace {
+// not trivially copyable, but safe to move around as raw bytes
+struct RelocatableMessage {
+  static int destroyed;
+  int id;
+  char payload[60];
+  RelocatableMessage(int i = 0) : id(i) { payload[0] = static_cast<char>(i); }
+  ~RelocatableMessage() { ++destroyed; }
+};
+int RelocatableMessage::destroyed = 0;
+}  // namespace
+
+template <>
+struct s21::is_trivially_relocatable<RelocatableMessage> : std::true_type {};
+
+TEST(VectorTest, TriviallyRelocatableGrowth) {
+  static_assert(s21::is_trivially_relocatable_v<int>);
+  static_assert(!s21::is_trivially_relocatable_v<std::string>);
+
+  RelocatableMessage::destroyed = 0;
+  {
+    s21::vector<RelocatableMessage> v;
+    for (int i = 0; i < 1000; ++i) v.push_back(RelocatableMessage(i));
+    // only the push_back arguments die, growth destroys nothing
+    EXPECT_EQ(RelocatableMessage::destroyed, 1000);
+    for (int i = 0; i < 1000; ++i) {
+      EXPECT_EQ(v[i].id, i);
+      EXPECT_EQ(v[i].payload[0], static_cast<char>(i));
+    }
+    v.shrink_to_fit();
+    EXPECT_EQ(v.capacity(), 1000);
+    EXPECT_EQ(v.back().id, 999);
+  }
+  EXPECT_EQ(RelocatableMessage::destroyed, 2000);
+}
+
+TEST(VectorTest, NonTrivialElements) {
+  s21::vector<std::string> v;
+  for (int i = 0; i < 100; ++i) v.push_back(std::to_string(i));
+  v.insert(v.begin(), v[50]);
+  s21::vector<std::string> copy(v);
+  v.shrink_to_fit();
+
+  ASSERT_EQ(copy.size(), 101);
+  EXPECT_EQ(copy[0], "50");
+  EXPECT_EQ(copy[100], "99");
+  EXPECT_EQ(v[1], "0");
+}
+
+namespace {
+// copyable with a throwing move, so growth copies; the copy throws on demand
+struct FragileCopy {
+  static int alive;
+  static int copies_left;
+  int value;
+  FragileCopy(int v = 0) : value(v) { ++alive; }
+  FragileCopy(const FragileCopy &other) : value(other.value) {
+    if (copies_left-- == 0) throw std::runtime_error("copy");
+    ++alive;
+  }
+  FragileCopy(FragileCopy &&other) : FragileCopy(other) {}
+  FragileCopy &operator=(const FragileCopy &) = default;
+  ~FragileCopy() { --alive; }
+};
+int FragileCopy::alive = 0;
+int FragileCopy::copies_left = -1;
+}  // namespace
+
+TEST(VectorTest, InsertReallocationThrowKeepsElements) {
+  FragileCopy::alive = 0;
+  {
+    s21::vector<FragileCopy> v;
+    v.reserve(8);
+    for (int i = 0; i < 8; ++i) v.emplace_back(i);
+    // голова [0, 4) скопируется, хвост бросит на четвертом элементе
+    FragileCopy::copies_left = 7;
+    EXPECT_THROW(v.emplace(v.begin() + 4, 100), std::runtime_error);
+    FragileCopy::copies_left = -1;
+    EXPECT_EQ(FragileCopy::alive, 8);
+    ASSERT_EQ(v.size(), 8U);
+    EXPECT_EQ(v.capacity(), 8U);
+    for (int i = 0; i < 8; ++i) EXPECT_EQ(v[i].value, i);
+  }
+  EXPECT_EQ(FragileCopy::alive, 0);
+}
+
+namespace {
+// counts how many times heavy objects are built and copied
+struct Heavy {
+  static int constructed;
+  static int copied;
+  std::string name;
+  int weight;
+  Heavy(std::string n, int w) : name(std::move(n)), weight(w) {
+    ++constructed;
+  }
+  Heavy(const Heavy &other) : name(other.name), weight(other.weight) {
+    ++copied;
+  }
+  Heavy(Heavy &&other) noexcept = default;
+  Heavy &operator=(const Heavy &) = default;
+  Heavy &operator=(Heavy &&) = default;
+  bool operator<(const Heavy &other) const { return weight < other.weight; }
+  static void Reset() { constructed = copied = 0; }
+};
+int Heavy::constructed = 0;
+int Heavy::copied = 0;
+}  // namespace
+
+TEST(VectorTest, EmplaceConstructsInPlace) {
+  Heavy::Reset();
+  s21::vector<Heavy> v;
+  Heavy &back = v.emplace_back("b", 2);
+  EXPECT_EQ(back.weight, 2);
+  v.emplace(v.begin(), "a", 1);
+  v.emplace(v.end(), "c", 3);
+  v.insert_many_back(Heavy("d", 4));
+  v.push_back(Heavy("e", 5));
+
+  EXPECT_EQ(Heavy::constructed, 5);
+  EXPECT_EQ(Heavy::copied, 0);
+  ASSERT_EQ(v.size(), 5);
+  for (int i = 0; i < 5; ++i) EXPECT_EQ(v[i].weight, i + 1);
+}
+
 TEST(S21VectorTest, InsertManyTest) {
   s21::vector<int> vec;
 
@@ -370,6 +627,37 @@ TEST(InsertManyBackTest, InsertMultipleArgs) {
   ASSERT_EQ(vec[9], 5);
 }
 
+TEST(VectorTest, PmrVectorAllocatesFromResource) {
+  CountingResource resource;
+  {
+    s21::pmr::vector<int> v(&resource);
+    for (int i = 0; i < 1000; ++i) v.push_back(i);
+    EXPECT_GT(resource.allocations, 0U);
+    EXPECT_EQ(v.get_allocator().resource(), &resource);
+
+    s21::pmr::vector<int> copy(v);  // копия берет ресурс по умолчанию
+    EXPECT_EQ(copy.get_allocator().resource(),
+              std::pmr::get_default_resource());
+
+    // ресурс не переходит при перемещении: элементы переезжают поштучно
+    CountingResource other;
+    s21::pmr::vector<int> moved(&other);
+    moved = std::move(copy);
+    EXPECT_EQ(moved.get_allocator().resource(), &other);
+    EXPECT_EQ(moved.size(), 1000U);
+    EXPECT_EQ(moved[999], 999);
+    EXPECT_GT(other.allocations, 0U);
+  }
+  EXPECT_EQ(resource.outstanding, 0U);
+
+  // на монотонной арене память освобождается вместе с ней
+  std::pmr::monotonic_buffer_resource arena;
+  s21::pmr::vector<std::string> words(&arena);
+  words.emplace_back("alpha");
+  words.insert(words.begin(), "beta");
+  EXPECT_EQ(words[0], "beta");
+}
+
 //__________________<<VECTOR<<____________________
 
 //__________________>>SET>>_______________________
@@ -499,6 +787,44 @@ TEST(SetTest, Merge) {
   EXPECT_TRUE(s2.empty());
 }
 
+TEST(SetTest, MergeRelinksNodesAndKeepsDuplicates) {
+  s21::set<Heavy> s1;
+  s21::set<Heavy> s2;
+  s1.emplace("a", 1);
+  s1.emplace("b", 2);
+  s2.emplace("other b", 2);
+  s2.emplace("c", 3);
+  auto moved = s2.find(Heavy("", 3));
+  Heavy::Reset();
+  s1.merge(s2);
+  EXPECT_EQ(Heavy::constructed + Heavy::copied, 0);
+  EXPECT_EQ(s1.size(), 3U);
+  ASSERT_EQ(s2.size(), 1U);
+  EXPECT_EQ(s2.begin()->name, "other b");
+  // итератор на перенесенный элемент теперь указывает в s1
+  EXPECT_EQ(moved, s1.find(Heavy("", 3)));
+}
+
+TEST(SetTest, ExtractAndInsertNode) {
+  s21::set<int> s = {1, 2, 3};
+  auto node = s.extract(2);
+  ASSERT_FALSE(node.empty());
+  EXPECT_EQ(node.value(), 2);
+  EXPECT_EQ(s.size(), 2U);
+  EXPECT_TRUE(s.extract(42).empty());
+
+  node.value() = 1;
+  auto result = s.insert(std::move(node));
+  EXPECT_FALSE(result.inserted);
+  EXPECT_EQ(*result.position, 1);
+  ASSERT_TRUE(result.node);
+  result.node.value() = 5;
+  result = s.insert(std::move(result.node));
+  EXPECT_TRUE(result.inserted);
+  EXPECT_TRUE(result.node.empty());
+  EXPECT_EQ(*--s.end(), 5);
+}
+
 TEST(SetTest, Find) {
   s21::set<int> s = {1, 2, 3};
   s21::set<int>::iterator it = s.find(2);
@@ -511,6 +837,270 @@ TEST(SetTest, Contains) {
   EXPECT_FALSE(s.contains(4));
 }
 
+TEST(SetTest, ReverseIterationFromEnd) {
+  s21::set<int> s = {5, 1, 4, 2, 3};
+  int expected = 5;
+  for (auto it = s.end(); it != s.begin(); --expected) {
+    --it;
+    EXPECT_EQ(*it, expected);
+  }
+  EXPECT_EQ(expected, 0);
+}
+
+TEST(SetTest, EraseKeepsOrder) {
+  s21::set<int> s;
+  for (int i = 0; i < 1000; ++i) s.insert((i * 7919) % 1000);
+  for (int i = 0; i < 1000; i += 3) s.erase(s.find(i));
+
+  int previous = -1;
+  size_t count = 0;
+  for (auto it = s.begin(); it != s.end(); ++it, ++count) {
+    EXPECT_LT(previous, *it);
+    EXPECT_NE(*it % 3, 0);
+    previous = *it;
+  }
+  EXPECT_EQ(count, s.size());
+}
+
+TEST(SetTest, Emplace) {
+  Heavy::Reset();
+  s21::set<Heavy> s;
+  EXPECT_TRUE(s.emplace("a", 1).second);
+  EXPECT_FALSE(s.emplace("b", 1).second);
+  EXPECT_TRUE(s.emplace("c", 3).second);
+  EXPECT_EQ(s.size(), 2);
+  EXPECT_EQ((*s.begin()).name, "a");
+  EXPECT_EQ(Heavy::copied, 0);
+
+  s21::multiset<Heavy> ms;
+  ms.emplace("a", 1);
+  ms.emplace("b", 1);
+  EXPECT_EQ(ms.count(Heavy("", 1)), 2);
+  EXPECT_EQ(Heavy::copied, 0);
+}
+
+TEST(SetTest, FromSortedBuildsValidTree) {
+  std::vector<int> keys;
+  for (int i = 0; i < 100000; ++i) keys.push_back(i / 2 * 2);
+  auto s = s21::set<int>::from_sorted(keys.begin(), keys.end());
+  EXPECT_EQ(s.size(), 50000U);
+  EXPECT_EQ(*s.begin(), 0);
+  EXPECT_EQ(*--s.end(), 99998);
+
+  // обычные вставки и удаления после перестройки проверяют раскраску
+  std::set<int> expected(keys.begin(), keys.end());
+  std::mt19937 gen(1);
+  for (int i = 0; i < 50000; ++i) {
+    int key = static_cast<int>(gen() % 120000);
+    if (gen() % 2 == 0) {
+      EXPECT_EQ(s.insert(key).second, expected.insert(key).second);
+    } else if (s.contains(key)) {
+      s.erase(s.find(key));
+      expected.erase(key);
+    }
+  }
+  EXPECT_TRUE(std::equal(s.begin(), s.end(), expected.begin(), expected.end()));
+
+  std::vector<int> unsorted = {1, 3, 2};
+  EXPECT_THROW(s.assign_sorted(unsorted.begin(), unsorted.end()),
+               std::invalid_argument);
+  EXPECT_EQ(s.size(), expected.size());
+  s.assign_sorted(unsorted.begin(), unsorted.begin());
+  EXPECT_TRUE(s.empty());
+}
+
+TEST(SetTest, BulkInsertMergesBatch) {
+  s21::set<int> s = {5, 10, 15};
+  auto kept = s.find(10);
+  std::vector<int> batch;
+  std::mt19937 gen(2);
+  for (int i = 0; i < 10000; ++i) batch.push_back(gen() % 20000);
+  s.insert(batch.begin(), batch.end());
+
+  std::set<int> expected = {5, 10, 15};
+  expected.insert(batch.begin(), batch.end());
+  EXPECT_TRUE(std::equal(s.begin(), s.end(), expected.begin(), expected.end()));
+  EXPECT_EQ(*kept, 10);
+  EXPECT_EQ(*++kept, *expected.upper_bound(10));
+
+  // пакет намного меньше дерева вставляется по одному
+  std::vector<int> small = {-1, 5, -1};
+  s.insert(small.begin(), small.end());
+  EXPECT_EQ(s.size(), expected.size() + 1);
+  EXPECT_EQ(*s.begin(), -1);
+}
+
+namespace {
+// бросает на сравнении номер limit; при limit < 0 - никогда
+struct LimitedLess {
+  static int calls;
+  static int limit;
+  bool operator()(int a, int b) const {
+    if (limit >= 0 && calls++ == limit) throw std::runtime_error("less");
+    return a < b;
+  }
+};
+int LimitedLess::calls = 0;
+int LimitedLess::limit = -1;
+}  // namespace
+
+TEST(SetTest, ThrowingCompareInBulkInsertKeepsTreeValid) {
+  using Set = s21::set<int, LimitedLess>;
+  Set base;
+  for (int i = 0; i < 64; i += 2) base.insert(i);
+  std::vector<int> large, small = {7, 3};
+  for (int i = 100; i > -20; i -= 3) large.push_back(i);
+
+  for (const std::vector<int> *batch : {&large, &small}) {
+    for (int limit = 0; limit < 600; ++limit) {
+      Set s = base;
+      LimitedLess::calls = 0;
+      LimitedLess::limit = limit;
+      try {
+        s.insert(batch->begin(), batch->end());
+      } catch (const std::runtime_error &) {
+      }
+      LimitedLess::limit = -1;
+      // старые ключи на месте, порядок и размер согласованы
+      std::vector<int> values(s.begin(), s.end());
+      EXPECT_TRUE(std::is_sorted(values.begin(), values.end()));
+      EXPECT_EQ(values.size(), s.size());
+      for (int i = 0; i < 64; i += 2) EXPECT_TRUE(s.contains(i));
+    }
+  }
+}
+
+TEST(SetTest, RankedSetOrderStatistics) {
+  s21::ranked_set<int> s;
+  std::vector<int> expected;
+  std::mt19937 gen(3);
+  // вставки, удаления и пакетная перестройка должны сохранять размеры
+  for (int i = 0; i < 20000; ++i) {
+    int key = static_cast<int>(gen() % 5000);
+    if (gen() % 3 != 0) {
+      s.insert(key);
+    } else if (s.contains(key)) {
+      s.erase(s.find(key));
+    }
+  }
+  std::vector<int> batch;
+  for (int i = 0; i < 3000; ++i) batch.push_back(gen() % 8000);
+  s.insert(batch.begin(), batch.end());
+  expected.assign(s.begin(), s.end());
+  ASSERT_EQ(expected.size(), s.size());
+
+  for (size_t k = 0; k < expected.size(); k += 7)
+    EXPECT_EQ(*s.nth(k), expected[k]);
+  EXPECT_TRUE(s.nth(expected.size()) == s.end());
+  for (int key = -1; key < 8001; key += 13) {
+    auto lower = std::lower_bound(expected.begin(), expected.end(), key);
+    EXPECT_EQ(s.rank(key), static_cast<size_t>(lower - expected.begin()));
+  }
+  auto from = std::lower_bound(expected.begin(), expected.end(), 1000);
+  auto to = std::lower_bound(expected.begin(), expected.end(), 4000);
+  EXPECT_EQ(s.count_range(1000, 4000), static_cast<size_t>(to - from));
+  EXPECT_EQ(s.count_range(4000, 1000), 0U);
+
+  auto built = s21::ranked_set<int>::from_sorted(expected.begin(),
+                                                 expected.end());
+  EXPECT_EQ(*built.nth(expected.size() / 2), expected[expected.size() / 2]);
+  s21::ranked_set<int> other = {-5, expected[0], 9000};
+  built.merge(other);
+  EXPECT_EQ(other.size(), 1U);
+  EXPECT_EQ(*other.nth(0), expected[0]);
+  EXPECT_EQ(*built.nth(0), -5);
+  EXPECT_EQ(built.rank(9000), expected.size() + 1);
+  s21::ranked_set<int> copy(built);
+  EXPECT_EQ(*copy.nth(copy.size() - 1), 9000);
+}
+
+TEST(SetTest, BoundsAndRangeErase) {
+  s21::set<int> s;
+  std::set<int> expected;
+  for (int i = 0; i < 1000; i += 2) {
+    s.insert(i);
+    expected.insert(i);
+  }
+  EXPECT_EQ(*s.lower_bound(10), 10);
+  EXPECT_EQ(*s.lower_bound(11), 12);
+  EXPECT_EQ(*s.upper_bound(10), 12);
+  EXPECT_TRUE(s.lower_bound(999) == s.end());
+  auto range = s.equal_range(20);
+  EXPECT_EQ(*range.first, 20);
+  EXPECT_EQ(*range.second, 22);
+  range = s.equal_range(21);
+  EXPECT_TRUE(range.first == range.second);
+
+  // итераторы вне удаленных диапазонов остаются действительными
+  auto kept = s.find(900);
+  auto next = s.erase(s.lower_bound(100), s.lower_bound(110));
+  expected.erase(expected.lower_bound(100), expected.lower_bound(110));
+  EXPECT_EQ(*next, 110);
+  next = s.erase(s.lower_bound(200), s.upper_bound(800));
+  expected.erase(expected.lower_bound(200), expected.upper_bound(800));
+  EXPECT_EQ(*next, 802);
+  EXPECT_EQ(*kept, 900);
+  EXPECT_TRUE(std::equal(s.begin(), s.end(), expected.begin(), expected.end()));
+  EXPECT_EQ(*--s.end(), 998);
+
+  s.insert(500);
+  EXPECT_EQ(*++s.find(500), 802);
+  EXPECT_TRUE(s.erase(s.begin(), s.end()) == s.end());
+  EXPECT_TRUE(s.empty());
+  s.insert(1);
+  EXPECT_EQ(*s.begin(), 1);
+
+  s21::ranked_set<int> ranked = {1, 2, 3, 4, 5, 6, 7, 8};
+  ranked.erase(ranked.lower_bound(2), ranked.lower_bound(7));
+  EXPECT_EQ(ranked.size(), 3U);
+  EXPECT_EQ(*ranked.nth(1), 7);
+  EXPECT_EQ(ranked.rank(8), 2U);
+}
+
+TEST(SetTest, CustomCompareAndTransparentLookup) {
+  s21::set<int, std::greater<int>> desc = {3, 1, 4, 1, 5};
+  std::vector<int> expected = {5, 4, 3, 1};
+  EXPECT_TRUE(std::equal(desc.begin(), desc.end(), expected.begin(),
+                         expected.end()));
+  EXPECT_EQ(*desc.lower_bound(2), 1);
+  EXPECT_EQ(*desc.upper_bound(4), 3);
+
+  s21::set<std::string, std::less<>> words = {"pear", "apple", "plum"};
+  std::string_view key = "pear";
+  EXPECT_TRUE(words.contains(key));
+  EXPECT_EQ(*words.find(key), "pear");
+  EXPECT_TRUE(words.find(std::string_view("fig")) == words.end());
+  EXPECT_EQ(*words.lower_bound("b"), "pear");
+  auto range = words.equal_range(std::string_view("plum"));
+  EXPECT_EQ(*range.first, "plum");
+  EXPECT_TRUE(range.second == words.end());
+}
+
+TEST(SetTest, PmrSetAllocatesFromResource) {
+  CountingResource resource;
+  {
+    s21::pmr::set<int> s(&resource);
+    for (int i = 0; i < 100; ++i) s.insert(i);
+    EXPECT_EQ(resource.allocations, 100U);
+    EXPECT_EQ(s.get_allocator().resource(), &resource);
+
+    auto node = s.extract(50);
+    EXPECT_EQ(node.get_allocator().resource(), &resource);
+    s.insert(std::move(node));
+    EXPECT_EQ(resource.allocations, 100U);
+
+    CountingResource other;
+    s21::pmr::set<int> moved(&other);
+    moved = std::move(s);
+    EXPECT_EQ(moved.get_allocator().resource(), &other);
+    EXPECT_EQ(moved.size(), 100U);
+    EXPECT_EQ(other.allocations, 100U);
+    moved.clear();
+    EXPECT_EQ(other.outstanding, 0U);
+  }
+  EXPECT_EQ(resource.outstanding, 0U);
+}
+
 TEST(InsertManyTest, Empty) {
   s21::set<int> s;
   insert_many(s);
@@ -728,7 +1318,29 @@ TEST(MapTest, Merge) {
   EXPECT_EQ(m1[1], 10);
   EXPECT_EQ(m1[2], 20);
   EXPECT_EQ(m1[3], 40);
-  EXPECT_EQ(m2.size(), 0);
+  // the duplicate key stays in the source
+  EXPECT_EQ(m2.size(), 1);
+  EXPECT_EQ(m2[2], 30);
+}
+
+TEST(MapTest, ExtractChangesKeyWithoutCopy) {
+  Heavy::Reset();
+  s21::map<int, Heavy> m1;
+  s21::map<int, Heavy> m2;
+  m1.try_emplace(1, "one", 1);
+  m1.try_emplace(2, "two", 2);
+  auto node = m1.extract(m1.begin());
+  EXPECT_EQ(node.key(), 1);
+  node.key() = 10;
+  node.mapped().weight = 100;
+  auto result = m2.insert(std::move(node));
+  EXPECT_TRUE(result.inserted);
+  EXPECT_EQ((*result.position).first, 10);
+  EXPECT_EQ(m2.at(10).weight, 100);
+  EXPECT_EQ(m1.size(), 1U);
+  EXPECT_EQ(Heavy::copied, 0);
+  EXPECT_EQ(Heavy::constructed, 2);
+  EXPECT_FALSE(m2.insert(s21::map<int, Heavy>::node_type()).inserted);
 }
 
 TEST(MapTest, Contains) {
@@ -813,6 +1425,162 @@ TEST(MapTest, InsertManyEmptyTest_2) {
   EXPECT_TRUE(myMap.empty());
 }
 
+TEST(MapTest, IteratorDecrement) {
+  s21::map<int, int> m = {{5, 50}, {3, 30}, {8, 80}, {1, 10}, {4, 40}};
+  s21::map<int, int>::iterator it = m.begin();
+  for (int i = 0; i < 4; ++i) ++it;
+  EXPECT_EQ((*it).first, 8);
+  --it;
+  EXPECT_EQ((*it).first, 5);
+  --it;
+  EXPECT_EQ((*it).first, 4);
+  --it;
+  EXPECT_EQ((*it).first, 3);
+}
+
+TEST(MapTest, SortedInsertAndErase) {
+  const int n = 100000;
+  s21::map<int, int> m;
+  for (int i = 0; i < n; ++i) m.insert(i, i * 2);
+  EXPECT_EQ(m.size(), static_cast<size_t>(n));
+
+  for (int i = 0; i < n; i += 2) m.erase(m.insert(i, 0).first);
+  EXPECT_EQ(m.size(), static_cast<size_t>(n / 2));
+
+  int expected = 1;
+  for (auto it = m.begin(); it != m.end(); ++it, expected += 2) {
+    EXPECT_EQ((*it).first, expected);
+    EXPECT_EQ((*it).second, expected * 2);
+  }
+  EXPECT_EQ(expected, n + 1);
+  EXPECT_FALSE(m.contains(0));
+  EXPECT_TRUE(m.contains(n - 1));
+}
+
+TEST(MapTest, EmplaceAndTryEmplace) {
+  Heavy::Reset();
+  s21::map<int, Heavy> m;
+  auto res = m.try_emplace(1, "one", 1);
+  EXPECT_TRUE(res.second);
+  res = m.try_emplace(1, "uno", 10);
+  EXPECT_FALSE(res.second);
+  EXPECT_EQ((*res.first).second.name, "one");
+  EXPECT_EQ(Heavy::constructed, 1);
+
+  res = m.emplace(std::piecewise_construct, std::forward_as_tuple(2),
+                  std::forward_as_tuple("two", 2));
+  EXPECT_TRUE(res.second);
+  EXPECT_EQ(Heavy::constructed, 2);
+  EXPECT_EQ(Heavy::copied, 0);
+
+  s21::map<std::string, int> counts;
+  ++counts["a"];
+  ++counts["a"];
+  EXPECT_EQ(counts.at("a"), 2);
+}
+
+TEST(MapTest, FromSortedAndBulkInsert) {
+  std::vector<std::pair<int, std::string>> sorted = {
+      {1, "a"}, {2, "b"}, {2, "c"}, {3, "d"}};
+  auto m = s21::map<int, std::string>::from_sorted(sorted.begin(),
+                                                   sorted.end());
+  EXPECT_EQ(m.size(), 3U);
+  EXPECT_EQ(m.at(2), "b");
+
+  std::vector<std::pair<int, std::string>> batch = {
+      {4, "e"}, {0, "f"}, {2, "x"}, {4, "y"}};
+  m.insert(batch.begin(), batch.end());
+  EXPECT_EQ(m.size(), 5U);
+  EXPECT_EQ(m.at(2), "b");
+  EXPECT_EQ(m.at(4), "e");
+  EXPECT_EQ((*m.begin()).first, 0);
+
+  std::vector<std::pair<int, std::string>> unsorted = {{2, "a"}, {1, "b"}};
+  EXPECT_THROW(m.assign_sorted(unsorted.begin(), unsorted.end()),
+               std::invalid_argument);
+  EXPECT_EQ(m.size(), 5U);
+}
+
+TEST(MapTest, RankedMapNth) {
+  s21::ranked_map<int, std::string> m = {{30, "c"}, {10, "a"}, {20, "b"}};
+  EXPECT_EQ((*m.nth(1)).second, "b");
+  (*m.nth(2)).second = "z";
+  EXPECT_EQ(m.at(30), "z");
+  EXPECT_EQ(m.rank(25), 2U);
+  EXPECT_EQ(m.count_range(10, 30), 2U);
+  m.erase(m.nth(0));
+  EXPECT_EQ((*m.nth(0)).first, 20);
+  EXPECT_TRUE(m.nth(2) == m.end());
+}
+
+TEST(MapTest, BoundsAndRangeErase) {
+  s21::map<int, std::string> m;
+  for (int i = 0; i < 100; ++i) m.insert(i * 10, std::to_string(i));
+  EXPECT_EQ((*m.lower_bound(35)).first, 40);
+  EXPECT_EQ((*m.upper_bound(40)).second, "5");
+  auto range = m.equal_range(50);
+  EXPECT_EQ((*range.first).second, "5");
+  EXPECT_EQ((*range.second).first, 60);
+
+  // истекшие записи удаляются одним вызовом
+  auto next = m.erase(m.begin(), m.lower_bound(500));
+  EXPECT_EQ((*next).first, 500);
+  EXPECT_EQ(m.size(), 50U);
+  EXPECT_EQ((*m.begin()).first, 500);
+  m.erase(m.lower_bound(700), m.upper_bound(710));
+  EXPECT_EQ(m.size(), 48U);
+  EXPECT_FALSE(m.contains(710));
+  EXPECT_EQ(m.at(720), "72");
+}
+
+TEST(MapTest, TransparentFindTakesStringView) {
+  s21::map<std::string, int, std::less<>> m = {
+      {"alpha", 1}, {"beta", 2}, {"gamma", 3}};
+  std::string_view key = "beta";
+  auto it = m.find(key);
+  ASSERT_TRUE(it != m.end());
+  EXPECT_EQ((*it).second, 2);
+  EXPECT_TRUE(m.contains(std::string_view("gamma")));
+  EXPECT_EQ(m.count(std::string_view("delta")), 0U);
+  EXPECT_EQ((*m.upper_bound(std::string_view("alpha"))).first, "beta");
+  EXPECT_TRUE(m.find("alpha") == m.begin());
+}
+
+struct CountingLess {
+  static inline int calls = 0;
+  bool operator()(int a, int b) const {
+    ++calls;
+    return a < b;
+  }
+};
+
+TEST(MapTest, LookupMakesOneComparisonPerLevel) {
+  std::vector<std::pair<int, int>> sorted;
+  for (int i = 0; i < 1023; ++i) sorted.push_back({i, i});
+  // 1023 ключа из отсортированного диапазона дают идеальное дерево глубины 10
+  auto m = s21::map<int, int, CountingLess>::from_sorted(sorted.begin(),
+                                                         sorted.end());
+  for (int key : {0, 511, 1022, 2000}) {
+    CountingLess::calls = 0;
+    EXPECT_EQ(m.contains(key), key < 1023);
+    EXPECT_LE(CountingLess::calls, 11);
+  }
+}
+
+TEST(MapTest, PmrMapAllocatesFromResource) {
+  CountingResource resource;
+  {
+    s21::pmr::map<int, std::string> m(&resource);
+    m.insert(1, "one");
+    m[2] = "two";
+    EXPECT_EQ(resource.allocations, 2U);
+    s21::pmr::map<int, std::string> copy = m;
+    EXPECT_EQ(copy.at(2), "two");
+    EXPECT_EQ(resource.allocations, 2U);
+  }
+  EXPECT_EQ(resource.outstanding, 0U);
+}
+
 //__________________<<MAP<<__________________
 
 //___________________>>ARRAY>>_______________
@@ -1030,6 +1798,19 @@ TEST(MultisetTest, Merge) {
   EXPECT_EQ(ms2.size(), 0);
 }
 
+TEST(MultisetTest, MergeMovesEqualKeys) {
+  s21::multiset<int> ms1 = {1, 2};
+  s21::multiset<int> ms2 = {2, 2, 3};
+  ms1.merge(ms2);
+  EXPECT_EQ(ms1.size(), 5U);
+  EXPECT_EQ(ms1.count(2), 3);
+  EXPECT_TRUE(ms2.empty());
+  auto node = ms1.extract(2);
+  EXPECT_EQ(ms1.count(2), 2);
+  ms2.insert(std::move(node));
+  EXPECT_EQ(ms2.count(2), 1);
+}
+
 TEST(MultisetTest, Count) {
   s21::multiset<int> ms = {1, 2, 2, 3};
 
@@ -1077,6 +1858,22 @@ TEST(MultiSetTest, EqualRange) {
   EXPECT_EQ(range3.first, range3.second);
 }
 
+TEST(MultisetTest, DuplicatesKeepInsertionOrder) {
+  s21::multiset<int> ms = {3, 1, 2, 1, 3, 1};
+  int expected[] = {1, 1, 1, 2, 3, 3};
+  int i = 0;
+  for (auto it = ms.begin(); it != ms.end(); ++it, ++i)
+    EXPECT_EQ(*it, expected[i]);
+  EXPECT_EQ(i, 6);
+
+  auto last = ms.end();
+  --last;
+  EXPECT_EQ(*last, 3);
+  ms.erase(ms.find(1));
+  EXPECT_EQ(ms.count(1), 2);
+  EXPECT_EQ(*ms.begin(), 1);
+}
+
 TEST(MultisetTest, LowerBound) {
   s21::multiset<int> ms = {1, 2, 2, 3};
 
@@ -1097,6 +1894,22 @@ TEST(MultisetTest, UpperBound) {
   EXPECT_EQ(it, ms.end());
 }
 
+TEST(MultisetTest, FromSortedAndBulkInsertKeepDuplicates) {
+  std::vector<int> sorted = {1, 1, 2, 3, 3, 3};
+  auto ms = s21::multiset<int>::from_sorted(sorted.begin(), sorted.end());
+  EXPECT_EQ(ms.size(), 6U);
+  EXPECT_EQ(ms.count(3), 3);
+
+  std::vector<int> batch;
+  std::mt19937 gen(4);
+  for (int i = 0; i < 5000; ++i) batch.push_back(gen() % 100);
+  ms.insert(batch.begin(), batch.end());
+  std::multiset<int> expected(sorted.begin(), sorted.end());
+  expected.insert(batch.begin(), batch.end());
+  EXPECT_TRUE(
+      std::equal(ms.begin(), ms.end(), expected.begin(), expected.end()));
+}
+
 TEST(InsertManyTest, InsertMultipleElements) {
   s21::multiset<int> ms;
   insert_many(ms, 4, 2, 6, 2, 8);
@@ -1131,8 +1944,669 @@ TEST(InsertManyTest, InsertEmptyArguments) {
   ASSERT_EQ(ms.size(), 0);
 }
 
+TEST(MultisetTest, RankedMultisetCountsCopies) {
+  s21::ranked_multiset<int> ms = {5, 1, 5, 3, 5, 7};
+  EXPECT_EQ(ms.rank(5), 2U);
+  EXPECT_EQ(ms.count_range(5, 6), 3U);
+  EXPECT_EQ(*ms.nth(4), 5);
+  EXPECT_EQ(*ms.nth(5), 7);
+  ms.erase(ms.find(5));
+  EXPECT_EQ(ms.count_range(0, 100), 5U);
+  EXPECT_EQ(*ms.nth(4), 7);
+}
+
+TEST(MultisetTest, CompactSharesNodesAndYieldsEachCopy) {
+  s21::compact_multiset<int> ms = {3, 1, 3, 2, 3};
+  EXPECT_EQ(ms.size(), 5U);
+  EXPECT_EQ(ms.distinct_size(), 3U);
+  EXPECT_EQ(ms.count(3), 3U);
+  EXPECT_EQ(ms.count(4), 0U);
+  std::vector<int> expected = {1, 2, 3, 3, 3};
+  EXPECT_TRUE(std::equal(ms.begin(), ms.end(), expected.begin(),
+                         expected.end()));
+  std::vector<int> reversed(std::make_reverse_iterator(ms.end()),
+                            std::make_reverse_iterator(ms.begin()));
+  EXPECT_TRUE(std::equal(reversed.rbegin(), reversed.rend(),
+                         expected.begin(), expected.end()));
+
+  auto range = ms.equal_range(3);
+  EXPECT_EQ(std::distance(range.first, range.second), 3);
+  EXPECT_TRUE(range.second == ms.end());
+  EXPECT_EQ(*ms.insert(2), 2);
+  EXPECT_EQ(ms.count(2), 2U);
+
+  ms.erase(ms.find(3));
+  EXPECT_EQ(ms.count(3), 2U);
+  EXPECT_EQ(ms.size(), 5U);
+  EXPECT_EQ(ms.erase(3), 2U);
+  EXPECT_FALSE(ms.contains(3));
+  ms.erase(ms.find(1));
+  EXPECT_EQ(ms.distinct_size(), 1U);
+  EXPECT_EQ(ms.size(), 2U);
+}
+
+TEST(MultisetTest, CompactMatchesRegularMultiset) {
+  s21::compact_multiset<int> compact;
+  s21::multiset<int> regular;
+  std::mt19937 gen(4);
+  for (int i = 0; i < 20000; ++i) {
+    int key = static_cast<int>(gen() % 64);
+    if (gen() % 4 != 0) {
+      compact.insert(key);
+      regular.insert(key);
+    } else if (regular.contains(key)) {
+      compact.erase(compact.find(key));
+      regular.erase(regular.find(key));
+    }
+  }
+  EXPECT_EQ(compact.size(), regular.size());
+  EXPECT_LE(compact.distinct_size(), 64U);
+  EXPECT_TRUE(std::equal(compact.begin(), compact.end(), regular.begin(),
+                         regular.end()));
+
+  std::vector<int> sorted(regular.begin(), regular.end());
+  auto built = s21::compact_multiset<int>::from_sorted(sorted.begin(),
+                                                       sorted.end());
+  EXPECT_TRUE(std::equal(built.begin(), built.end(), sorted.begin(),
+                         sorted.end()));
+  std::vector<int> unsorted = {1, 2, 1};
+  EXPECT_THROW(built.assign_sorted(unsorted.begin(), unsorted.end()),
+               std::invalid_argument);
+  EXPECT_EQ(built.size(), sorted.size());
+
+  s21::compact_multiset<int> other = {0, 0, 1000};
+  built.merge(other);
+  EXPECT_TRUE(other.empty());
+  EXPECT_EQ(built.size(), sorted.size() + 3);
+  EXPECT_EQ(built.count(0), regular.count(0) + 2);
+  EXPECT_EQ(*--built.end(), 1000);
+}
+
+TEST(MultisetTest, CompactMergeRelinksWithoutAllocating) {
+  using Alloc = std::pmr::polymorphic_allocator<int>;
+  using Compact = s21::multiset<int, std::less<int>, Alloc, false, true>;
+  CountingResource resource;
+  {
+    Compact ms(&resource), other(&resource);
+    for (int i = 0; i < 100; ++i) {
+      ms.insert(i % 10);
+      other.insert(i % 20 + 5);
+    }
+    const size_t before = resource.allocations;
+    ms.merge(other);
+    EXPECT_EQ(resource.allocations, before);
+    EXPECT_TRUE(other.empty());
+    EXPECT_EQ(other.distinct_size(), 0U);
+    EXPECT_EQ(ms.size(), 200U);
+    EXPECT_EQ(ms.distinct_size(), 25U);
+    EXPECT_EQ(ms.count(3), 10U);
+    EXPECT_EQ(ms.count(7), 15U);
+    EXPECT_EQ(ms.count(20), 5U);
+    EXPECT_EQ(std::distance(ms.begin(), ms.end()), 200);
+  }
+  EXPECT_EQ(resource.outstanding, 0U);
+}
+
+TEST(MultisetTest, CompactMergeThrowingCompareKeepsCounts) {
+  using Compact =
+      s21::multiset<int, LimitedLess, std::allocator<int>, false, true>;
+  for (int limit : {0, 5, 30, 60}) {
+    LimitedLess::limit = -1;
+    Compact ms, other;
+    for (int i = 0; i < 30; ++i) {
+      ms.insert(i % 10);
+      other.insert(i % 15 + 5);
+    }
+    LimitedLess::calls = 0;
+    LimitedLess::limit = limit;
+    EXPECT_THROW(ms.merge(other), std::runtime_error);
+    LimitedLess::limit = -1;
+
+    // ни одна копия не потерялась и не удвоилась, size() совпадает с обходом
+    EXPECT_EQ(ms.size() + other.size(), 60U);
+    EXPECT_EQ(std::distance(ms.begin(), ms.end()),
+              static_cast<std::ptrdiff_t>(ms.size()));
+    EXPECT_EQ(std::distance(other.begin(), other.end()),
+              static_cast<std::ptrdiff_t>(other.size()));
+    for (int key = 0; key < 20; ++key) {
+      const size_t expected = (key < 10 ? 3 : 0) + (key >= 5 ? 2 : 0);
+      EXPECT_EQ(ms.count(key) + other.count(key), expected);
+    }
+  }
+}
+
+TEST(MultisetTest, CustomCompareAndTransparentCount) {
+  s21::multiset<int, std::greater<int>> desc = {1, 3, 3, 2};
+  EXPECT_EQ(*desc.begin(), 3);
+  EXPECT_EQ(*--desc.end(), 1);
+  EXPECT_EQ(desc.count(3), 2U);
+
+  s21::compact_multiset<std::string, std::less<>> words = {"a", "b", "a"};
+  EXPECT_EQ(words.count(std::string_view("a")), 2U);
+  EXPECT_TRUE(words.contains(std::string_view("b")));
+  EXPECT_EQ(*words.find(std::string_view("b")), "b");
+}
+
+TEST(MultisetTest, PmrMultisetAllocatesFromResource) {
+  CountingResource resource;
+  {
+    s21::pmr::multiset<int> ms(&resource);
+    ms.insert(1);
+    ms.insert(1);
+    EXPECT_EQ(resource.allocations, 2U);
+    s21::compact_multiset<int> compact;
+    EXPECT_TRUE(compact.get_allocator() == std::allocator<int>());
+  }
+  EXPECT_EQ(resource.outstanding, 0U);
+}
+
 //__________________<<MULTISET<<_______________
 
+//__________________>>FLAT>>___________________
+
+TEST(FlatSetTest, BulkConstructionSortsAndDedupes) {
+  std::vector<int> input = {5, 1, 4, 1, 3, 5, 2};
+  s21::flat_set<int> s(input.begin(), input.end());
+  std::vector<int> expected = {1, 2, 3, 4, 5};
+  EXPECT_EQ(std::vector<int>(s.begin(), s.end()), expected);
+  EXPECT_EQ(s.size(), 5U);
+  EXPECT_TRUE(s.contains(3));
+  EXPECT_FALSE(s.contains(6));
+  EXPECT_EQ(s.find(6), s.end());
+  EXPECT_EQ(*s.lower_bound(0), 1);
+  EXPECT_EQ(s.upper_bound(5), s.end());
+}
+
+TEST(FlatSetTest, InsertEraseMatchStdSet) {
+  s21::flat_set<int> s;
+  std::set<int> expected;
+  std::mt19937 gen(11);
+  for (int i = 0; i < 5000; ++i) {
+    int key = static_cast<int>(gen() % 1000);
+    if (gen() % 3 == 0) {
+      EXPECT_EQ(s.erase(key), expected.erase(key));
+    } else {
+      auto result = s.insert(key);
+      EXPECT_EQ(result.second, expected.insert(key).second);
+      EXPECT_EQ(*result.first, key);
+    }
+  }
+  EXPECT_TRUE(std::equal(s.begin(), s.end(), expected.begin(), expected.end()));
+}
+
+TEST(FlatSetTest, MergeAndInsertMany) {
+  s21::flat_set<int> s1 = {1, 3, 5};
+  s21::flat_set<int> s2 = {2, 3, 4};
+  s1.merge(s2);
+  // 3 уже есть в s1 и остается в s2, как у set::merge
+  EXPECT_EQ(std::vector<int>(s2.begin(), s2.end()), std::vector<int>{3});
+  insert_many(s1, 0, 6);
+  std::vector<int> expected = {0, 1, 2, 3, 4, 5, 6};
+  EXPECT_EQ(std::vector<int>(s1.begin(), s1.end()), expected);
+
+  EXPECT_EQ(s1.count(4), 1U);
+  EXPECT_EQ(s1.count(7), 0U);
+  auto range = s1.equal_range(4);
+  EXPECT_EQ(range.second - range.first, 1);
+  EXPECT_EQ(*range.first, 4);
+  range = s1.equal_range(10);
+  EXPECT_EQ(range.first, range.second);
+}
+
+namespace {
+// ключ, сравнение которого бросает, когда кончится compares_left
+struct FlakyKey {
+  static int compares_left;
+  int value;
+  friend bool operator<(const FlakyKey &a, const FlakyKey &b) {
+    if (compares_left-- == 0) throw std::runtime_error("less");
+    return a.value < b.value;
+  }
+};
+int FlakyKey::compares_left = -1;
+}  // namespace
+
+TEST(FlatSetTest, ThrowingBatchInsertLeavesSetUnchanged) {
+  s21::flat_set<FlakyKey> s;
+  for (int i = 0; i < 20; i += 2) s.insert(FlakyKey{i});
+  std::vector<FlakyKey> batch;
+  for (int i = 15; i > -5; i -= 3) batch.push_back(FlakyKey{i});
+
+  for (int limit = 0; limit < 200; ++limit) {
+    s21::flat_set<FlakyKey> copy = s;
+    FlakyKey::compares_left = limit;
+    bool thrown = false;
+    try {
+      copy.insert(batch.begin(), batch.end());
+    } catch (const std::runtime_error &) {
+      thrown = true;
+    }
+    FlakyKey::compares_left = -1;
+    std::vector<int> values;
+    for (const FlakyKey &key : copy) values.push_back(key.value);
+    std::vector<int> expected = {0, 2, 4, 6, 8, 10, 12, 14, 16, 18};
+    if (!thrown) expected = {-3, 0, 2, 3, 4, 6, 8, 9, 10, 12, 14, 15, 16, 18};
+    EXPECT_EQ(values, expected);
+  }
+}
+
+TEST(FlatMapTest, BulkConstructionKeepsFirstDuplicate) {
+  s21::flat_map<int, std::string> m = {{3, "c"}, {1, "a"}, {3, "x"}, {2, "b"}};
+  ASSERT_EQ(m.size(), 3U);
+  EXPECT_EQ(m.at(3), "c");
+  EXPECT_EQ(m.begin()->first, 1);
+  EXPECT_THROW(m.at(4), std::out_of_range);
+
+  std::vector<std::pair<int, std::string>> more = {
+      {5, "e"}, {2, "y"}, {4, "d"}};
+  m.insert(more.begin(), more.end());
+  ASSERT_EQ(m.size(), 5U);
+  EXPECT_EQ(m.at(2), "b");
+  int expected_key = 1;
+  for (const auto &item : m) EXPECT_EQ(item.first, expected_key++);
+}
+
+TEST(FlatMapTest, AccessAndModify) {
+  s21::flat_map<std::string, int> m;
+  m["b"] = 2;
+  m["a"] = 1;
+  ++m["b"];
+  EXPECT_EQ(m["b"], 3);
+  EXPECT_FALSE(m.insert("a", 10).second);
+  EXPECT_EQ(m.at("a"), 1);
+  EXPECT_FALSE(m.insert_or_assign("a", 10).second);
+  EXPECT_EQ(m.at("a"), 10);
+  EXPECT_TRUE(m.try_emplace("c", 7).second);
+  EXPECT_FALSE(m.try_emplace("c", 8).second);
+  EXPECT_EQ(m.find("c")->second, 7);
+
+  m.erase(m.find("a"));
+  EXPECT_FALSE(m.contains("a"));
+  EXPECT_EQ(m.erase("zzz"), 0U);
+  EXPECT_EQ(m.size(), 2U);
+}
+
+TEST(FlatMapTest, MergeLeavesDuplicatesInSource) {
+  s21::flat_map<int, std::string> m1 = {{1, "a"}, {3, "c"}, {5, "e"}};
+  s21::flat_map<int, std::string> m2 = {
+      {0, "z"}, {3, "x"}, {4, "d"}, {5, "y"}, {6, "f"}};
+  m1.merge(m2);
+
+  std::vector<int> keys;
+  for (const auto &item : m1) keys.push_back(item.first);
+  EXPECT_EQ(keys, (std::vector<int>{0, 1, 3, 4, 5, 6}));
+  EXPECT_EQ(m1.at(3), "c");
+  EXPECT_EQ(m1.at(4), "d");
+  ASSERT_EQ(m2.size(), 2U);
+  EXPECT_EQ(m2.at(3), "x");
+  EXPECT_EQ(m2.at(5), "y");
+}
+
+TEST(FlatMapTest, IteratorKeepsKeysReadOnly) {
+  using Map = s21::flat_map<int, int>;
+  static_assert(std::is_same_v<decltype(std::declval<Map::iterator>()->first),
+                               const int &>);
+  static_assert(
+      std::is_same_v<decltype((*std::declval<Map::iterator>()).second), int &>);
+  static_assert(std::is_same_v<decltype(std::declval<Map::const_iterator>()
+                                            ->second),
+                               const int &>);
+
+  Map m = {{2, 20}, {1, 10}, {3, 30}};
+  for (auto it = m.begin(); it != m.end(); ++it) it->second += it->first;
+  EXPECT_EQ(m.at(2), 22);
+  Map::const_iterator last = m.end() - 1;
+  EXPECT_EQ(last->first, 3);
+  EXPECT_EQ(m.begin()[1].second, 22);
+  EXPECT_EQ(m.count(1), 1U);
+  auto range = m.equal_range(2);
+  EXPECT_EQ(range.second - range.first, 1);
+  EXPECT_EQ(std::distance(m.begin(), m.end()), 3);
+}
+
+//__________________<<FLAT<<___________________
+
+//_________________>>BTREE>>___________________
+
+// узлы на 4 слота: даже небольшие тесты делят и сливают узлы на нескольких
+// уровнях
+template <typename Key, typename T>
+using small_btree_map = s21::btree_map<Key, T, std::less<Key>, 64>;
+
+TEST(BtreeMapTest, MatchesStdMap) {
+  small_btree_map<int, int> m;
+  std::map<int, int> expected;
+  std::mt19937 gen(11);
+  for (int i = 0; i < 50000; ++i) {
+    int key = static_cast<int>(gen() % 3000);
+    switch (gen() % 4) {
+      case 0:
+        EXPECT_EQ(m.erase(key), expected.erase(key));
+        break;
+      case 1:
+        EXPECT_EQ(m.contains(key), expected.count(key) == 1);
+        break;
+      default:
+        m[key] += i;
+        expected[key] += i;
+    }
+  }
+  ASSERT_EQ(m.size(), expected.size());
+  auto it = m.begin();
+  for (const auto &item : expected) {
+    ASSERT_EQ(it->first, item.first);
+    EXPECT_EQ(it->second, item.second);
+    ++it;
+  }
+  EXPECT_EQ(it, m.end());
+  for (auto rit = expected.rbegin(); rit != expected.rend(); ++rit) {
+    --it;
+    EXPECT_EQ(it->first, rit->first);
+  }
+  EXPECT_EQ(it, m.begin());
+}
+
+TEST(BtreeMapTest, EraseReturnsNextAndEmptiesTree) {
+  small_btree_map<long, int> m;
+  for (long i = 0; i < 2000; ++i) m.insert({i, 0});
+  long expected = 0;
+  for (auto it = m.begin(); it != m.end(); expected += 2) {
+    ASSERT_EQ(it->first, expected);
+    it = m.erase(it);
+    ASSERT_NE(it, m.end());
+    EXPECT_EQ(it->first, expected + 1);
+    ++it;
+  }
+  EXPECT_EQ(m.size(), 1000U);
+  while (!m.empty()) m.erase(m.begin());
+  EXPECT_EQ(m.begin(), m.end());
+  m[5] = 1;
+  EXPECT_EQ(m.size(), 1U);
+}
+
+TEST(BtreeMapTest, BoundsAndRangeScan) {
+  s21::btree_map<long, long> m;
+  for (long i = 0; i < 100000; i += 10) m[i] = i * 2;
+  EXPECT_EQ(m.lower_bound(25)->first, 30);
+  EXPECT_EQ(m.lower_bound(30)->first, 30);
+  EXPECT_EQ(m.upper_bound(30)->first, 40);
+  EXPECT_EQ(m.lower_bound(100000), m.end());
+  auto range = m.equal_range(500);
+  EXPECT_EQ(std::distance(range.first, range.second), 1);
+  long sum = 0;
+  for (auto it = m.lower_bound(1000); it != m.lower_bound(2000); ++it) {
+    sum += it->second;
+  }
+  EXPECT_EQ(sum, 2 * (1000 + 1990) * 100 / 2);
+  EXPECT_FALSE(m.contains(std::numeric_limits<long>::max()));
+  m[std::numeric_limits<long>::max()] = 1;
+  EXPECT_EQ(m.lower_bound(100000)->first, std::numeric_limits<long>::max());
+}
+
+TEST(BtreeMapTest, ApiMatchesMap) {
+  s21::btree_map<std::string, int> m = {{"b", 2}, {"a", 1}, {"b", 3}};
+  EXPECT_EQ(m.size(), 2U);
+  EXPECT_EQ(m.at("b"), 2);
+  EXPECT_THROW(m.at("z"), std::out_of_range);
+  EXPECT_FALSE(m.insert("a", 5).second);
+  EXPECT_FALSE(m.insert_or_assign("a", 5).second);
+  EXPECT_EQ(m["a"], 5);
+  EXPECT_TRUE(m.try_emplace("c", 7).second);
+  EXPECT_EQ(m.find("c")->second, 7);
+  EXPECT_EQ(m.find("d"), m.end());
+  EXPECT_EQ((*m.begin()).first, "a");
+
+  s21::btree_map<std::string, int> copy(m);
+  m.clear();
+  EXPECT_TRUE(m.empty());
+  EXPECT_EQ(copy.size(), 3U);
+  m = std::move(copy);
+  EXPECT_EQ(m.count("c"), 1U);
+  s21::btree_map<std::string, int> other = {{"c", 0}, {"d", 4}};
+  m.merge(other);
+  // "c" уже есть в m и остается в other, как у map::merge
+  ASSERT_EQ(other.size(), 1U);
+  EXPECT_EQ(other.at("c"), 0);
+  EXPECT_EQ(m.at("d"), 4);
+  EXPECT_EQ(m.at("c"), 7);
+}
+
+TEST(BtreeMapTest, IteratorKeepsKeysReadOnly) {
+  using Map = small_btree_map<int, int>;
+  static_assert(!std::is_assignable_v<
+                decltype((std::declval<Map::iterator>()->first)), int>);
+  static_assert(!std::is_assignable_v<
+                decltype(((*std::declval<Map::iterator>()).first)), int>);
+  static_assert(std::is_same_v<decltype(std::declval<Map::iterator>()->second),
+                               int &>);
+  static_assert(std::is_same_v<decltype(std::declval<Map::const_iterator>()
+                                            ->second),
+                               const int &>);
+
+  Map m;
+  for (int i = 0; i < 100; ++i) m[i] = i;
+  for (auto it = m.begin(); it != m.end(); ++it) it->second += it->first;
+  EXPECT_EQ(m.at(50), 100);
+  EXPECT_EQ(m.find(50)->first, 50);
+  Map::const_iterator last = --m.end();
+  EXPECT_EQ(last->first, 99);
+  m.erase(last);
+  EXPECT_EQ(m.size(), 99U);
+  EXPECT_EQ(std::distance(m.begin(), m.end()), 99);
+}
+
+TEST(BtreeSetTest, MergeMovesOnlyAbsentKeys) {
+  // строки длиннее SSO: перенос должен перемещать их, а не копировать
+  auto word = [](int i) { return std::string(40, 'k') + std::to_string(i); };
+  s21::btree_set<std::string, std::less<std::string>, 128> s1, s2;
+  for (int i = 0; i < 3000; i += 2) s1.insert(word(i));
+  for (int i = 0; i < 3000; i += 3) s2.insert(word(i));
+  s1.merge(s2);
+
+  std::set<std::string> left, right;
+  for (int i = 0; i < 3000; ++i) {
+    if (i % 2 == 0 || i % 3 == 0) left.insert(word(i));
+    if (i % 6 == 0) right.insert(word(i));
+  }
+  EXPECT_TRUE(std::equal(s1.begin(), s1.end(), left.begin(), left.end()));
+  EXPECT_TRUE(std::equal(s2.begin(), s2.end(), right.begin(), right.end()));
+  for (const auto &key : right) EXPECT_TRUE(s2.contains(key));
+}
+
+TEST(BtreeMapTest, DeepCopyIsIndependent) {
+  small_btree_map<std::string, int> m;
+  for (int i = 0; i < 500; ++i) m[std::to_string(i)] = i;
+  small_btree_map<std::string, int> copy(m);
+  for (int i = 0; i < 500; i += 2) m.erase(std::to_string(i));
+  EXPECT_EQ(copy.size(), 500U);
+  EXPECT_EQ(m.size(), 250U);
+  int sum = 0;
+  for (const auto &item : copy) sum += item.second;
+  EXPECT_EQ(sum, 499 * 500 / 2);
+}
+
+TEST(BtreeSetTest, ArithmeticKeys) {
+  s21::btree_set<double, std::less<double>, 64> d = {2.5, -1.0, 2.5, 0.0};
+  EXPECT_EQ(d.size(), 3U);
+  EXPECT_EQ(*d.begin(), -1.0);
+  EXPECT_EQ(*d.lower_bound(0.5), 2.5);
+
+  s21::btree_set<int> s;
+  std::set<int> expected;
+  std::mt19937 gen(3);
+  // весь диапазон int; max, совпадающий с заполнителем слотов, ниже
+  std::uniform_int_distribution<int> keys(
+      std::numeric_limits<int>::min(), std::numeric_limits<int>::max() - 1);
+  for (int i = 0; i < 20000; ++i) {
+    int key = keys(gen);
+    EXPECT_EQ(s.insert(key).second, expected.insert(key).second);
+  }
+  s.insert(std::numeric_limits<int>::max());
+  expected.insert(std::numeric_limits<int>::max());
+  EXPECT_TRUE(std::equal(s.begin(), s.end(), expected.begin(), expected.end()));
+  EXPECT_EQ(*s.lower_bound(std::numeric_limits<int>::max()),
+            std::numeric_limits<int>::max());
+  for (int key : expected) EXPECT_EQ(s.count(key), 1U);
+}
+
+//_________________<<BTREE<<___________________
+
+//_______________>>UNORDERED>>_________________
+
+TEST(UnorderedMapTest, MatchesStdUnorderedMap) {
+  s21::unordered_map<int, int> m;
+  std::unordered_map<int, int> expected;
+  std::mt19937 gen(5);
+  for (int i = 0; i < 20000; ++i) {
+    int key = static_cast<int>(gen() % 2000);
+    switch (gen() % 4) {
+      case 0:
+        EXPECT_EQ(m.erase(key), expected.erase(key));
+        break;
+      case 1:
+        EXPECT_EQ(m.contains(key), expected.count(key) == 1);
+        break;
+      default:
+        m[key] += i;
+        expected[key] += i;
+    }
+  }
+  ASSERT_EQ(m.size(), expected.size());
+  for (const auto &item : expected) EXPECT_EQ(m.at(item.first), item.second);
+  size_t visited = 0;
+  for (const auto &item : m) visited += expected.count(item.first);
+  EXPECT_EQ(visited, expected.size());
+}
+
+TEST(UnorderedMapTest, EraseWhileIterating) {
+  s21::unordered_map<int, int> m;
+  for (int i = 0; i < 1000; ++i) m.insert({i, i});
+  std::vector<int> seen;
+  for (auto it = m.begin(); it != m.end();) {
+    seen.push_back(it->first);
+    it = it->first % 2 == 0 ? m.erase(it) : ++it;
+  }
+  std::sort(seen.begin(), seen.end());
+  ASSERT_EQ(seen.size(), 1000U);
+  for (int i = 0; i < 1000; ++i) EXPECT_EQ(seen[i], i);
+  EXPECT_EQ(m.size(), 500U);
+  EXPECT_FALSE(m.contains(10));
+  EXPECT_TRUE(m.contains(11));
+}
+
+TEST(UnorderedMapTest, ApiMatchesMap) {
+  s21::unordered_map<std::string, int> m = {{"a", 1}, {"b", 2}, {"a", 3}};
+  EXPECT_EQ(m.size(), 2U);
+  EXPECT_EQ(m.at("a"), 1);
+  EXPECT_THROW(m.at("z"), std::out_of_range);
+  EXPECT_FALSE(m.insert("b", 5).second);
+  EXPECT_FALSE(m.insert_or_assign("b", 5).second);
+  EXPECT_EQ(m["b"], 5);
+  EXPECT_TRUE(m.try_emplace("c", 7).second);
+  EXPECT_EQ(m.find("c")->second, 7);
+  EXPECT_EQ(m.find("d"), m.end());
+
+  s21::unordered_map<std::string, int> copy(m);
+  m.clear();
+  EXPECT_TRUE(m.empty());
+  EXPECT_EQ(copy.size(), 3U);
+  m = std::move(copy);
+  EXPECT_EQ(m.count("c"), 1U);
+  insert_many(m, std::make_pair(std::string("d"), 4));
+  EXPECT_EQ(m.at("d"), 4);
+}
+
+namespace {
+struct StringHash {
+  using is_transparent = void;
+  size_t operator()(std::string_view s) const {
+    return std::hash<std::string_view>()(s);
+  }
+};
+
+// все ключи в одной цепочке: проверяет рост при переполнении хвоста
+struct ConstantHash {
+  size_t operator()(int) const { return 0; }
+};
+}  // namespace
+
+TEST(UnorderedMapTest, HeterogeneousLookup) {
+  s21::unordered_map<std::string, int, StringHash, std::equal_to<>> m;
+  m["session-1"] = 1;
+  m["session-2"] = 2;
+  std::string_view key = "session-2";
+  EXPECT_EQ(m.find(key)->second, 2);
+  EXPECT_TRUE(m.contains("session-1"));
+  EXPECT_EQ(m.at(key), 2);
+  EXPECT_EQ(m.erase(key), 1U);
+  EXPECT_FALSE(m.contains(key));
+}
+
+TEST(UnorderedMapTest, KeysAreConstAndMergeKeepsDuplicates) {
+  static_assert(std::is_same_v<
+                s21::unordered_map<std::string, int>::value_type,
+                std::pair<const std::string, int>>);
+  static_assert(std::is_same_v<
+                decltype(s21::unordered_map<int, int>().begin()->first),
+                const int>);
+
+  // одна цепочка: перенос из other сдвигает его оставшиеся элементы
+  s21::unordered_map<int, std::string, ConstantHash> m1, m2;
+  for (int i = 0; i < 200; i += 2) m1[i] = "m1";
+  for (int i = 0; i < 200; i += 3) m2[i] = "m2";
+  m1.merge(m2);
+
+  EXPECT_EQ(m1.size(), 100U + 33U);
+  EXPECT_EQ(m2.size(), 34U);
+  for (int i = 0; i < 200; ++i) {
+    EXPECT_EQ(m1.contains(i), i % 2 == 0 || i % 3 == 0);
+    EXPECT_EQ(m2.contains(i), i % 6 == 0);
+    if (m1.contains(i)) {
+      EXPECT_EQ(m1.at(i), i % 2 == 0 ? "m1" : "m2");
+    }
+  }
+
+  // строковые ключи переезжают при росте таблицы перемещением
+  auto word = [](int i) { return std::string(40, 'a') + std::to_string(i); };
+  s21::unordered_map<std::string, int> words, more;
+  for (int i = 0; i < 1000; ++i) words[word(i)] = i;
+  for (int i = 500; i < 1500; ++i) more[word(i)] = -i;
+  words.merge(more);
+  EXPECT_EQ(words.size(), 1500U);
+  EXPECT_EQ(more.size(), 500U);
+  EXPECT_EQ(words.at(word(1499)), -1499);
+  EXPECT_EQ(more.at(word(500)), -500);
+}
+
+TEST(UnorderedSetTest, CustomHashWithCollisions) {
+  s21::unordered_set<int, ConstantHash> s;
+  for (int i = 0; i < 300; ++i) EXPECT_TRUE(s.insert(i).second);
+  EXPECT_FALSE(s.insert(42).second);
+  for (int i = 0; i < 300; i += 3) EXPECT_EQ(s.erase(i), 1U);
+  EXPECT_EQ(s.size(), 200U);
+  for (int i = 0; i < 300; ++i) EXPECT_EQ(s.contains(i), i % 3 != 0);
+}
+
+TEST(UnorderedSetTest, Basics) {
+  s21::unordered_set<int> s = {3, 1, 2, 3};
+  EXPECT_EQ(s.size(), 3U);
+  s21::unordered_set<int> other = {4, 1};
+  s.merge(other);
+  EXPECT_EQ(other.size(), 1U);
+  EXPECT_TRUE(other.contains(1));
+  EXPECT_EQ(s.size(), 4U);
+  int sum = 0;
+  for (int key : s) sum += key;
+  EXPECT_EQ(sum, 10);
+  s.reserve(1000);
+  EXPECT_GE(s.bucket_count() * s.max_load_factor(), 1000);
+  EXPECT_TRUE(s.contains(4));
+  s.erase(s.find(4));
+  EXPECT_EQ(s.count(4), 0U);
+}
+
+//_______________<<UNORDERED<<_________________
+
 //__________________>>List>>___________________
 TEST(ListTest, DefaultConstructor) {
   s21::list<int> list;
@@ -1294,6 +2768,74 @@ TEST(ListTest, Sort) {
   EXPECT_EQ(it2, expected_list.end());
 }
 
+TEST(ListTest, SortIsStableWithComparator) {
+  using Item = std::pair<int, int>;
+  s21::list<Item> list = {{3, 0}, {1, 1}, {3, 2}, {2, 3}, {1, 4}, {2, 5}};
+  list.sort([](const Item &a, const Item &b) { return a.first > b.first; });
+
+  std::vector<Item> expected = {{3, 0}, {3, 2}, {2, 3},
+                                {2, 5}, {1, 1}, {1, 4}};
+  // pop_back идёт по prev и tail, поэтому проверяет обратные связи
+  for (auto it = expected.rbegin(); it != expected.rend(); ++it) {
+    ASSERT_EQ(list.back(), *it);
+    list.pop_back();
+  }
+  EXPECT_TRUE(list.empty());
+}
+
+TEST(ListTest, SortThrowingComparatorKeepsAllNodes) {
+  std::vector<int> values(1000);
+  std::mt19937 gen(11);
+  for (int &v : values) v = static_cast<int>(gen() % 100);
+
+  for (int limit : {0, 1, 7, 500, 5000}) {
+    s21::list<int> list;
+    for (int v : values) list.push_back(v);
+    int calls = 0;
+    EXPECT_THROW(list.sort([&](int a, int b) {
+      if (calls++ == limit) throw std::runtime_error("compare");
+      return a < b;
+    }),
+                 std::runtime_error);
+
+    // узлы не потерялись, а связи prev согласованы с next
+    ASSERT_EQ(list.size(), values.size());
+    std::vector<int> forward(list.begin(), list.end());
+    std::vector<int> backward;
+    while (!list.empty()) {
+      backward.push_back(list.back());
+      list.pop_back();
+    }
+    std::reverse(backward.begin(), backward.end());
+    EXPECT_EQ(forward, backward);
+    std::sort(forward.begin(), forward.end());
+    std::vector<int> expected = values;
+    std::sort(expected.begin(), expected.end());
+    EXPECT_EQ(forward, expected);
+  }
+}
+
+TEST(ListTest, SortLargeMatchesStdStableSort) {
+  std::vector<int> values(100000);
+  std::mt19937 gen(7);
+  for (int &v : values) v = static_cast<int>(gen() % 1000);
+  s21::list<int> list;
+  for (int v : values) list.push_back(v);
+
+  list.sort();
+  std::stable_sort(values.begin(), values.end());
+
+  auto it = list.begin();
+  for (int v : values) {
+    ASSERT_EQ(*it, v);
+    ++it;
+  }
+  EXPECT_EQ(it, list.end());
+  EXPECT_EQ(list.back(), values.back());
+  list.push_back(-1);
+  EXPECT_EQ(list.back(), -1);
+}
+
 TEST(ListMergeTest, MergeTwoEmptyLists) {
   s21::list<int> list1;
   s21::list<int> list2;
@@ -1371,6 +2913,153 @@ TEST(ListMergeTest, MergeTwoNonEmptyLists) {
   }
 }
 
+TEST(ListMergeTest, MergeMovesNodesAndIsStable) {
+  using Item = std::pair<int, char>;
+  auto by_key = [](const Item &a, const Item &b) { return a.first < b.first; };
+  s21::list<Item> list1 = {{1, 'a'}, {3, 'a'}, {5, 'a'}};
+  const Item *moved = nullptr;
+  {
+    s21::list<Item> list2 = {{0, 'b'}, {3, 'b'}, {6, 'b'}};
+    moved = &list2.back();
+    list1.merge(list2, by_key);
+    EXPECT_TRUE(list2.empty());
+  }  // узлы list2 переживают сам list2
+  std::vector<Item> expected = {{0, 'b'}, {1, 'a'}, {3, 'a'},
+                                {3, 'b'}, {5, 'a'}, {6, 'b'}};
+  EXPECT_EQ(&list1.back(), moved);
+  EXPECT_EQ(list1.size(), expected.size());
+  for (auto it = expected.rbegin(); it != expected.rend(); ++it) {
+    ASSERT_EQ(list1.back(), *it);
+    list1.pop_back();
+  }
+  list1.push_back({7, 'c'});
+  EXPECT_EQ(list1.front().first, 7);
+}
+
+TEST(ListSpliceTest, WholeList) {
+  s21::list<int> list1 = {1, 5};
+  s21::list<int> list2 = {2, 3, 4};
+  const int *first = &list2.front();
+  auto pos = list1.cbegin();
+  ++pos;
+  list1.splice(pos, list2);
+
+  EXPECT_TRUE(list2.empty());
+  EXPECT_EQ(list1.size(), 5U);
+  auto it = list1.begin();
+  ++it;
+  EXPECT_EQ(&*it, first);
+  int expected = 1;
+  for (auto value = list1.begin(); value != list1.end(); ++value) {
+    EXPECT_EQ(*value, expected++);
+  }
+  list2.push_back(10);
+  list1.splice(list1.cend(), list2);
+  EXPECT_EQ(list1.back(), 10);
+}
+
+TEST(ListSpliceTest, SingleElement) {
+  s21::list<int> list1 = {1, 2};
+  s21::list<int> list2 = {7, 8, 9};
+  auto it = list2.cbegin();
+  ++it;
+  list1.splice(list1.cend(), list2, it);
+  EXPECT_EQ(list1.size(), 3U);
+  EXPECT_EQ(list1.back(), 8);
+  EXPECT_EQ(list2.size(), 2U);
+  EXPECT_EQ(list2.front(), 7);
+  EXPECT_EQ(list2.back(), 9);
+
+  // внутри одного списка: переносим последний элемент в начало
+  list2.splice(list2.cbegin(), list2, list2.cbegin());
+  auto last = list1.cbegin();
+  ++last;
+  ++last;
+  list1.splice(list1.cbegin(), list1, last);
+  EXPECT_EQ(list1.front(), 8);
+  EXPECT_EQ(list1.back(), 2);
+  EXPECT_EQ(list1.size(), 3U);
+}
+
+TEST(ListSpliceTest, Range) {
+  s21::list<int> list1 = {1, 6};
+  s21::list<int> list2 = {0, 2, 3, 4, 5, 9};
+  auto first = list2.cbegin();
+  ++first;
+  auto last = first;
+  for (int i = 0; i < 4; ++i) ++last;
+  auto pos = list1.cbegin();
+  ++pos;
+  list1.splice(pos, list2, first, last);
+
+  EXPECT_EQ(list1.size(), 6U);
+  EXPECT_EQ(list2.size(), 2U);
+  EXPECT_EQ(list2.front(), 0);
+  EXPECT_EQ(list2.back(), 9);
+  int expected = 1;
+  for (auto it = list1.begin(); it != list1.end(); ++it) {
+    EXPECT_EQ(*it, expected++);
+  }
+
+  // хвост до end() в начало того же списка
+  auto tail = list1.cbegin();
+  ++tail;
+  ++tail;
+  ++tail;
+  list1.splice(list1.cbegin(), list1, tail, list1.cend());
+  EXPECT_EQ(list1.front(), 4);
+  EXPECT_EQ(list1.back(), 3);
+  EXPECT_EQ(list1.size(), 6U);
+}
+
+TEST(ListTest, DecrementFromEnd) {
+  s21::list<int> list = {1, 2, 3};
+  auto it = list.end();
+  --it;
+  EXPECT_EQ(*it, 3);
+  std::vector<int> reversed;
+  for (auto back = list.end(); back != list.begin();) {
+    reversed.push_back(*--back);
+  }
+  EXPECT_EQ(reversed, std::vector<int>({3, 2, 1}));
+
+  const s21::list<int> &view = list;
+  int sum = 0;
+  for (int value : view) sum += value;
+  EXPECT_EQ(sum, 6);
+  s21::list<int>::const_iterator converted = list.begin();
+  EXPECT_EQ(converted, list.cbegin());
+}
+
+TEST(ListTest, SwapAndMoveKeepEndValid) {
+  s21::list<int> full = {1, 2};
+  s21::list<int> empty;
+  full.swap(empty);
+  EXPECT_TRUE(full.empty());
+  EXPECT_EQ(full.begin(), full.end());
+  EXPECT_EQ(*--empty.end(), 2);
+
+  s21::list<int> moved(std::move(empty));
+  EXPECT_EQ(empty.begin(), empty.end());
+  EXPECT_EQ(*--moved.end(), 2);
+  empty.push_back(5);
+  EXPECT_EQ(*empty.begin(), 5);
+  moved.reverse();
+  EXPECT_EQ(*moved.begin(), 2);
+  EXPECT_EQ(*--moved.end(), 1);
+}
+
+#ifdef S21_LIST_CHECKED_ITERATORS
+TEST(ListTest, CheckedIteratorsThrowOutOfBounds) {
+  s21::list<int> list = {1};
+  auto end = list.end();
+  EXPECT_THROW(*end, std::out_of_range);
+  EXPECT_THROW(++end, std::out_of_range);
+  auto begin = list.begin();
+  EXPECT_THROW(--begin, std::out_of_range);
+}
+#endif
+
 TEST(ListTest, EmplaceInt) {
   s21::list<int> list = {1, 2, 3};
   auto iter = list.cbegin();
@@ -1412,8 +3101,260 @@ TEST(ListTest, EmplaceFront) {
   EXPECT_EQ(*iter, 1);
 }
 
+TEST(ListTest, EmplaceConstructsInPlace) {
+  Heavy::Reset();
+  s21::list<Heavy> list;
+  list.emplace_back("b", 2);
+  list.emplace_front("a", 1);
+  auto it = list.emplace(list.cend(), "d", 4);
+  list.emplace(list.cbegin(), "zero", 0);
+  list.insert_many_back(Heavy("e", 5));
+  list.push_front(Heavy("first", -1));
+
+  EXPECT_EQ((*it).weight, 4);
+  EXPECT_EQ(Heavy::constructed, 6);
+  EXPECT_EQ(Heavy::copied, 0);
+  EXPECT_EQ(list.size(), 6U);
+  EXPECT_EQ(list.front().name, "first");
+  EXPECT_EQ(list.back().name, "e");
+}
+
+TEST(ListTest, PushBackAfterPopFront) {
+  s21::list<int> list = {1};
+  list.pop_front();
+  list.push_back(2);
+  EXPECT_EQ(list.front(), 2);
+  EXPECT_EQ(list.back(), 2);
+  list.erase(list.begin());
+  list.push_back(3);
+  EXPECT_EQ(list.front(), 3);
+}
+
+TEST(ListTest, PoolReusesFreedNodes) {
+  s21::list<int> list = {1, 2};
+  const int *freed = &list.front();
+  list.pop_front();
+  list.push_back(3);
+  EXPECT_EQ(&list.back(), freed);
+  EXPECT_EQ(list.front(), 2);
+  EXPECT_EQ(list.back(), 3);
+}
+
+TEST(ListTest, AssignmentDestroysOldElements) {
+  Tracked::alive = 0;
+  {
+    s21::list<Tracked> a = {1, 2, 3};
+    s21::list<Tracked> b = {4, 5};
+    b = a;
+    EXPECT_EQ(Tracked::alive, 6);
+    a = std::move(b);
+    EXPECT_EQ(Tracked::alive, 3);
+    EXPECT_EQ(a.size(), 3U);
+    EXPECT_EQ(a.back().value, 3);
+    a.swap(b);
+    EXPECT_TRUE(a.empty());
+    EXPECT_EQ(b.front().value, 1);
+  }
+  EXPECT_EQ(Tracked::alive, 0);
+}
+
+TEST(ListTest, PmrListAllocatesFromResource) {
+  CountingResource resource;
+  {
+    s21::pmr::list<int> a(&resource);
+    for (int i = 0; i < 100; ++i) a.push_back(i);
+    EXPECT_GT(resource.allocations, 0U);
+    EXPECT_EQ(a.get_allocator().resource(), &resource);
+
+    CountingResource other;
+    {
+      s21::pmr::list<int> b(&other);
+      b.push_back(-1);
+      // перенесенный узел продолжает жить в блоке ресурса other
+      a.splice(a.begin(), b);
+      EXPECT_EQ(a.front(), -1);
+    }
+    EXPECT_GT(other.outstanding, 0U);
+    a.clear();
+
+    s21::pmr::list<int> c(&other);
+    c.push_back(7);
+    a = std::move(c);
+    EXPECT_EQ(a.get_allocator().resource(), &resource);
+    EXPECT_EQ(a.front(), 7);
+  }
+  EXPECT_EQ(resource.outstanding, 0U);
+}
+
 //_______________<<List<<____________________
 
+//_________________>>DEQUE>>_________________
+
+TEST(DequeTest, DefaultConstructor) {
+  s21::deque<int> d;
+  EXPECT_TRUE(d.empty());
+  EXPECT_EQ(d.size(), 0U);
+  EXPECT_EQ(d.capacity(), 0U);
+  EXPECT_EQ(d.begin(), d.end());
+}
+
+TEST(DequeTest, InitializerListConstructor) {
+  s21::deque<std::string> d = {"a", "b", "c"};
+  EXPECT_EQ(d.size(), 3U);
+  EXPECT_EQ(d.front(), "a");
+  EXPECT_EQ(d.back(), "c");
+  EXPECT_EQ(d[1], "b");
+  EXPECT_EQ(d.at(2), "c");
+  EXPECT_THROW(d.at(3), std::out_of_range);
+}
+
+TEST(DequeTest, PushPopBothEnds) {
+  s21::deque<int> d;
+  std::deque<int> expected;
+  for (int i = 0; i < 1000; ++i) {
+    if (i % 3 == 0) {
+      d.push_front(i);
+      expected.push_front(i);
+    } else {
+      d.push_back(i);
+      expected.push_back(i);
+    }
+    if (i % 7 == 0 && !expected.empty()) {
+      d.pop_front();
+      expected.pop_front();
+    }
+    if (i % 11 == 0 && !expected.empty()) {
+      d.pop_back();
+      expected.pop_back();
+    }
+  }
+  ASSERT_EQ(d.size(), expected.size());
+  EXPECT_TRUE(std::equal(d.begin(), d.end(), expected.begin()));
+  EXPECT_EQ(d.front(), expected.front());
+  EXPECT_EQ(d.back(), expected.back());
+}
+
+TEST(DequeTest, EmptyAccessThrows) {
+  s21::deque<int> d;
+  const s21::deque<int> &cd = d;
+  EXPECT_THROW(d.front(), std::out_of_range);
+  EXPECT_THROW(d.back(), std::out_of_range);
+  EXPECT_THROW(cd.front(), std::out_of_range);
+  EXPECT_THROW(cd.back(), std::out_of_range);
+  EXPECT_THROW(d.pop_front(), std::out_of_range);
+  EXPECT_THROW(d.pop_back(), std::out_of_range);
+
+  d.push_back(1);
+  d.pop_front();
+  EXPECT_THROW(d.pop_back(), std::out_of_range);
+  EXPECT_TRUE(d.empty());
+}
+
+TEST(DequeTest, WrapAroundKeepsCapacity) {
+  s21::deque<int> d;
+  d.reserve(8);
+  for (int i = 0; i < 8; ++i) d.push_back(i);
+  // голова обходит весь буфер, но новых выделений нет
+  for (int i = 8; i < 100; ++i) {
+    d.pop_front();
+    d.push_back(i);
+  }
+  EXPECT_EQ(d.capacity(), 8U);
+  EXPECT_EQ(d.front(), 92);
+  EXPECT_EQ(d.back(), 99);
+  EXPECT_EQ(d.array_one().second + d.array_two().second, 8U);
+  EXPECT_EQ(d.array_one().first[0], 92);
+}
+
+TEST(DequeTest, GrowWhileWrapped) {
+  s21::deque<std::string> d;
+  for (int i = 0; i < 6; ++i) d.push_back(std::to_string(i));
+  for (int i = 0; i < 4; ++i) d.pop_front();
+  for (int i = 6; i < 40; ++i) d.push_back(std::to_string(i));
+  d.push_front("front");
+  ASSERT_EQ(d.size(), 37U);
+  EXPECT_EQ(d[0], "front");
+  for (size_t i = 1; i < d.size(); ++i) EXPECT_EQ(d[i], std::to_string(i + 3));
+  // первый элемент стоит в последней ячейке, остальные - с начала буфера
+  EXPECT_EQ(d.array_one().second, 1U);
+  EXPECT_EQ(d.array_two().second, 36U);
+}
+
+TEST(DequeTest, PushOwnElementWhileGrowing) {
+  s21::deque<std::string> d = {"x", "y"};
+  while (d.size() < d.capacity()) d.push_back("z");
+  d.push_back(d.front());
+  d.push_front(d.back());
+  EXPECT_EQ(d.back(), "x");
+  EXPECT_EQ(d.front(), "x");
+}
+
+TEST(DequeTest, RandomAccessIterator) {
+  s21::deque<int> d;
+  for (int i = 0; i < 10; ++i) d.push_front(i);
+  auto it = d.begin();
+  EXPECT_EQ(d.end() - it, 10);
+  EXPECT_EQ(it[3], 6);
+  EXPECT_EQ(*(it + 9), 0);
+  EXPECT_TRUE(it < d.end());
+  s21::deque<int>::const_iterator cit = d.end();
+  --cit;
+  EXPECT_EQ(*cit, 0);
+  std::sort(d.begin(), d.end());
+  EXPECT_EQ(d.front(), 0);
+  EXPECT_EQ(d.back(), 9);
+}
+
+TEST(DequeTest, CopyAndMove) {
+  s21::deque<std::string> d;
+  for (int i = 0; i < 20; ++i) d.push_front(std::to_string(i));
+  s21::deque<std::string> copy(d);
+  EXPECT_TRUE(std::equal(copy.begin(), copy.end(), d.begin(), d.end()));
+  s21::deque<std::string> moved(std::move(d));
+  EXPECT_TRUE(d.empty());
+  EXPECT_EQ(moved.size(), 20U);
+  d = moved;
+  EXPECT_EQ(d.front(), "19");
+  copy = std::move(moved);
+  EXPECT_EQ(copy.back(), "0");
+  d.swap(copy);
+  EXPECT_EQ(d.size(), 20U);
+}
+
+TEST(DequeTest, ClearAndShrink) {
+  s21::deque<std::string> d;
+  for (int i = 0; i < 100; ++i) d.push_back(std::to_string(i));
+  for (int i = 0; i < 90; ++i) d.pop_front();
+  d.shrink_to_fit();
+  EXPECT_EQ(d.capacity(), 16U);
+  EXPECT_EQ(d.front(), "90");
+  d.clear();
+  EXPECT_TRUE(d.empty());
+  d.shrink_to_fit();
+  EXPECT_EQ(d.capacity(), 0U);
+}
+
+TEST(DequeTest, InsertManyBothEnds) {
+  s21::deque<int> d = {3};
+  d.insert_many_back(4, 5);
+  d.insert_many_front(2, 1);
+  std::vector<int> expected = {1, 2, 3, 4, 5};
+  EXPECT_TRUE(std::equal(d.begin(), d.end(), expected.begin()));
+}
+
+TEST(DequeTest, PmrDequeAllocatesFromResource) {
+  CountingResource resource;
+  {
+    s21::pmr::deque<int> d(&resource);
+    for (int i = 0; i < 1000; ++i) d.push_back(i);
+    EXPECT_GT(resource.allocations, 0U);
+    EXPECT_EQ(d.get_allocator().resource(), &resource);
+  }
+  EXPECT_EQ(resource.outstanding, 0U);
+}
+
+//_________________<<DEQUE<<_________________
+
 //_________________>>Stack>>_________________
 
 TEST(StackTest, DefaultConstructor) {
@@ -1455,6 +3396,17 @@ TEST(StackTest, EmptyInitializerListConstructor) {
   ASSERT_EQ(s.size(), 0u);
 }
 
+TEST(StackTest, EmptyPopAndTopThrow) {
+  s21::stack<int> s;
+  EXPECT_THROW(s.top(), std::out_of_range);
+  EXPECT_THROW(s.pop(), std::out_of_range);
+
+  s.push(1);
+  s.pop();
+  EXPECT_THROW(s.pop(), std::out_of_range);
+  EXPECT_TRUE(s.empty());
+}
+
 TEST(StackTest, Empty) {
   s21::stack<std::pair<std::string, int>> s;
   std::stack<std::pair<std::string, int>> s_stl;
@@ -1764,6 +3716,27 @@ TEST(StackTest, EmplaceFrontTest) {
   EXPECT_EQ(my_stack.top(), 4u);
 }
 
+TEST(StackTest, PmrStackTakesResource) {
+  std::pmr::monotonic_buffer_resource arena;
+  s21::pmr::stack<int> s(&arena);
+  for (int i = 0; i < 100; ++i) s.push(i);
+  EXPECT_EQ(s.top(), 99);
+  s.pop();
+  EXPECT_EQ(s.size(), 99U);
+}
+
+TEST(StackTest, SwapAndListBackedStack) {
+  s21::stack<int> a = {1, 2, 3};
+  s21::stack<int> b = {4};
+  a.swap(b);
+  EXPECT_EQ(a.top(), 4);
+  EXPECT_EQ(b.size(), 3U);
+
+  s21::stack<int, s21::list<int>> on_list = {1, 2};
+  on_list.push(3);
+  EXPECT_EQ(on_list.top(), 3);
+}
+
 //________________<<Stack<<__________________
 
 //_________________>>Queue>>_________________
@@ -1809,6 +3782,18 @@ TEST(QueueTest, EmptyInitializerListConstructor) {
   ASSERT_TRUE(q.empty());
 }
 
+TEST(QueueTest, EmptyPopFrontBackThrow) {
+  s21::queue<int> q;
+  EXPECT_THROW(q.front(), std::out_of_range);
+  EXPECT_THROW(q.back(), std::out_of_range);
+  EXPECT_THROW(q.pop(), std::out_of_range);
+
+  q.push(1);
+  q.pop();
+  EXPECT_THROW(q.pop(), std::out_of_range);
+  EXPECT_TRUE(q.empty());
+}
+
 TEST(QueueTest, CopyInitializerListConstructor) {
   s21::queue<unsigned int> q1{1, 2, 3};
   s21::queue<unsigned int> q2{q1};
@@ -2092,8 +4077,443 @@ TEST(ListTest, EraseOnEmptyListThrowsException) {
   EXPECT_THROW(empty_list.erase(empty_list.begin()), std::out_of_range);
 }
 
+TEST(QueueTest, PmrQueueTakesResource) {
+  CountingResource resource;
+  {
+    s21::pmr::queue<int> q(&resource);
+    for (int i = 0; i < 100; ++i) q.push(i);
+    EXPECT_EQ(q.front(), 0);
+    EXPECT_GT(resource.allocations, 0U);
+  }
+  EXPECT_EQ(resource.outstanding, 0U);
+}
+
+TEST(QueueTest, SwapAndListBackedQueue) {
+  s21::queue<int> a = {1, 2, 3};
+  s21::queue<int> b = {4};
+  a.swap(b);
+  EXPECT_EQ(a.front(), 4);
+  EXPECT_EQ(b.back(), 3);
+
+  s21::queue<int, s21::list<int>> on_list = {1, 2};
+  on_list.pop();
+  EXPECT_EQ(on_list.front(), 2);
+}
+
 //_______________<<Queue<<_____________________________________________
 
+//_________________>>SPSC>>___________________
+
+TEST(SpscQueueTest, PushFrontPop) {
+  s21::spsc_queue<std::string, 4> q;
+  EXPECT_TRUE(q.empty());
+  EXPECT_EQ(q.capacity(), 4U);
+  EXPECT_TRUE(q.push("a"));
+  EXPECT_TRUE(q.emplace(3, 'b'));
+  EXPECT_TRUE(q.push(std::string("c")));
+  EXPECT_TRUE(q.push("d"));
+  EXPECT_FALSE(q.push("e"));
+  EXPECT_EQ(q.size(), 4U);
+  EXPECT_EQ(q.front(), "a");
+  q.pop();
+  EXPECT_EQ(q.front(), "bbb");
+  EXPECT_TRUE(q.push("e"));
+  std::string out;
+  EXPECT_TRUE(q.try_pop(out));
+  EXPECT_EQ(out, "bbb");
+  EXPECT_EQ(q.size(), 3U);
+}
+
+TEST(SpscQueueTest, PushNPopNWrapAround) {
+  s21::spsc_queue<int, 8> q;
+  std::vector<int> in = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  std::vector<int> out(10, -1);
+  EXPECT_EQ(q.push_n(in.begin(), 6), 6U);
+  EXPECT_EQ(q.pop_n(out.begin(), 4), 4U);
+  // хвост переходит через конец буфера, влезает только 6 из 8
+  EXPECT_EQ(q.push_n(in.begin() + 2, 8), 6U);
+  EXPECT_EQ(q.size(), 8U);
+  EXPECT_EQ(q.pop_n(out.begin(), 10), 8U);
+  EXPECT_EQ(out, std::vector<int>({4, 5, 2, 3, 4, 5, 6, 7, -1, -1}));
+  EXPECT_TRUE(q.empty());
+  EXPECT_EQ(q.pop_n(out.begin(), 1), 0U);
+}
+
+TEST(SpscQueueTest, DestroysRemainingElements) {
+  auto shared = std::make_shared<int>(1);
+  {
+    s21::spsc_queue<std::shared_ptr<int>, 4> q;
+    q.push(shared);
+    q.push(shared);
+    EXPECT_EQ(shared.use_count(), 3);
+  }
+  EXPECT_EQ(shared.use_count(), 1);
+}
+
+TEST(SpscQueueTest, TwoThreadsPreserveOrder) {
+  const int count = 1000000;
+  auto q = std::make_unique<s21::spsc_queue<int, 1024>>();
+  std::thread producer([&] {
+    int batch[16];
+    for (int i = 0; i < count;) {
+      int pushed = 0;
+      if (i % 3 == 0) {
+        pushed = q->push(i) ? 1 : 0;
+      } else {
+        int n = std::min(16, count - i);
+        for (int k = 0; k < n; ++k) batch[k] = i + k;
+        pushed = static_cast<int>(q->push_n(batch, n));
+      }
+      if (pushed == 0) std::this_thread::yield();
+      i += pushed;
+    }
+  });
+  bool in_order = true;
+  int next = 0;
+  int batch[16];
+  while (next < count) {
+    int value;
+    if (next % 2 == 0 && q->try_pop(value)) {
+      in_order = in_order && value == next++;
+    } else {
+      size_t n = q->pop_n(batch, 16);
+      if (n == 0) std::this_thread::yield();
+      for (size_t k = 0; k < n; ++k) in_order = in_order && batch[k] == next++;
+    }
+  }
+  producer.join();
+  EXPECT_TRUE(in_order);
+  EXPECT_TRUE(q->empty());
+}
+
+//_________________<<SPSC<<___________________
+
+//_________________>>MPMC>>___________________
+
+TEST(MpmcQueueTest, TryPushTryPop) {
+  s21::mpmc_queue<std::string, 4> q;
+  EXPECT_TRUE(q.empty());
+  EXPECT_TRUE(q.try_push("a"));
+  EXPECT_TRUE(q.try_emplace(2, 'b'));
+  EXPECT_TRUE(q.try_push(std::string("c")));
+  EXPECT_TRUE(q.try_push("d"));
+  EXPECT_FALSE(q.try_push("e"));
+  EXPECT_EQ(q.size(), 4U);
+  std::string out;
+  EXPECT_TRUE(q.try_pop(out));
+  EXPECT_EQ(out, "a");
+  EXPECT_TRUE(q.try_pop(out));
+  EXPECT_EQ(out, "bb");
+  // второй круг по тем же ячейкам
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_TRUE(q.try_push(std::to_string(i)));
+    EXPECT_TRUE(q.try_pop(out));
+  }
+  EXPECT_EQ(out, "7");
+  EXPECT_EQ(q.size(), 2U);
+}
+
+TEST(MpmcQueueTest, FailedPushKeepsValue) {
+  s21::mpmc_queue<std::string, 2> q;
+  q.push("a");
+  q.push("b");
+  std::string value = "kept";
+  EXPECT_FALSE(q.try_push(std::move(value)));
+  EXPECT_EQ(value, "kept");
+  std::string out;
+  q.pop(out);
+  EXPECT_EQ(out, "a");
+  EXPECT_EQ(q.size(), 1U);
+}
+
+TEST(MpmcQueueTest, DestroysRemainingElements) {
+  auto shared = std::make_shared<int>(1);
+  {
+    s21::mpmc_queue<std::shared_ptr<int>, 4> q;
+    q.push(shared);
+    q.push(shared);
+    EXPECT_EQ(shared.use_count(), 3);
+  }
+  EXPECT_EQ(shared.use_count(), 1);
+}
+
+// Каждое значение должно быть прочитано ровно один раз, а значения одного
+// писателя - приходить к каждому читателю по возрастанию.
+TEST(MpmcQueueTest, StressManyProducersManyConsumers) {
+  const int producers = 4;
+  const int consumers = 4;
+  const int per_producer = 100000;
+  auto q = std::make_unique<s21::mpmc_queue<long, 64>>();
+  std::vector<std::atomic<int>> seen(producers * per_producer);
+  std::atomic<bool> ordered{true};
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; ++p) {
+    threads.emplace_back([&, p] {
+      for (int i = 0; i < per_producer; ++i) {
+        long value = static_cast<long>(p) * per_producer + i;
+        if (i % 2 == 0) {
+          q->push(value);
+        } else {
+          while (!q->try_push(value)) std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (int c = 0; c < consumers; ++c) {
+    threads.emplace_back([&] {
+      std::vector<long> last(producers, -1);
+      for (int i = 0; i < producers * per_producer / consumers; ++i) {
+        long value;
+        q->pop(value);
+        int producer = static_cast<int>(value / per_producer);
+        if (value <= last[producer]) ordered = false;
+        last[producer] = value;
+        seen[value].fetch_add(1, std::memory_order_relaxed);
+      }
+    });
+  }
+  for (std::thread &thread : threads) thread.join();
+  EXPECT_TRUE(ordered);
+  EXPECT_TRUE(q->empty());
+  EXPECT_TRUE(std::all_of(seen.begin(), seen.end(),
+                          [](const std::atomic<int> &n) { return n == 1; }));
+}
+
+//_________________<<MPMC<<___________________
+
+//______________>>WORK_STEALING>>______________
+
+TEST(WorkStealingDequeTest, OwnerIsLifoThiefIsFifo) {
+  s21::work_stealing_deque<int> d;
+  EXPECT_TRUE(d.empty());
+  for (int i = 0; i < 5; ++i) d.push(i);
+  EXPECT_EQ(d.size(), 5U);
+  int value = -1;
+  EXPECT_TRUE(d.try_pop(value));
+  EXPECT_EQ(value, 4);
+  EXPECT_TRUE(d.try_steal(value));
+  EXPECT_EQ(value, 0);
+  EXPECT_TRUE(d.try_steal(value));
+  EXPECT_EQ(value, 1);
+  EXPECT_TRUE(d.try_pop(value));
+  EXPECT_EQ(value, 3);
+  EXPECT_TRUE(d.try_pop(value));
+  EXPECT_EQ(value, 2);
+  EXPECT_FALSE(d.try_pop(value));
+  EXPECT_FALSE(d.try_steal(value));
+}
+
+TEST(WorkStealingDequeTest, GrowsKeepingOrder) {
+  s21::work_stealing_deque<long> d(4);
+  EXPECT_EQ(d.capacity(), 4U);
+  long value;
+  // сдвигаем индексы, чтобы рост копировал через конец буфера
+  for (long i = 0; i < 3; ++i) d.push(i);
+  for (long i = 0; i < 3; ++i) EXPECT_TRUE(d.try_steal(value));
+  for (long i = 0; i < 100; ++i) d.push(i);
+  EXPECT_EQ(d.capacity(), 128U);
+  for (long i = 0; i < 50; ++i) {
+    EXPECT_TRUE(d.try_steal(value));
+    EXPECT_EQ(value, i);
+  }
+  for (long i = 99; i >= 50; --i) {
+    EXPECT_TRUE(d.try_pop(value));
+    EXPECT_EQ(value, i);
+  }
+  EXPECT_TRUE(d.empty());
+}
+
+// Владелец кладет и забирает, три вора крадут; каждое значение должно
+// достаться ровно одному потоку.
+TEST(WorkStealingDequeTest, ConcurrentStealTakesEachValueOnce) {
+  const int count = 200000;
+  s21::work_stealing_deque<int> d(8);
+  std::vector<std::atomic<int>> taken(count);
+  std::atomic<bool> done{false};
+  std::vector<std::thread> thieves;
+  for (int t = 0; t < 3; ++t) {
+    thieves.emplace_back([&] {
+      int value;
+      while (!done.load() || !d.empty()) {
+        if (d.try_steal(value))
+          taken[value].fetch_add(1);
+        else
+          std::this_thread::yield();
+      }
+    });
+  }
+  int value;
+  for (int i = 0; i < count; ++i) {
+    d.push(i);
+    if (i % 3 == 0 && d.try_pop(value)) taken[value].fetch_add(1);
+  }
+  while (d.try_pop(value)) taken[value].fetch_add(1);
+  done = true;
+  for (std::thread &thief : thieves) thief.join();
+  EXPECT_TRUE(std::all_of(taken.begin(), taken.end(),
+                          [](const std::atomic<int> &n) { return n == 1; }));
+}
+
+TEST(ThreadPoolTest, ParallelForCoversVectorOnce) {
+  s21::thread_pool pool(3);
+  EXPECT_EQ(pool.size(), 3U);
+  s21::vector<int> v(100000);
+  for (int round = 1; round <= 3; ++round) {
+    pool.parallel_for(v.begin(), v.end(), [](int *first, int *last) {
+      for (; first != last; ++first) ++*first;
+    });
+    EXPECT_TRUE(std::all_of(v.begin(), v.end(),
+                            [round](int x) { return x == round; }));
+  }
+}
+
+TEST(ThreadPoolTest, UnevenWorkAndGrain) {
+  s21::thread_pool pool(2);
+  s21::vector<long> v(2000);
+  for (size_t i = 0; i < v.size(); ++i) v[i] = static_cast<long>(i);
+  std::atomic<long> sum{0};
+  std::atomic<int> calls{0};
+  pool.parallel_for(
+      v.begin(), v.end(),
+      [&](long *first, long *last) {
+        ++calls;
+        long local = 0;
+        for (; first != last; ++first)
+          for (long k = 0; k <= *first % 64; ++k) local += *first;
+        sum += local;
+      },
+      7);
+  long expected = 0;
+  for (long x : v) expected += x * (x % 64 + 1);
+  EXPECT_EQ(sum.load(), expected);
+  EXPECT_EQ(calls.load(), (2000 + 6) / 7);
+}
+
+TEST(ThreadPoolTest, WithoutWorkersRunsOnCaller) {
+  s21::thread_pool pool(0);
+  s21::vector<int> v = {1, 2, 3, 4, 5};
+  std::thread::id caller = std::this_thread::get_id();
+  bool same_thread = true;
+  int sum = 0;
+  pool.parallel_for(v.begin(), v.end(), [&](int *first, int *last) {
+    same_thread = same_thread && std::this_thread::get_id() == caller;
+    for (; first != last; ++first) sum += *first;
+  });
+  EXPECT_TRUE(same_thread);
+  EXPECT_EQ(sum, 15);
+  pool.parallel_for(v.begin(), v.begin(), [&](int *, int *) { sum = 0; });
+  EXPECT_EQ(sum, 15);
+}
+
+TEST(ThreadPoolTest, RethrowsBodyException) {
+  s21::thread_pool pool(2);
+  s21::vector<int> v(1000);
+  std::atomic<int> done{0};
+  EXPECT_THROW(pool.parallel_for(
+                   v.begin(), v.end(),
+                   [&](int *first, int *) {
+                     if (first == v.begin() + 500)
+                       throw std::runtime_error("chunk");
+                     ++done;
+                   },
+                   100),
+               std::runtime_error);
+  EXPECT_EQ(done.load(), 9);
+  // пул остается рабочим
+  pool.parallel_for(v.begin(), v.end(), [&](int *, int *) { ++done; }, 100);
+  EXPECT_EQ(done.load(), 19);
+}
+
+//______________<<WORK_STEALING<<______________
+
+//______________>>CONCURRENT_STACK>>__________
+
+TEST(ConcurrentStackTest, PushPopTop) {
+  s21::concurrent_stack<std::string> s;
+  EXPECT_TRUE(s.empty());
+  EXPECT_THROW(s.top(), std::out_of_range);
+  EXPECT_THROW(s.pop(), std::out_of_range);
+  s.push("a");
+  s.emplace(2, 'b');
+  s.push(std::string("c"));
+  EXPECT_FALSE(s.empty());
+  EXPECT_EQ(s.top(), "c");
+  s.pop();
+  std::string out;
+  EXPECT_TRUE(s.try_pop(out));
+  EXPECT_EQ(out, "bb");
+  EXPECT_TRUE(s.try_pop(out));
+  EXPECT_EQ(out, "a");
+  EXPECT_FALSE(s.try_pop(out));
+  EXPECT_TRUE(s.empty());
+}
+
+TEST(ConcurrentStackTest, MoveOnlyValues) {
+  s21::concurrent_stack<std::unique_ptr<int>> s;
+  s.push(std::make_unique<int>(7));
+  std::unique_ptr<int> out;
+  EXPECT_TRUE(s.try_pop(out));
+  EXPECT_EQ(*out, 7);
+}
+
+TEST(ConcurrentStackTest, DestroysAllNodes) {
+  auto shared = std::make_shared<int>(1);
+  {
+    s21::concurrent_stack<std::shared_ptr<int>> s;
+    for (int i = 0; i < 10; ++i) s.push(shared);
+    std::shared_ptr<int> out;
+    for (int i = 0; i < 5; ++i) s.try_pop(out);
+    out.reset();
+    EXPECT_GT(shared.use_count(), 5);
+  }
+  // и оставшиеся, и снятые, но еще не освобожденные узлы
+  EXPECT_EQ(shared.use_count(), 1);
+}
+
+// Потоки кладут свои значения и снимают чужие; каждое значение должно
+// быть снято ровно один раз, а top не должен читать освобожденные узлы.
+TEST(ConcurrentStackTest, StressPushPopTop) {
+  const int threads = 4;
+  const int per_thread = 50000;
+  s21::concurrent_stack<long> s;
+  std::vector<std::atomic<int>> taken(threads * per_thread);
+  std::atomic<int> popped{0};
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t] {
+      long value;
+      for (int i = 0; i < per_thread; ++i) {
+        s.push(static_cast<long>(t) * per_thread + i);
+        if (i % 2 == 1) {
+          for (int k = 0; k < 2; ++k) {
+            if (s.try_pop(value)) {
+              taken[value].fetch_add(1);
+              ++popped;
+            }
+          }
+        }
+        if (i % 64 == 0) {
+          try {
+            EXPECT_LT(s.top(), threads * per_thread);
+          } catch (const std::out_of_range &) {
+          }
+        }
+      }
+    });
+  }
+  for (std::thread &worker : workers) worker.join();
+  long value;
+  while (s.try_pop(value)) {
+    taken[value].fetch_add(1);
+    ++popped;
+  }
+  EXPECT_EQ(popped.load(), threads * per_thread);
+  EXPECT_TRUE(std::all_of(taken.begin(), taken.end(),
+                          [](const std::atomic<int> &n) { return n == 1; }));
+}
+
+//______________<<CONCURRENT_STACK<<__________
+
 int main(int argc, char *argv[]) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -2,6 +2,17 @@
 #define S21_CONTAINERS_SRC_S21_CONTAINERSPLUS_H_
 
 #include "s21_array.h"
+#include "s21_btree_map.h"
+#include "s21_btree_set.h"
+#include "s21_concurrent_stack.h"
+#include "s21_flat_map.h"
+#include "s21_flat_set.h"
+#include "s21_mpmc_queue.h"
 #include "s21_multiset.h"
+#include "s21_spsc_queue.h"
+#include "s21_thread_pool.h"
+#include "s21_unordered_map.h"
+#include "s21_unordered_set.h"
+#include "s21_work_stealing_deque.h"
 
 #endif  // S21_CONTAINERS_SRC_S21_CONTAINERSPLUS_H_
\ No newline at end of file
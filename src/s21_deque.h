@@ -0,0 +1,499 @@
+#ifndef S21_CONTAINERS_SRC_S21_DEQUE_H_
+#define S21_CONTAINERS_SRC_S21_DEQUE_H_
+
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "s21_vector.h"
+
+namespace s21 {
+
+// Двусторонняя очередь на кольцевом буфере. Емкость - степень двойки,
+// поэтому позиция в буфере получается маской, а не делением. Элементы
+// [head_, head_ + size_) лежат по модулю емкости не больше чем в двух
+// непрерывных отрезках (array_one/array_two). Вставка и удаление с обоих
+// концов - амортизированно O(1), память выделяется только при росте.
+template <class T, class Allocator = std::allocator<T>>
+class deque {
+ private:
+  using alloc_traits = std::allocator_traits<Allocator>;
+
+ public:
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using allocator_type = Allocator;
+
+  // Итератор хранит номер ячейки без маски: head_ + индекс элемента.
+  // Сравнение и разность - над этими номерами, маска нужна только при
+  // разыменовании.
+  template <typename Reference, typename Pointer>
+  class Iterator {
+   public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using reference = Reference;
+    using pointer = Pointer;
+
+    inline Iterator() noexcept : buf_(nullptr), mask_(0), pos_(0) {}
+
+    // iterator -> const_iterator
+    template <typename OtherReference, typename OtherPointer,
+              std::enable_if_t<std::is_convertible_v<OtherPointer, Pointer>,
+                               int> = 0>
+    inline Iterator(
+        const Iterator<OtherReference, OtherPointer> &other) noexcept
+        : buf_(other.buf_), mask_(other.mask_), pos_(other.pos_) {}
+
+    inline Reference operator*() const noexcept { return buf_[pos_ & mask_]; }
+    inline Pointer operator->() const noexcept { return buf_ + (pos_ & mask_); }
+    inline Reference operator[](difference_type n) const noexcept {
+      return buf_[(pos_ + n) & mask_];
+    }
+
+    inline Iterator &operator++() noexcept {
+      ++pos_;
+      return *this;
+    }
+    inline Iterator operator++(int) noexcept {
+      Iterator temp = *this;
+      ++pos_;
+      return temp;
+    }
+    inline Iterator &operator--() noexcept {
+      --pos_;
+      return *this;
+    }
+    inline Iterator operator--(int) noexcept {
+      Iterator temp = *this;
+      --pos_;
+      return temp;
+    }
+
+    inline Iterator &operator+=(difference_type n) noexcept {
+      pos_ += n;
+      return *this;
+    }
+    inline Iterator &operator-=(difference_type n) noexcept {
+      pos_ -= n;
+      return *this;
+    }
+    inline Iterator operator+(difference_type n) const noexcept {
+      return Iterator(*this) += n;
+    }
+    friend inline Iterator operator+(difference_type n,
+                                     const Iterator &it) noexcept {
+      return it + n;
+    }
+    inline Iterator operator-(difference_type n) const noexcept {
+      return Iterator(*this) -= n;
+    }
+    inline difference_type operator-(const Iterator &other) const noexcept {
+      return static_cast<difference_type>(pos_ - other.pos_);
+    }
+
+    inline bool operator==(const Iterator &other) const noexcept {
+      return pos_ == other.pos_;
+    }
+    inline bool operator!=(const Iterator &other) const noexcept {
+      return pos_ != other.pos_;
+    }
+    inline bool operator<(const Iterator &other) const noexcept {
+      return pos_ < other.pos_;
+    }
+    inline bool operator>(const Iterator &other) const noexcept {
+      return pos_ > other.pos_;
+    }
+    inline bool operator<=(const Iterator &other) const noexcept {
+      return pos_ <= other.pos_;
+    }
+    inline bool operator>=(const Iterator &other) const noexcept {
+      return pos_ >= other.pos_;
+    }
+
+   private:
+    inline Iterator(T *buf, size_type mask, size_type pos) noexcept
+        : buf_(buf), mask_(mask), pos_(pos) {}
+
+    T *buf_;
+    size_type mask_;
+    size_type pos_;
+
+    template <typename, typename>
+    friend class Iterator;
+    friend class deque;
+  };
+
+  using iterator = Iterator<T &, T *>;
+  using const_iterator = Iterator<const T &, const T *>;
+
+  deque() noexcept(noexcept(Allocator())) : deque(Allocator()) {}
+
+  explicit deque(const Allocator &alloc) noexcept
+      : buf_(nullptr), capacity_(0), head_(0), size_(0), alloc_(alloc) {}
+
+  explicit deque(size_type n, const Allocator &alloc = Allocator())
+      : deque(alloc) {
+    reserve(n);
+    for (; size_ < n; ++size_) new (buf_ + size_) value_type();
+  }
+
+  deque(std::initializer_list<value_type> const &items,
+        const Allocator &alloc = Allocator())
+      : deque(alloc) {
+    reserve(items.size());
+    for (const value_type &item : items) new (buf_ + size_++) value_type(item);
+  }
+
+  deque(const deque &other)
+      : deque(other,
+              alloc_traits::select_on_container_copy_construction(
+                  other.alloc_)) {}
+
+  deque(const deque &other, const Allocator &alloc) : deque(alloc) {
+    reserve(other.size_);
+    for (const value_type &item : other) new (buf_ + size_++) value_type(item);
+  }
+
+  deque(deque &&other) noexcept
+      : buf_(other.buf_),
+        capacity_(other.capacity_),
+        head_(other.head_),
+        size_(other.size_),
+        alloc_(std::move(other.alloc_)) {
+    other.buf_ = nullptr;
+    other.capacity_ = 0;
+    other.head_ = 0;
+    other.size_ = 0;
+  }
+
+  ~deque() { release(); }
+
+  deque &operator=(const deque &other) {
+    if (&other != this) {
+      // аллокатор выбирается заранее в локальную переменную: с выражением
+      // прямо в аргументе GCC -O2 ошибочно считает пустой std::allocator
+      // неинициализированным (-Wmaybe-uninitialized)
+      const Allocator alloc =
+          alloc_traits::propagate_on_container_copy_assignment::value
+              ? other.alloc_
+              : alloc_;
+      deque copy(other, alloc);
+      swapStorage(copy);
+      if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+        std::swap(alloc_, copy.alloc_);
+    }
+    return *this;
+  }
+
+  deque &operator=(deque &&other) noexcept(
+      alloc_traits::propagate_on_container_move_assignment::value ||
+      alloc_traits::is_always_equal::value) {
+    if (&other == this) return *this;
+    if (alloc_traits::propagate_on_container_move_assignment::value ||
+        alloc_ == other.alloc_) {
+      deque empty(alloc_);
+      swapStorage(empty);
+      swapStorage(other);
+      if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+        alloc_ = std::move(other.alloc_);
+    } else {
+      // ресурс остается прежним (как у std::pmr), элементы переносятся
+      // по одному в собственный буфер
+      deque moved(alloc_);
+      moved.reserve(other.size_);
+      for (value_type &item : other)
+        new (moved.buf_ + moved.size_++) value_type(std::move(item));
+      swapStorage(moved);
+      other.clear();
+    }
+    return *this;
+  }
+
+  inline allocator_type get_allocator() const noexcept { return alloc_; }
+
+  inline reference at(size_type pos) {
+    if (pos >= size_) throw std::out_of_range("deque::at");
+    return (*this)[pos];
+  }
+  inline const_reference at(size_type pos) const {
+    if (pos >= size_) throw std::out_of_range("deque::at");
+    return (*this)[pos];
+  }
+  inline reference operator[](size_type pos) noexcept {
+    return buf_[slot(head_ + pos)];
+  }
+  inline const_reference operator[](size_type pos) const noexcept {
+    return buf_[slot(head_ + pos)];
+  }
+  // front, back и pop_* на пустой очереди бросают std::out_of_range, как у
+  // s21::list, чтобы stack и queue сохраняли проверку на пустоту
+  inline reference front() {
+    checkNotEmpty();
+    return buf_[head_];
+  }
+  inline const_reference front() const {
+    checkNotEmpty();
+    return buf_[head_];
+  }
+  inline reference back() {
+    checkNotEmpty();
+    return buf_[slot(head_ + size_ - 1)];
+  }
+  inline const_reference back() const {
+    checkNotEmpty();
+    return buf_[slot(head_ + size_ - 1)];
+  }
+
+  // элементы в виде не более чем двух непрерывных отрезков: array_one()
+  // начинается с front(), array_two() - часть, завернувшая в начало
+  // буфера; пуст, если заворота нет
+  inline std::pair<T *, size_type> array_one() noexcept {
+    return {buf_ + head_, firstRun()};
+  }
+  inline std::pair<const T *, size_type> array_one() const noexcept {
+    return {buf_ + head_, firstRun()};
+  }
+  inline std::pair<T *, size_type> array_two() noexcept {
+    return {buf_, size_ - firstRun()};
+  }
+  inline std::pair<const T *, size_type> array_two() const noexcept {
+    return {buf_, size_ - firstRun()};
+  }
+
+  inline iterator begin() noexcept { return iterator(buf_, mask(), head_); }
+  inline iterator end() noexcept {
+    return iterator(buf_, mask(), head_ + size_);
+  }
+  inline const_iterator begin() const noexcept {
+    return const_iterator(buf_, mask(), head_);
+  }
+  inline const_iterator end() const noexcept {
+    return const_iterator(buf_, mask(), head_ + size_);
+  }
+  inline const_iterator cbegin() const noexcept { return begin(); }
+  inline const_iterator cend() const noexcept { return end(); }
+
+  inline bool empty() const noexcept { return size_ == 0; }
+  inline size_type size() const noexcept { return size_; }
+  inline size_type max_size() const noexcept {
+    return (std::numeric_limits<size_type>::max() / 2 + 1) / sizeof(T);
+  }
+  inline size_type capacity() const noexcept { return capacity_; }
+
+  // rounds n up to a power of two; never shrinks
+  void reserve(size_type n) {
+    if (n > max_size()) throw std::length_error("deque::reserve");
+    if (n > capacity_) reallocate(roundUp(n));
+  }
+
+  void shrink_to_fit() {
+    size_type fit = size_ == 0 ? 0 : roundUp(size_);
+    if (fit < capacity_) reallocate(fit);
+  }
+
+  void clear() noexcept {
+    destroyAll();
+    head_ = 0;
+    size_ = 0;
+  }
+
+  inline void push_back(const_reference value) { emplace_back(value); }
+  inline void push_back(value_type &&value) {
+    emplace_back(std::move(value));
+  }
+  inline void push_front(const_reference value) { emplace_front(value); }
+  inline void push_front(value_type &&value) {
+    emplace_front(std::move(value));
+  }
+
+  template <typename... Args>
+  reference emplace_back(Args &&...args) {
+    if (size_ == capacity_) {
+      // аргументы могут ссылаться на элемент этой же очереди, поэтому
+      // значение строится до переноса
+      value_type value(std::forward<Args>(args)...);
+      grow();  // после переноса голова в нулевой ячейке
+      new (buf_ + size_) value_type(std::move(value));
+      return buf_[size_++];
+    }
+    T *place = buf_ + slot(head_ + size_);
+    new (place) value_type(std::forward<Args>(args)...);
+    ++size_;
+    return *place;
+  }
+
+  template <typename... Args>
+  reference emplace_front(Args &&...args) {
+    if (size_ == capacity_) {
+      value_type value(std::forward<Args>(args)...);
+      grow();
+      head_ = capacity_ - 1;
+      new (buf_ + head_) value_type(std::move(value));
+      ++size_;
+      return buf_[head_];
+    }
+    size_type place = slot(head_ + capacity_ - 1);
+    new (buf_ + place) value_type(std::forward<Args>(args)...);
+    head_ = place;
+    ++size_;
+    return buf_[head_];
+  }
+
+  inline void pop_back() {
+    checkNotEmpty();
+    --size_;
+    buf_[slot(head_ + size_)].~value_type();
+  }
+
+  inline void pop_front() {
+    checkNotEmpty();
+    buf_[head_].~value_type();
+    head_ = slot(head_ + 1);
+    --size_;
+  }
+
+  // swap the contents; allocators that do not propagate must be equal
+  void swap(deque &other) noexcept {
+    swapStorage(other);
+    if constexpr (alloc_traits::propagate_on_container_swap::value)
+      std::swap(alloc_, other.alloc_);
+  }
+
+  template <typename... Args>
+  void insert_many_back(Args &&...args) {
+    (emplace_back(std::forward<Args>(args)), ...);
+  }
+
+  template <typename... Args>
+  void insert_many_front(Args &&...args) {
+    (emplace_front(std::forward<Args>(args)), ...);
+  }
+
+ private:
+  static constexpr bool kRelocatable = is_trivially_relocatable_v<T>;
+
+  T *buf_;
+  size_type capacity_;
+  size_type head_;
+  size_type size_;
+  Allocator alloc_;
+
+  inline void checkNotEmpty() const {
+    if (size_ == 0) throwEmpty();
+  }
+  // бросание вынесено из встраиваемых методов, как и рост в grow()
+  [[noreturn]] static void throwEmpty() {
+    throw std::out_of_range("the deque is empty");
+  }
+
+  inline size_type mask() const noexcept { return capacity_ - 1; }
+  inline size_type slot(size_type pos) const noexcept {
+    return pos & (capacity_ - 1);
+  }
+  inline size_type firstRun() const noexcept {
+    return capacity_ - head_ < size_ ? capacity_ - head_ : size_;
+  }
+
+  static size_type roundUp(size_type n) noexcept {
+    size_type capacity = 1;
+    while (capacity < n) capacity <<= 1;
+    return capacity;
+  }
+
+  void swapStorage(deque &other) noexcept {
+    std::swap(buf_, other.buf_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(head_, other.head_);
+    std::swap(size_, other.size_);
+  }
+
+  void destroyAll() noexcept {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      std::pair<T *, size_type> one = array_one();
+      std::pair<T *, size_type> two = array_two();
+      std::destroy(one.first, one.first + one.second);
+      std::destroy(two.first, two.first + two.second);
+    }
+  }
+
+  void release() noexcept {
+    destroyAll();
+    if (buf_ != nullptr) alloc_traits::deallocate(alloc_, buf_, capacity_);
+  }
+
+  // Переносит оба отрезка в начало buff, сохраняя порядок. Источники
+  // разрушаются только после того, как все копии построены.
+  void relocateTo(T *buff) {
+    std::pair<T *, size_type> one = array_one();
+    std::pair<T *, size_type> two = array_two();
+    if constexpr (kRelocatable) {
+      if (one.second != 0)
+        std::memcpy(static_cast<void *>(buff), one.first,
+                    one.second * sizeof(T));
+      if (two.second != 0)
+        std::memcpy(static_cast<void *>(buff + one.second), two.first,
+                    two.second * sizeof(T));
+    } else {
+      T *middle = moveOrCopy(one.first, one.first + one.second, buff);
+      try {
+        moveOrCopy(two.first, two.first + two.second, middle);
+      } catch (...) {
+        std::destroy(buff, middle);
+        throw;
+      }
+      destroyAll();
+    }
+  }
+
+  static T *moveOrCopy(T *first, T *last, T *dest) {
+    if constexpr (std::is_nothrow_move_constructible_v<T> ||
+                  !std::is_copy_constructible_v<T>)
+      return std::uninitialized_move(first, last, dest);
+    else
+      return std::uninitialized_copy(first, last, dest);
+  }
+
+  void reallocate(size_type new_capacity) {
+    T *buff = new_capacity == 0
+                  ? nullptr
+                  : alloc_traits::allocate(alloc_, new_capacity);
+    try {
+      relocateTo(buff);
+    } catch (...) {
+      alloc_traits::deallocate(alloc_, buff, new_capacity);
+      throw;
+    }
+    if (buf_ != nullptr) alloc_traits::deallocate(alloc_, buf_, capacity_);
+    buf_ = buff;
+    capacity_ = new_capacity;
+    head_ = 0;
+  }
+
+  // геометрический рост; медленный путь вынесен из emplace_back и
+  // emplace_front, чтобы быстрый путь оставался маленьким и встраивался
+  void grow() {
+    if (capacity_ >= max_size()) throw std::length_error("deque");
+    reallocate(capacity_ == 0 ? 8 : capacity_ * 2);
+  }
+};
+
+namespace pmr {
+template <class T>
+using deque = s21::deque<T, std::pmr::polymorphic_allocator<T>>;
+}  // namespace pmr
+}  // namespace s21
+
+#endif  // S21_CONTAINERS_SRC_S21_DEQUE_H_
@@ -0,0 +1,283 @@
+#ifndef S21_CONTAINERS_SRC_S21_FLAT_MAP_H_
+#define S21_CONTAINERS_SRC_S21_FLAT_MAP_H_
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+
+#include "s21_flat_tree.h"
+
+namespace s21 {
+
+// Словарь на отсортированном s21::vector с интерфейсом map. Пары лежат
+// подряд, поэтому поиск - двоичный по непрерывной памяти. Вставка и
+// удаление сдвигают пары присваиванием, а у pair<const Key, T> его нет,
+// поэтому хранится std::pair<Key, T>. Чтобы ключ нельзя было испортить
+// через итератор, тот, как в std::flat_map, отдает не ссылку на пару, а
+// пару ссылок pair<const Key &, T &>.
+template <typename Key, typename T>
+class flat_map {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<Key, T>;
+  using reference = std::pair<const Key &, T &>;
+  using const_reference = std::pair<const Key &, const T &>;
+  using size_type = size_t;
+
+ private:
+  using tree_type = flat_tree<Key, value_type, pair_first_key<value_type>>;
+
+  // Итератор произвольного доступа поверх итератора массива; operator->
+  // возвращает временную пару ссылок.
+  template <bool Const>
+  class MapIterator {
+   public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = flat_map::value_type;
+    using difference_type = std::ptrdiff_t;
+    using reference =
+        std::conditional_t<Const, flat_map::const_reference, flat_map::reference>;
+
+    struct pointer {
+      reference pair;
+      inline const reference *operator->() const noexcept { return &pair; }
+    };
+
+    MapIterator() noexcept = default;
+    explicit MapIterator(flat_map::value_type *item) noexcept : item_(item) {}
+    // iterator -> const_iterator
+    template <bool Other, typename = std::enable_if_t<Const && !Other>>
+    MapIterator(const MapIterator<Other> &other) noexcept
+        : item_(other.base()) {}
+
+    inline flat_map::value_type *base() const noexcept { return item_; }
+
+    inline reference operator*() const noexcept {
+      return reference(item_->first, item_->second);
+    }
+    inline pointer operator->() const noexcept { return pointer{**this}; }
+    inline reference operator[](difference_type n) const noexcept {
+      return *(*this + n);
+    }
+
+    inline MapIterator &operator++() noexcept {
+      ++item_;
+      return *this;
+    }
+    inline MapIterator operator++(int) noexcept { return MapIterator(item_++); }
+    inline MapIterator &operator--() noexcept {
+      --item_;
+      return *this;
+    }
+    inline MapIterator operator--(int) noexcept { return MapIterator(item_--); }
+    inline MapIterator &operator+=(difference_type n) noexcept {
+      item_ += n;
+      return *this;
+    }
+    inline MapIterator &operator-=(difference_type n) noexcept {
+      item_ -= n;
+      return *this;
+    }
+    inline MapIterator operator+(difference_type n) const noexcept {
+      return MapIterator(item_ + n);
+    }
+    friend inline MapIterator operator+(difference_type n,
+                                        MapIterator it) noexcept {
+      return it + n;
+    }
+    inline MapIterator operator-(difference_type n) const noexcept {
+      return MapIterator(item_ - n);
+    }
+    inline difference_type operator-(MapIterator other) const noexcept {
+      return item_ - other.item_;
+    }
+
+    inline bool operator==(MapIterator other) const noexcept {
+      return item_ == other.item_;
+    }
+    inline bool operator!=(MapIterator other) const noexcept {
+      return item_ != other.item_;
+    }
+    inline bool operator<(MapIterator other) const noexcept {
+      return item_ < other.item_;
+    }
+    inline bool operator>(MapIterator other) const noexcept {
+      return item_ > other.item_;
+    }
+    inline bool operator<=(MapIterator other) const noexcept {
+      return item_ <= other.item_;
+    }
+    inline bool operator>=(MapIterator other) const noexcept {
+      return item_ >= other.item_;
+    }
+
+   private:
+    flat_map::value_type *item_ = nullptr;
+  };
+
+ public:
+  using iterator = MapIterator<false>;
+  using const_iterator = MapIterator<true>;
+
+  // default constructor, creates empty map
+  flat_map() noexcept {}
+  // initializer list constructor; on duplicate keys the first one wins
+  flat_map(std::initializer_list<value_type> const &items)
+      : tree_(items.begin(), items.end()) {}
+  // bulk construction from unsorted input: sort + dedupe
+  template <typename InputIt>
+  flat_map(InputIt first, InputIt last) : tree_(first, last) {}
+  // copy constructor
+  flat_map(const flat_map &other) = default;
+  // move constructor
+  flat_map(flat_map &&other) noexcept : flat_map() { swap(other); }
+  // destructor
+  ~flat_map() {}
+
+  flat_map &operator=(const flat_map &other) = default;
+  // assignment operator overload for moving object
+  flat_map &operator=(flat_map &&other) noexcept {
+    flat_map tmp(std::move(other));
+    swap(tmp);
+    return *this;
+  }
+
+  // access specified element with bounds checking
+  T &at(const Key &key) const {
+    auto it = tree_.find(key);
+    if (it == tree_.end()) throw std::out_of_range("Key not found");
+
+    return it->second;
+  }
+
+  // access or insert specified element
+  inline T &operator[](const Key &key) {
+    return try_emplace(key).first->second;
+  }
+
+  inline T &operator[](Key &&key) {
+    return try_emplace(std::move(key)).first->second;
+  }
+
+  // returns an iterator to the beginning
+  inline iterator begin() const noexcept { return iterator(tree_.begin()); }
+  // returns an iterator to the end
+  inline iterator end() const noexcept { return iterator(tree_.end()); }
+
+  // checks whether the container is empty
+  inline bool empty() const noexcept { return tree_.empty(); }
+  // returns the number of elements
+  inline size_t size() const noexcept { return tree_.size(); }
+  // returns the maximum possible number of elements
+  inline size_t max_size() const { return tree_.max_size(); }
+  // reserves storage for n elements
+  inline void reserve(size_type n) { tree_.reserve(n); }
+
+  // clears the contents
+  inline void clear() { tree_.clear(); }
+
+  // inserts value and returns iterator to where the element is in the
+  // container and bool denoting whether the insertion took place
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return wrap(tree_.insert(value));
+  }
+
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return wrap(tree_.insert(std::move(value)));
+  }
+
+  // inserts value by key
+  std::pair<iterator, bool> insert(const Key &key, const T &obj) {
+    return try_emplace(key, obj);
+  }
+
+  // inserts a range; sorts the new elements once and merges them in
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last) {
+    tree_.insert(first, last);
+  }
+
+  // inserts an element or assigns to the current element if the key already
+  // exists
+  std::pair<iterator, bool> insert_or_assign(const Key &key, const T &obj) {
+    auto result = try_emplace(key, obj);
+    if (!result.second) result.first->second = obj;
+
+    return result;
+  }
+
+  // constructs the element and inserts it if the key is not present
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    return wrap(tree_.emplace(std::forward<Args>(args)...));
+  }
+
+  // constructs the mapped value from args only if key is not present yet
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key &key, Args &&...args) {
+    return wrap(tree_.try_emplace(
+        key, std::piecewise_construct, std::forward_as_tuple(key),
+        std::forward_as_tuple(std::forward<Args>(args)...)));
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(Key &&key, Args &&...args) {
+    return wrap(tree_.try_emplace(
+        key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+        std::forward_as_tuple(std::forward<Args>(args)...)));
+  }
+
+  // erases element at pos
+  iterator erase(iterator pos) { return iterator(tree_.erase(pos.base())); }
+  // erases element by key
+  size_type erase(const Key &key) { return tree_.erase(key); }
+
+  // swaps the contents
+  inline void swap(flat_map &other) noexcept { tree_.swap(other.tree_); }
+
+  // moves elements of other whose keys are not present here; the rest
+  // stay in other, as with map::merge
+  void merge(flat_map &other) {
+    if (this != &other) tree_.merge(other.tree_);
+  }
+
+  iterator find(const Key &key) const { return iterator(tree_.find(key)); }
+
+  size_type count(const Key &key) const { return tree_.count(key); }
+
+  bool contains(const Key &key) const { return tree_.contains(key); }
+
+  iterator lower_bound(const Key &key) const {
+    return iterator(tree_.lower_bound(key));
+  }
+
+  iterator upper_bound(const Key &key) const {
+    return iterator(tree_.upper_bound(key));
+  }
+
+  std::pair<iterator, iterator> equal_range(const Key &key) const {
+    return {lower_bound(key), upper_bound(key)};
+  }
+
+ private:
+  static inline std::pair<iterator, bool> wrap(
+      std::pair<typename tree_type::iterator, bool> result) noexcept {
+    return {iterator(result.first), result.second};
+  }
+
+  tree_type tree_;
+};
+
+template <typename Key, typename T, typename... Args>
+inline void insert_many(flat_map<Key, T> &myMap, Args &&...args) {
+  (myMap.emplace(std::forward<Args>(args)), ...);
+}
+
+}  // namespace s21
+
+#endif  //  S21_CONTAINERS_SRC_S21_FLAT_MAP_H_
@@ -0,0 +1,123 @@
+#ifndef S21_CONTAINERS_SRC_S21_FLAT_SET_H_
+#define S21_CONTAINERS_SRC_S21_FLAT_SET_H_
+
+#include <initializer_list>
+#include <limits>
+
+#include "s21_flat_tree.h"
+
+namespace s21 {
+
+// Множество на отсортированном s21::vector: тот же интерфейс, что у set,
+// но поиск идет двоичным поиском по непрерывному массиву. Вставка и
+// удаление сдвигают хвост массива и делают итераторы недействительными.
+template <class Key>
+class flat_set {
+ private:
+  using tree_type = flat_tree<Key, Key, identity_key<Key>>;
+
+  tree_type tree_;
+
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+
+  // ключи нельзя менять на месте, поэтому оба итератора константные
+  using iterator = typename tree_type::const_iterator;
+  using const_iterator = typename tree_type::const_iterator;
+
+  flat_set() noexcept {}
+
+  flat_set(std::initializer_list<value_type> const &items)
+      : tree_(items.begin(), items.end()) {}
+
+  // bulk construction from unsorted input: sort + dedupe
+  template <typename InputIt>
+  flat_set(InputIt first, InputIt last) : tree_(first, last) {}
+
+  flat_set(const flat_set &s) = default;
+
+  flat_set(flat_set &&s) noexcept : flat_set() { swap(s); }
+
+  ~flat_set() {}
+
+  flat_set &operator=(const flat_set &s) = default;
+
+  flat_set &operator=(flat_set &&s) noexcept {
+    swap(s);
+    return *this;
+  }
+
+  inline iterator begin() const noexcept { return tree_.begin(); }
+
+  inline iterator end() const noexcept { return tree_.end(); }
+
+  inline bool empty() const noexcept { return tree_.empty(); }
+
+  inline size_type size() const noexcept { return tree_.size(); }
+
+  inline size_type max_size() const { return std::numeric_limits<int>::max(); }
+
+  inline void reserve(size_type n) { tree_.reserve(n); }
+
+  inline void clear() { tree_.clear(); }
+
+  inline std::pair<iterator, bool> insert(const value_type &value) {
+    return tree_.insert(value);
+  }
+
+  inline std::pair<iterator, bool> insert(value_type &&value) {
+    return tree_.insert(std::move(value));
+  }
+
+  template <typename InputIt>
+  inline void insert(InputIt first, InputIt last) {
+    tree_.insert(first, last);
+  }
+
+  template <typename... Args>
+  inline std::pair<iterator, bool> emplace(Args &&...args) {
+    return tree_.emplace(std::forward<Args>(args)...);
+  }
+
+  inline iterator erase(iterator pos) { return tree_.erase(pos); }
+
+  inline size_type erase(const Key &key) { return tree_.erase(key); }
+
+  inline void swap(flat_set &other) noexcept { tree_.swap(other.tree_); }
+
+  // moves keys of other that are not present here; duplicates stay in other
+  void merge(flat_set &other) {
+    if (&other != this) tree_.merge(other.tree_);
+  }
+
+  inline iterator find(const Key &key) const { return tree_.find(key); }
+
+  inline size_type count(const Key &key) const { return tree_.count(key); }
+
+  inline bool contains(const Key &key) const { return tree_.contains(key); }
+
+  inline iterator lower_bound(const Key &key) const {
+    return tree_.lower_bound(key);
+  }
+
+  inline iterator upper_bound(const Key &key) const {
+    return tree_.upper_bound(key);
+  }
+
+  inline std::pair<iterator, iterator> equal_range(const Key &key) const {
+    return tree_.equal_range(key);
+  }
+};
+
+template <typename Key, typename... Args>
+void insert_many(flat_set<Key> &s, Args &&...args) {
+  (s.emplace(std::forward<Args>(args)), ...);
+}
+
+}  // namespace s21
+
+#endif  //  S21_CONTAINERS_SRC_S21_FLAT_SET_H_
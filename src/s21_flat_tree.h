@@ -0,0 +1,231 @@
+#ifndef S21_CONTAINERS_SRC_S21_FLAT_TREE_H_
+#define S21_CONTAINERS_SRC_S21_FLAT_TREE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+
+#include "s21_tree.h"
+#include "s21_vector.h"
+
+namespace s21 {
+
+// Отсортированный массив уникальных ключей, на котором построены flat_set и
+// flat_map. Интерфейс повторяет tree, но элементы лежат подряд в
+// s21::vector, поэтому поиск - двоичный по непрерывной памяти без переходов
+// по указателям, а вставка и удаление стоят O(n) сдвигов. Контейнер
+// рассчитан на таблицы, которые строятся один раз и потом много читаются.
+//
+// Key        - тип ключа, по которому упорядочены элементы
+// Value      - тип хранимого значения; должен быть перемещаемым, поэтому
+//              flat_map хранит std::pair<Key, T>, а не pair<const Key, T>
+// KeyOfValue - функтор, возвращающий ключ хранимого значения
+// Compare    - строгое слабое упорядочивание ключей
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Compare = std::less<Key>>
+class flat_tree {
+ public:
+  using key_type = Key;
+  using value_type = Value;
+  using size_type = std::size_t;
+  using key_compare = Compare;
+  using container_type = vector<Value>;
+  using iterator = typename container_type::iterator;
+  using const_iterator = typename container_type::const_iterator;
+
+  flat_tree() noexcept {}
+
+  // сортирует и удаляет дубликаты за O(n log n); из равных ключей остается
+  // первый, как при поэлементной вставке
+  template <typename InputIt>
+  flat_tree(InputIt first, InputIt last) : flat_tree() {
+    insert(first, last);
+  }
+
+  inline iterator begin() const noexcept { return data_.begin(); }
+  inline iterator end() const noexcept { return data_.end(); }
+
+  inline bool empty() const noexcept { return data_.empty(); }
+  inline size_type size() const noexcept { return data_.size(); }
+  inline size_type max_size() const noexcept { return data_.max_size(); }
+  inline size_type capacity() const noexcept { return data_.capacity(); }
+  inline key_compare key_comp() const { return comp_; }
+
+  inline void reserve(size_type n) { data_.reserve(n); }
+  inline void shrink_to_fit() { data_.shrink_to_fit(); }
+  inline void clear() noexcept { data_.clear(); }
+
+  void swap(flat_tree &other) noexcept {
+    data_.swap(other.data_);
+    std::swap(comp_, other.comp_);
+  }
+
+  template <typename Arg>
+  std::pair<iterator, bool> insert(Arg &&value) {
+    iterator pos = lowerBound(KeyOfValue()(value));
+    if (pos != end() && !comp_(KeyOfValue()(value), KeyOfValue()(*pos)))
+      return {pos, false};
+    return {data_.insert(pos, std::forward<Arg>(value)), true};
+  }
+
+  // Пакетная вставка. Новые элементы собираются и сортируются в отдельном
+  // массиве, затем встречным проходом для каждого находится место в data_;
+  // все сравнения сделаны до того, как data_ тронут. Потом оба массива
+  // сливаются перемещением в новый буфер без вызова comp_, так что если
+  // бросит копия, сравнение или выделение памяти, контейнер не меняется.
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last) {
+    container_type batch;
+    for (; first != last; ++first) batch.emplace_back(*first);
+    if (batch.empty()) return;
+
+    auto by_key = [this](const Value &a, const Value &b) {
+      return comp_(KeyOfValue()(a), KeyOfValue()(b));
+    };
+    std::stable_sort(batch.begin(), batch.end(), by_key);
+    // после устойчивой сортировки из равных ключей первым стоит ранний
+    auto same = [this](const Value &a, const Value &b) {
+      return !comp_(KeyOfValue()(a), KeyOfValue()(b));
+    };
+    batch.erase(std::unique(batch.begin(), batch.end(), same), batch.end());
+
+    // slots[j] - номер элемента data_, перед которым встанет batch[j];
+    // ключи, которые уже есть, выбрасываются
+    vector<size_type> slots;
+    slots.reserve(batch.size());
+    size_type mine = 0;
+    size_type kept = 0;
+    for (size_type j = 0; j < batch.size(); ++j) {
+      const Key &key = KeyOfValue()(batch[j]);
+      while (mine < size() && comp_(KeyOfValue()(data_[mine]), key)) ++mine;
+      if (mine < size() && !comp_(key, KeyOfValue()(data_[mine]))) continue;
+      if (kept != j) batch[kept] = std::move(batch[j]);
+      ++kept;
+      slots.push_back(mine);
+    }
+    if (kept == 0) return;
+
+    container_type merged;
+    merged.reserve(size() + kept);
+    size_type i = 0;
+    for (size_type j = 0; j < kept; ++j) {
+      for (; i < slots[j]; ++i)
+        merged.emplace_back(std::move_if_noexcept(data_[i]));
+      merged.emplace_back(std::move_if_noexcept(batch[j]));
+    }
+    for (; i < size(); ++i)
+      merged.emplace_back(std::move_if_noexcept(data_[i]));
+    data_.swap(merged);
+  }
+
+  // Переносит из other элементы с ключами, которых здесь нет; остальные
+  // остаются в other по порядку. Оба массива отсортированы, поэтому
+  // наличие ключа проверяется одним встречным проходом, а перенесенные
+  // элементы вливаются одним inplace_merge. Если перенос бросит, уже
+  // перенесенные элементы остаются здесь, а не перенесенные - в other.
+  void merge(flat_tree &other) {
+    const size_type old_size = size();
+    size_type mine = 0;
+    size_type kept = 0;
+    size_type i = 0;
+    // убирает из other пустые после переноса места и сортирует себя
+    auto settle = [&] {
+      other.data_.erase(other.begin() + kept, other.begin() + i);
+      std::inplace_merge(begin(), begin() + old_size, end(),
+                         [this](const Value &a, const Value &b) {
+                           return comp_(KeyOfValue()(a), KeyOfValue()(b));
+                         });
+    };
+    try {
+      for (; i < other.size(); ++i) {
+        Value &item = other.data_[i];
+        const Key &key = KeyOfValue()(item);
+        while (mine < old_size && comp_(KeyOfValue()(data_[mine]), key))
+          ++mine;
+        if (mine < old_size && !comp_(key, KeyOfValue()(data_[mine]))) {
+          if (kept != i) other.data_[kept] = std::move(item);
+          ++kept;
+        } else {
+          data_.emplace_back(std::move(item));
+        }
+      }
+    } catch (...) {
+      settle();
+      throw;
+    }
+    settle();
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    return insert(Value(std::forward<Args>(args)...));
+  }
+
+  // конструирует значение из args, только если ключа еще нет
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key &key, Args &&...args) {
+    iterator pos = lowerBound(key);
+    if (pos != end() && !comp_(key, KeyOfValue()(*pos))) return {pos, false};
+    return {data_.emplace(pos, std::forward<Args>(args)...), true};
+  }
+
+  inline iterator erase(const_iterator pos) {
+    return data_.erase(const_cast<iterator>(pos));
+  }
+
+  inline iterator erase(const_iterator first, const_iterator last) {
+    return data_.erase(const_cast<iterator>(first), const_cast<iterator>(last));
+  }
+
+  size_type erase(const Key &key) {
+    iterator pos = find(key);
+    if (pos == end()) return 0;
+    erase(pos);
+    return 1;
+  }
+
+  iterator find(const Key &key) const {
+    iterator pos = lowerBound(key);
+    return pos != end() && !comp_(key, KeyOfValue()(*pos)) ? pos : end();
+  }
+
+  inline bool contains(const Key &key) const { return find(key) != end(); }
+
+  inline size_type count(const Key &key) const { return contains(key); }
+
+  inline iterator lower_bound(const Key &key) const { return lowerBound(key); }
+
+  iterator upper_bound(const Key &key) const {
+    iterator pos = lowerBound(key);
+    return pos != end() && !comp_(key, KeyOfValue()(*pos)) ? pos + 1 : pos;
+  }
+
+  std::pair<iterator, iterator> equal_range(const Key &key) const {
+    return {lower_bound(key), upper_bound(key)};
+  }
+
+ private:
+  // Двоичный поиск без ветвлений: на каждом шаге выбирается одна из
+  // половин, и для арифметических ключей сравнение компилируется в cmov,
+  // а не в плохо предсказуемый переход.
+  iterator lowerBound(const Key &key) const {
+    iterator base = begin();
+    size_type n = size();
+    if (n == 0) return base;
+    while (n > 1) {
+      const size_type half = n / 2;
+      base = comp_(KeyOfValue()(base[half - 1]), key) ? base + half : base;
+      n -= half;
+    }
+    return base + comp_(KeyOfValue()(*base), key);
+  }
+
+  container_type data_;
+  Compare comp_;
+};
+
+}  // namespace s21
+
+#endif  // S21_CONTAINERS_SRC_S21_FLAT_TREE_H_
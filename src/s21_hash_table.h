@@ -0,0 +1,605 @@
+#ifndef S21_CONTAINERS_SRC_S21_HASH_TABLE_H_
+#define S21_CONTAINERS_SRC_S21_HASH_TABLE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace s21 {
+
+namespace hash_detail {
+
+// Управляющий байт слота: старший бит установлен у пустого слота и у
+// стража за концом таблицы, у занятого слота там лежат 7 младших бит хеша.
+using ctrl_t = signed char;
+constexpr ctrl_t kEmpty = -128;
+constexpr ctrl_t kSentinel = -1;
+constexpr std::size_t kGroupWidth = 16;
+
+// 16 подряд идущих управляющих байтов, проверяемых за одну операцию.
+// Маски - по одному биту на слот, младший бит соответствует первому слоту.
+class group {
+ public:
+#if defined(__SSE2__)
+  explicit group(const ctrl_t *pos) noexcept
+      : ctrl_(_mm_loadu_si128(reinterpret_cast<const __m128i *>(pos))) {}
+
+  inline std::uint32_t match(ctrl_t h2) const noexcept {
+    return static_cast<std::uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_)));
+  }
+
+  // пустые слоты и страж
+  inline std::uint32_t matchEmpty() const noexcept {
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(ctrl_));
+  }
+
+ private:
+  __m128i ctrl_;
+#else
+  explicit group(const ctrl_t *pos) noexcept {
+    std::memcpy(ctrl_, pos, kGroupWidth);
+  }
+
+  inline std::uint32_t match(ctrl_t h2) const noexcept {
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < kGroupWidth; ++i)
+      mask |= static_cast<std::uint32_t>(ctrl_[i] == h2) << i;
+    return mask;
+  }
+
+  inline std::uint32_t matchEmpty() const noexcept {
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < kGroupWidth; ++i)
+      mask |= static_cast<std::uint32_t>(ctrl_[i] < 0) << i;
+    return mask;
+  }
+
+ private:
+  ctrl_t ctrl_[kGroupWidth];
+#endif
+};
+
+inline unsigned lowestBit(std::uint32_t mask) noexcept {
+  return static_cast<unsigned>(__builtin_ctz(mask));
+}
+
+// std::hash для целых - тождественная функция, поэтому результат
+// пользовательского хеша всегда перемешивается: иначе последовательные
+// ключи дали бы одинаковые 7 бит для control-байта.
+inline std::uint64_t mix(std::size_t hash) noexcept {
+  std::uint64_t h = static_cast<std::uint64_t>(hash) * 0x9E3779B97F4A7C15ull;
+  return h ^ (h >> 32);
+}
+
+template <typename Hash, typename KeyEqual, typename = void>
+struct is_transparent : std::false_type {};
+
+template <typename Hash, typename KeyEqual>
+struct is_transparent<Hash, KeyEqual,
+                      std::void_t<typename Hash::is_transparent,
+                                  typename KeyEqual::is_transparent>>
+    : std::true_type {};
+
+// Тип аргумента поиска. Псевдоним раскрывается прямо в K, поэтому K
+// выводится из аргумента, а без прозрачности аргумент приводится к Key.
+template <bool Transparent>
+struct key_arg {
+  template <typename K, typename Key>
+  using type = K;
+};
+
+template <>
+struct key_arg<false> {
+  template <typename K, typename Key>
+  using type = Key;
+};
+
+// pair<const Key, T> из unordered_map: при переносе между слотами ключ
+// перемещается, а не копируется
+template <typename Value>
+struct is_const_key_pair : std::false_type {};
+
+template <typename Key, typename T>
+struct is_const_key_pair<std::pair<const Key, T>> : std::true_type {};
+
+// перенос слота не бросает: для pair<const Key, T> смотрим на Key и T по
+// отдельности, потому что ключ переносится как Key &&
+template <typename Value>
+struct is_nothrow_relocatable : std::is_nothrow_move_constructible<Value> {};
+
+template <typename Key, typename T>
+struct is_nothrow_relocatable<std::pair<const Key, T>>
+    : std::bool_constant<std::is_nothrow_move_constructible_v<Key> &&
+                         std::is_nothrow_move_constructible_v<T>> {};
+
+}  // namespace hash_detail
+
+// Хеш-таблица с открытой адресацией, на которой построены unordered_set и
+// unordered_map.
+//
+// Key        - тип ключа
+// Value      - тип хранимого значения
+// KeyOfValue - функтор, возвращающий ключ хранимого значения
+// Hash       - хеш ключа; результат дополнительно перемешивается
+// KeyEqual   - равенство ключей
+//
+// Значения лежат прямо в массиве слотов, рядом хранится массив управляющих
+// байтов. Ключ с хешем h начинает поиск со слота (h >> 7) & (capacity - 1)
+// и идет линейно вперед группами по 16 слотов: одна SSE2-инструкция находит
+// в группе все слоты с такими же 7 битами хеша, вторая - пустые слоты,
+// на которых поиск останавливается.
+//
+// Таблица не заворачивается в начало: за capacity слотами идет хвост из
+// kTailSlots слотов для переполнения последних цепочек, а за ним страж.
+// Если цепочка упирается в стража, таблица растет. Благодаря этому удаление
+// обходится без надгробий: следующие за удаленным элементы той же цепочки
+// сдвигаются назад на освободившееся место (backward shift), и инвариант
+// "между домашним слотом и элементом нет пустых слотов" сохраняется.
+// Сдвиг идет только от больших индексов к меньшим, поэтому
+// it = erase(it) при обходе не пропускает и не повторяет элементы.
+//
+// Если Hash и KeyEqual объявляют is_transparent, поиск принимает любой тип,
+// который они умеют хешировать и сравнивать, без построения Key.
+//
+// Сдвиг при удалении и рост переносят элементы между слотами, поэтому
+// ключ и значение обязаны перемещаться без исключений. Hash тоже не должен
+// бросать: удаление заново хеширует сдвигаемые элементы, и исключение на
+// середине сдвига оставило бы дырку в цепочке.
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+class hash_table {
+  using ctrl_t = hash_detail::ctrl_t;
+
+  static_assert(hash_detail::is_nothrow_relocatable<Value>::value,
+                "hash_table slots must be nothrow move constructible");
+
+ public:
+  using key_type = Key;
+  using value_type = Value;
+  using size_type = std::size_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+
+  // при прозрачных Hash и KeyEqual - тип аргумента поиска, иначе Key
+  template <typename K>
+  using key_arg = typename hash_detail::key_arg<hash_detail::is_transparent<
+      Hash, KeyEqual>::value>::template type<K, Key>;
+
+  template <typename Reference, typename Pointer>
+  class Iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Value;
+    using difference_type = std::ptrdiff_t;
+    using reference = Reference;
+    using pointer = Pointer;
+
+    inline Iterator() noexcept : ctrl_(nullptr), slot_(nullptr) {}
+
+    // iterator -> const_iterator
+    template <typename OtherReference, typename OtherPointer,
+              std::enable_if_t<std::is_convertible_v<OtherPointer, Pointer>,
+                               int> = 0>
+    inline Iterator(
+        const Iterator<OtherReference, OtherPointer> &other) noexcept
+        : ctrl_(other.ctrl_), slot_(other.slot_) {}
+
+    inline Reference operator*() const noexcept { return *slot_; }
+    inline Pointer operator->() const noexcept { return slot_; }
+
+    inline Iterator &operator++() noexcept {
+      ++ctrl_;
+      ++slot_;
+      skipEmpty();
+      return *this;
+    }
+
+    inline Iterator operator++(int) noexcept {
+      Iterator temp = *this;
+      ++(*this);
+      return temp;
+    }
+
+    inline bool operator==(const Iterator &other) const noexcept {
+      return ctrl_ == other.ctrl_;
+    }
+
+    inline bool operator!=(const Iterator &other) const noexcept {
+      return ctrl_ != other.ctrl_;
+    }
+
+   private:
+    inline Iterator(const ctrl_t *ctrl, Value *slot) noexcept
+        : ctrl_(ctrl), slot_(slot) {}
+
+    // страж не пуст, поэтому цикл всегда останавливается на end()
+    inline void skipEmpty() noexcept {
+      while (*ctrl_ == hash_detail::kEmpty) {
+        ++ctrl_;
+        ++slot_;
+      }
+    }
+
+    const ctrl_t *ctrl_;
+    Value *slot_;
+
+    template <typename, typename>
+    friend class Iterator;
+    friend class hash_table;
+  };
+
+  using iterator = Iterator<Value &, Value *>;
+  using const_iterator = Iterator<const Value &, const Value *>;
+
+  hash_table() noexcept : ctrl_(emptyCtrl()) {}
+
+  explicit hash_table(size_type bucket_count, const Hash &hash = Hash(),
+                      const KeyEqual &equal = KeyEqual())
+      : ctrl_(emptyCtrl()), hash_(hash), equal_(equal) {
+    reserve(bucket_count);
+  }
+
+  hash_table(const hash_table &other)
+      : ctrl_(emptyCtrl()), hash_(other.hash_), equal_(other.equal_) {
+    copyFrom(other);
+  }
+
+  hash_table(hash_table &&other) noexcept : hash_table() { swap(other); }
+
+  ~hash_table() { release(); }
+
+  hash_table &operator=(const hash_table &other) {
+    if (this != &other) {
+      hash_table copy(other);
+      swap(copy);
+    }
+    return *this;
+  }
+
+  hash_table &operator=(hash_table &&other) noexcept {
+    if (this != &other) {
+      hash_table moved(std::move(other));
+      swap(moved);
+    }
+    return *this;
+  }
+
+  inline iterator begin() const noexcept {
+    iterator it(ctrl_, slots_);
+    it.skipEmpty();
+    return it;
+  }
+
+  inline iterator end() const noexcept {
+    return iterator(ctrl_ + slotCount(), slots_ + slotCount());
+  }
+
+  inline bool empty() const noexcept { return size_ == 0; }
+  inline size_type size() const noexcept { return size_; }
+  inline size_type max_size() const noexcept {
+    return std::numeric_limits<size_type>::max() / 2 / sizeof(Value);
+  }
+
+  inline size_type bucket_count() const noexcept { return capacity_; }
+  inline float load_factor() const noexcept {
+    return capacity_ == 0 ? 0.0f : static_cast<float>(size_) / capacity_;
+  }
+  inline float max_load_factor() const noexcept {
+    return static_cast<float>(kMaxLoadNum) / kMaxLoadDen;
+  }
+  inline hasher hash_function() const { return hash_; }
+  inline key_equal key_eq() const { return equal_; }
+
+  // готовит таблицу к n элементам без перехеширования
+  void reserve(size_type n) {
+    size_type capacity = capacity_ == 0 ? kMinCapacity : capacity_;
+    while (growthLimit(capacity) < n) capacity *= 2;
+    if (capacity != capacity_) rehash(capacity);
+  }
+
+  void clear() noexcept {
+    for (size_type i = 0; i < slotCount(); ++i) {
+      if (ctrl_[i] >= 0) {
+        slots_[i].~Value();
+        ctrl_[i] = hash_detail::kEmpty;
+      }
+    }
+    size_ = 0;
+  }
+
+  void swap(hash_table &other) noexcept {
+    std::swap(ctrl_, other.ctrl_);
+    std::swap(slots_, other.slots_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(size_, other.size_);
+    std::swap(hash_, other.hash_);
+    std::swap(equal_, other.equal_);
+  }
+
+  template <typename Arg>
+  std::pair<iterator, bool> insert(Arg &&value) {
+    const Key &key = KeyOfValue()(value);
+    return emplaceKey(key, std::forward<Arg>(value));
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    Value value(std::forward<Args>(args)...);
+    return insert(std::move(value));
+  }
+
+  // конструирует значение из args, только если ключа еще нет
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> try_emplace(const K &key, Args &&...args) {
+    return emplaceKey(key, std::forward<Args>(args)...);
+  }
+
+  // Переносит из other элементы с ключами, которых здесь нет, не копируя
+  // их; остальные остаются в other. Удаление в other сдвигает следующие
+  // элементы цепочки назад, поэтому после переноса слот i проверяется снова.
+  void merge(hash_table &other) {
+    if (this == &other) return;
+    for (size_type i = 0; i < other.slotCount();) {
+      if (other.ctrl_[i] < 0 || contains(KeyOfValue()(other.slots_[i]))) {
+        ++i;
+        continue;
+      }
+      const std::uint64_t hash = hashOf(KeyOfValue()(other.slots_[i]));
+      const size_type index = freeSlot(hash);
+      relocate(other.slots_ + i, slots_ + index);
+      ctrl_[index] = h2(hash);
+      ++size_;
+      other.closeHole(i);
+    }
+  }
+
+  iterator erase(const_iterator pos) {
+    size_type index = static_cast<size_type>(pos.ctrl_ - ctrl_);
+    eraseAt(index);
+    iterator next(ctrl_ + index, slots_ + index);
+    next.skipEmpty();
+    return next;
+  }
+
+  template <typename K = Key>
+  size_type erase(const key_arg<K> &key) {
+    size_type index = findIndex(key);
+    if (index == kNotFound) return 0;
+    eraseAt(index);
+    return 1;
+  }
+
+  template <typename K = Key>
+  iterator find(const key_arg<K> &key) const {
+    size_type index = findIndex(key);
+    if (index == kNotFound) return end();
+    return iterator(ctrl_ + index, slots_ + index);
+  }
+
+  template <typename K = Key>
+  inline bool contains(const key_arg<K> &key) const {
+    return findIndex(key) != kNotFound;
+  }
+
+  template <typename K = Key>
+  inline size_type count(const key_arg<K> &key) const {
+    return contains(key);
+  }
+
+ private:
+  static constexpr size_type kMinCapacity = 16;
+  static constexpr size_type kTailSlots = 2 * hash_detail::kGroupWidth;
+  static constexpr size_type kMaxLoadNum = 7;
+  static constexpr size_type kMaxLoadDen = 8;
+  static constexpr size_type kNotFound = static_cast<size_type>(-1);
+
+  // Пустая таблица без выделенной памяти: один страж, так что begin() ==
+  // end(), а поиск при capacity_ == 0 просто не выполняется.
+  static ctrl_t *emptyCtrl() noexcept {
+    static ctrl_t sentinel = hash_detail::kSentinel;
+    return &sentinel;
+  }
+
+  static inline size_type growthLimit(size_type capacity) noexcept {
+    return capacity / kMaxLoadDen * kMaxLoadNum;
+  }
+
+  inline size_type slotCount() const noexcept {
+    return capacity_ == 0 ? 0 : capacity_ + kTailSlots;
+  }
+
+  inline size_type home(std::uint64_t hash) const noexcept {
+    return static_cast<size_type>(hash >> 7) & (capacity_ - 1);
+  }
+
+  static inline ctrl_t h2(std::uint64_t hash) noexcept {
+    return static_cast<ctrl_t>(hash & 0x7F);
+  }
+
+  template <typename K>
+  inline std::uint64_t hashOf(const K &key) const {
+    return hash_detail::mix(hash_(key));
+  }
+
+  template <typename K>
+  size_type findIndex(const K &key) const {
+    if (size_ == 0) return kNotFound;
+    const std::uint64_t hash = hashOf(key);
+    const ctrl_t tag = h2(hash);
+    for (size_type pos = home(hash);; pos += hash_detail::kGroupWidth) {
+      hash_detail::group g(ctrl_ + pos);
+      for (std::uint32_t mask = g.match(tag); mask != 0; mask &= mask - 1) {
+        size_type index = pos + hash_detail::lowestBit(mask);
+        if (equal_(key, KeyOfValue()(slots_[index]))) return index;
+      }
+      if (g.matchEmpty() != 0) return kNotFound;
+    }
+  }
+
+  // первый свободный слот цепочки; slotCount() означает переполнение хвоста
+  size_type findEmpty(std::uint64_t hash) const noexcept {
+    for (size_type pos = home(hash);; pos += hash_detail::kGroupWidth) {
+      std::uint32_t mask = hash_detail::group(ctrl_ + pos).matchEmpty();
+      if (mask != 0) return pos + hash_detail::lowestBit(mask);
+    }
+  }
+
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> emplaceKey(const K &key, Args &&...args) {
+    size_type index = findIndex(key);
+    if (index != kNotFound) {
+      return {iterator(ctrl_ + index, slots_ + index), false};
+    }
+
+    const std::uint64_t hash = hashOf(key);
+    index = freeSlot(hash);
+    new (slots_ + index) Value(std::forward<Args>(args)...);
+    ctrl_[index] = h2(hash);
+    ++size_;
+    return {iterator(ctrl_ + index, slots_ + index), true};
+  }
+
+  // свободный слот для еще одного элемента с хешем hash; таблица растет,
+  // если превышена загрузка или цепочка уперлась в стража
+  size_type freeSlot(std::uint64_t hash) {
+    if (size_ + 1 > growthLimit(capacity_)) {
+      rehash(capacity_ == 0 ? kMinCapacity : capacity_ * 2);
+    }
+    size_type index = findEmpty(hash);
+    while (index == slotCount()) {
+      rehash(capacity_ * 2);
+      index = findEmpty(hash);
+    }
+    return index;
+  }
+
+  void eraseAt(size_type index) {
+    slots_[index].~Value();
+    closeHole(index);
+  }
+
+  // Backward shift: элемент за дыркой переезжает в нее, если его домашний
+  // слот не дальше дырки; цепочка заканчивается на пустом слоте или страже.
+  // Значение в hole уже разрушено или перенесено. Вызывает hash_, поэтому
+  // не noexcept; от hash_ ожидается, что он не бросает.
+  void closeHole(size_type hole) {
+    for (size_type next = hole + 1; ctrl_[next] >= 0; ++next) {
+      if (home(hashOf(KeyOfValue()(slots_[next]))) <= hole) {
+        relocate(slots_ + next, slots_ + hole);
+        ctrl_[hole] = ctrl_[next];
+        hole = next;
+      }
+    }
+    ctrl_[hole] = hash_detail::kEmpty;
+    --size_;
+  }
+
+  // Ключ pair<const Key, T> перемещается через const_cast, как в key() у
+  // node handle: исходное значение сразу разрушается, и его ключ больше
+  // никто не читает. Формально это изменение const-подобъекта, то есть
+  // UB; как и libstdc++ в node handle, полагаемся на то, что компилятор
+  // не делает из const ключа выводов, которые бы это сломали.
+  static inline void relocate(Value *from, Value *to) noexcept {
+    if constexpr (hash_detail::is_const_key_pair<Value>::value) {
+      new (to) Value(std::move(const_cast<Key &>(from->first)),
+                     std::move(from->second));
+    } else {
+      new (to) Value(std::move(*from));
+    }
+    from->~Value();
+  }
+
+  // Переносит элементы в таблицу из new_capacity слотов. Если в новой
+  // таблице переполнится хвост, она сама вырастет еще вдвое.
+  void rehash(size_type new_capacity) {
+    hash_table bigger(hash_, equal_);
+    bigger.allocate(new_capacity);
+    for (size_type i = 0; i < slotCount(); ++i) {
+      if (ctrl_[i] < 0) continue;
+      const std::uint64_t hash = hashOf(KeyOfValue()(slots_[i]));
+      size_type index = bigger.findEmpty(hash);
+      while (index == bigger.slotCount()) {
+        bigger.rehash(bigger.capacity_ * 2);
+        index = bigger.findEmpty(hash);
+      }
+      relocate(slots_ + i, bigger.slots_ + index);
+      bigger.ctrl_[index] = h2(hash);
+      ctrl_[i] = hash_detail::kEmpty;
+      ++bigger.size_;
+    }
+    size_ = 0;
+    swap(bigger);
+  }
+
+  hash_table(const Hash &hash, const KeyEqual &equal)
+      : ctrl_(emptyCtrl()), hash_(hash), equal_(equal) {}
+
+  // слоты, хвост, страж и еще группа пустых байтов, чтобы чтение группы,
+  // начатое у стража, не выходило за массив
+  void allocate(size_type capacity) {
+    const size_type slots = capacity + kTailSlots;
+    ctrl_t *ctrl = new ctrl_t[slots + hash_detail::kGroupWidth];
+    try {
+      slots_ = static_cast<Value *>(::operator new(
+          slots * sizeof(Value), std::align_val_t(alignof(Value))));
+    } catch (...) {
+      delete[] ctrl;
+      throw;
+    }
+    ctrl_ = ctrl;
+    std::memset(ctrl_, static_cast<unsigned char>(hash_detail::kEmpty),
+                slots + hash_detail::kGroupWidth);
+    ctrl_[slots] = hash_detail::kSentinel;
+    capacity_ = capacity;
+  }
+
+  void release() noexcept {
+    if (capacity_ == 0) return;
+    clear();
+    ::operator delete(slots_, std::align_val_t(alignof(Value)));
+    delete[] ctrl_;
+    ctrl_ = emptyCtrl();
+    slots_ = nullptr;
+    capacity_ = 0;
+  }
+
+  // копирует слоты на те же позиции, без перехеширования
+  void copyFrom(const hash_table &other) {
+    if (other.capacity_ == 0) return;
+    allocate(other.capacity_);
+    try {
+      for (size_type i = 0; i < slotCount(); ++i) {
+        if (other.ctrl_[i] < 0) continue;
+        new (slots_ + i) Value(other.slots_[i]);
+        ctrl_[i] = other.ctrl_[i];
+        ++size_;
+      }
+    } catch (...) {
+      release();
+      throw;
+    }
+  }
+
+  ctrl_t *ctrl_;
+  Value *slots_ = nullptr;
+  size_type capacity_ = 0;  // 0 или степень двойки
+  size_type size_ = 0;
+  Hash hash_;
+  KeyEqual equal_;
+};
+
+}  // namespace s21
+
+#endif  // S21_CONTAINERS_SRC_S21_HASH_TABLE_H_
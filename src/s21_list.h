@@ -1,146 +1,192 @@
 #ifndef S21_CONTAINERS_SRC_S21_LIST_H
 #define S21_CONTAINERS_SRC_S21_LIST_H
 
+#include <functional>
+#include <cstddef>
 #include <initializer_list>
+#include <iterator>
 #include <limits>
+#include <memory>
+#include <memory_resource>
+#include <new>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
 
+#include "s21_node_pool.h"
+
 namespace s21 {
 
-template <typename T>
+// Узлы выделяются блоками из node_pool, а блоки - через Allocator, так что
+// список можно разместить на арене (см. s21::pmr::list).
+template <typename T, typename Allocator = std::allocator<T>>
 class list {
  private:
-  struct Node {
+  // Общая часть узла. Список кольцевой: sentinel - это end(),
+  // sentinel.next - первый узел, sentinel.prev - последний, так что ни
+  // вставка, ни обход не проверяют указатели на nullptr.
+  struct NodeBase {
+    NodeBase* next;
+    NodeBase* prev;
+  };
+
+  struct Node : NodeBase {
     T list_arr;
-    Node* next;
-    Node* prev;
+
+    template <typename... Args>
+    explicit Node(Args&&... args)
+        : NodeBase{nullptr, nullptr}, list_arr(std::forward<Args>(args)...) {}
   };
-  Node* head;
-  Node* tail;
+
+  using node_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+
+  NodeBase sentinel;
   std::size_t list_size;
+  node_pool<Node, node_allocator> pool;  // узлы берутся из пула, а не по
+                                         // одному через new
+
+  template <typename... Args>
+  Node* createNode(Args&&... args);
+  void destroyNode(NodeBase* node) noexcept;
+  static T& value(NodeBase* node) noexcept {
+    return static_cast<Node*>(node)->list_arr;
+  }
+  template <typename Compare>
+  static void mergeRuns(NodeBase*& left, NodeBase*& right, Compare& comp);
+  static void appendChain(NodeBase*& tail, NodeBase* chain) noexcept;
+  static void linkRange(NodeBase* pos, NodeBase* first,
+                        NodeBase* last) noexcept;
+  static void unlinkRange(NodeBase* first, NodeBase* last) noexcept;
+  void resetSentinel() noexcept;
+  void fixSentinel() noexcept;
 
  public:
   using value_type = T;
   using reference = T&;
   using const_reference = const T&;
   using size_type = std::size_t;
+  using allocator_type = Allocator;
 
-  template <typename value_type>
+  // Итератор - просто указатель на узел. Если определён
+  // S21_LIST_CHECKED_ITERATORS, итератор дополнительно помнит sentinel
+  // своего списка и бросает std::out_of_range при разыменовании end()
+  // и выходе за границы.
+  template <typename Reference>
   class ListIterator {
-   private:
-    Node* iter;
-
    public:
-    ListIterator(Node* lst) { iter = lst; }
-    ListIterator(const ListIterator& other) { this->iter = other.iter; }
-    ListIterator(ListIterator&& other) { this->iter = other.iter; }
-    ~ListIterator() { iter = nullptr; }
-    reference operator*() {
-      if (iter == nullptr) {
-        throw std::out_of_range("the list is empty");
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using reference = Reference;
+    using pointer = std::remove_reference_t<Reference>*;
+
+    ListIterator() = default;
+
+    // iterator -> const_iterator
+    template <typename Other,
+              typename = std::enable_if_t<std::is_convertible_v<
+                  std::remove_reference_t<Other>*, pointer>>>
+    ListIterator(const ListIterator<Other>& other) noexcept
+        : iter(other.iter) {
+#ifdef S21_LIST_CHECKED_ITERATORS
+      end_ = other.end_;
+#endif
+    }
+
+    reference operator*() const {
+#ifdef S21_LIST_CHECKED_ITERATORS
+      if (iter == end_) {
+        throw std::out_of_range("dereferencing the end of the list");
       }
-      return iter->list_arr;
+#endif
+      return list::value(iter);
     }
 
+    pointer operator->() const { return &**this; }
+
     ListIterator& operator++() {
-      if (iter == nullptr) {
-        throw std::out_of_range("the list is empty");
+#ifdef S21_LIST_CHECKED_ITERATORS
+      if (iter == end_) {
+        throw std::out_of_range("incrementing past the end of the list");
       }
+#endif
       iter = iter->next;
       return *this;
     }
 
+    ListIterator operator++(int) {
+      ListIterator tmp(*this);
+      ++*this;
+      return tmp;
+    }
+
     ListIterator& operator--() {
-      if (iter->prev == nullptr) {
-        throw std::out_of_range("the list is empty");
+#ifdef S21_LIST_CHECKED_ITERATORS
+      if (iter->prev == end_) {
+        throw std::out_of_range("decrementing past the begin of the list");
       }
+#endif
       iter = iter->prev;
       return *this;
     }
 
-    bool operator!=(ListIterator const& other) const {
-      return this->iter != other.iter;
+    ListIterator operator--(int) {
+      ListIterator tmp(*this);
+      --*this;
+      return tmp;
     }
 
-    bool operator==(ListIterator const& other) const {
-      return this->iter == other.iter;
+    bool operator==(const ListIterator& other) const {
+      return iter == other.iter;
     }
 
-    void operator=(const ListIterator& other) { this->iter = other.iter; }
-
-    void operator=(ListIterator&& other) { this->iter = other.iter; }
-
-    friend class list<T>;
-  };
-
-  template <typename value_type>
-  class ConstListIterator {
-   private:
-    Node* iter;
-
-   public:
-    ConstListIterator(Node* lst) { iter = lst; }
-    ConstListIterator(const ConstListIterator& other) {
-      this->iter = other.iter;
-    }
-    ConstListIterator(ConstListIterator&& other) { this->iter = other.iter; }
-    ~ConstListIterator() { iter = nullptr; }
-    reference operator*() {
-      if (iter == nullptr) {
-        throw std::out_of_range("the list is empty");
-      }
-      return iter->list_arr;
-    }
-
-    ConstListIterator& operator++() {
-      if (iter == nullptr) {
-        throw std::out_of_range("the list is empty");
-      }
-      iter = iter->next;
-      return *this;
-    }
-
-    ConstListIterator& operator--() {
-      if (iter->prev == nullptr) {
-        throw std::out_of_range("the list is empty");
-      }
-      iter = iter->prev;
-      return *this;
+    bool operator!=(const ListIterator& other) const {
+      return iter != other.iter;
     }
 
-    bool operator!=(ConstListIterator const& other) const {
-      return this->iter != other.iter;
-    }
-
-    bool operator==(ConstListIterator const& other) const {
-      return this->iter == other.iter;
+   private:
+    ListIterator(NodeBase* node, const NodeBase* end) noexcept : iter(node) {
+#ifdef S21_LIST_CHECKED_ITERATORS
+      end_ = end;
+#else
+      (void)end;
+#endif
     }
 
-    void operator=(const ConstListIterator& other) { this->iter = other.iter; }
+    NodeBase* iter = nullptr;
+#ifdef S21_LIST_CHECKED_ITERATORS
+    const NodeBase* end_ = nullptr;
+#endif
 
-    void operator=(ConstListIterator&& other) { this->iter = other.iter; }
-
-    friend class list<T>;
+    template <typename>
+    friend class ListIterator;
+    friend class list;
   };
 
-  using iterator = ListIterator<T>;
-  using const_iterator = ConstListIterator<T>;
+  using iterator = ListIterator<T&>;
+  using const_iterator = ListIterator<const T&>;
 
   list();
+  explicit list(const Allocator& alloc);
   list(size_type n);
   list(std::initializer_list<value_type> const& items);
   list(const list& l);
+  list(const list& l, const Allocator& alloc);
   list(list&& l);
   ~list();
   list& operator=(list&& l);
   list& operator=(const list& l);
 
+  allocator_type get_allocator() const;
+
   const_reference front() const;
   const_reference back() const;
 
   iterator begin();
   iterator end();
+  const_iterator begin() const;
+  const_iterator end() const;
   const_iterator cbegin() const;
   const_iterator cend() const;
 
@@ -150,38 +196,60 @@ class list {
 
   void clear();
   iterator insert(iterator pos, const_reference value);
-  void erase(iterator pos);
+  iterator insert(iterator pos, value_type&& value);
+  iterator erase(iterator pos);
   void push_back(const_reference value);
+  void push_back(value_type&& value);
   void pop_back();
   void push_front(const_reference value);
+  void push_front(value_type&& value);
   void pop_front();
+
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args&&... args);
+  template <typename... Args>
+  reference emplace_back(Args&&... args);
+  template <typename... Args>
+  reference emplace_front(Args&&... args);
   void swap(list& other);
   void merge(list& other);
+  template <typename Compare>
+  void merge(list& other, Compare comp);
   void splice(const_iterator pos, list& other);
+  void splice(const_iterator pos, list& other, const_iterator it);
+  void splice(const_iterator pos, list& other, const_iterator first,
+              const_iterator last);
   void reverse();
   void unique();
   void sort();
+  template <typename Compare>
+  void sort(Compare comp);
 
   template <typename... Args>
   iterator insert_many(const_iterator pos, Args&&... args) {
-    iterator pos_ = iterator(pos.iter);
-    iterator it = (insert(pos_, std::forward<Args>(args)), ...);
+    iterator it(pos.iter, &sentinel);
+    ((it = emplace(pos, std::forward<Args>(args))), ...);
     return it;
   }
 
   template <typename... Args>
   void insert_many_back(Args&&... args) {
-    (push_back(std::forward<Args>(args)), ...);
+    (emplace_back(std::forward<Args>(args)), ...);
   }
 
   template <typename... Args>
   void insert_many_front(Args&&... args) {
-    (push_front(std::forward<Args>(args)), ...);
+    (emplace_front(std::forward<Args>(args)), ...);
   }
 };
 
 #include "s21_list.tpp"
 
+namespace pmr {
+template <typename T>
+using list = s21::list<T, std::pmr::polymorphic_allocator<T>>;
+}  // namespace pmr
+
 }  // namespace s21
 
 #endif  // S21_CONTAINERS_SRC_S21_LIST_H
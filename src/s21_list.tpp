@@ -1,146 +1,141 @@
 // #include "s21_list.h"
 
-template <typename T>
-s21::list<T>::list() {
-  head = nullptr;
-  tail = nullptr;
+template <typename T, typename Allocator>
+s21::list<T, Allocator>::list() {
+  resetSentinel();
   list_size = 0;
 }
 
-template <typename T>
-s21::list<T>::list(size_type n) {
-  list_size = n;
-  for (size_t i = 0; i < n; i++) {
-    Node* newNode = new Node;
-    newNode->list_arr = T();
-    newNode->next = nullptr;
+template <typename T, typename Allocator>
+s21::list<T, Allocator>::list(const Allocator& alloc) : pool(alloc) {
+  resetSentinel();
+  list_size = 0;
+}
 
-    if (head == nullptr) {
-      head = tail = newNode;
-    } else {
-      newNode->prev = tail;
-      tail->next = newNode;
-      tail = newNode;
-    }
-  }
+template <typename T, typename Allocator>
+s21::list<T, Allocator>::list(size_type n) : list() {
+  for (size_t i = 0; i < n; i++) emplace_back();
 }
 
-template <typename T>
-s21::list<T>::list(std::initializer_list<value_type> const& items) {
-  head = nullptr;
-  tail = nullptr;
-  for (auto it = items.begin(); it != items.end(); ++it) {
-    Node* newNode = new Node;
-    newNode->list_arr = *it;
-    newNode->next = nullptr;
-    if (head == nullptr) {
-      head = tail = newNode;
-    } else {
-      newNode->prev = tail;
-      tail->next = newNode;
-      tail = newNode;
-    }
-  }
-  list_size = items.size();
+template <typename T, typename Allocator>
+s21::list<T, Allocator>::list(std::initializer_list<value_type> const& items)
+    : list() {
+  for (auto it = items.begin(); it != items.end(); ++it) emplace_back(*it);
 }
 
-template <typename T>
-s21::list<T>::list(const list& l) {
-  head = nullptr;
-  tail = nullptr;
-  list_size = 0;
-  Node* current = l.head;
-  while (current != nullptr) {
-    push_back(current->list_arr);
-    current = current->next;
-  }
-  list_size = l.list_size;
+template <typename T, typename Allocator>
+s21::list<T, Allocator>::list(const list& l)
+    : list(l, std::allocator_traits<Allocator>::
+                  select_on_container_copy_construction(l.get_allocator())) {}
+
+template <typename T, typename Allocator>
+s21::list<T, Allocator>::list(const list& l, const Allocator& alloc)
+    : list(alloc) {
+  for (auto it = l.begin(); it != l.end(); ++it) emplace_back(*it);
 }
 
-template <typename T>
-s21::list<T>::list(list&& l) {
-  head = l.head;
-  tail = l.tail;
+template <typename T, typename Allocator>
+s21::list<T, Allocator>::list(list&& l) : pool(std::move(l.pool)) {
+  sentinel = l.sentinel;
   list_size = l.list_size;
-  l.tail = nullptr;
-  l.head = nullptr;
+  fixSentinel();
+  l.resetSentinel();
   l.list_size = 0;
 }
 
-template <typename T>
-s21::list<T>::~list() {
-  Node* current = head;
-  while (current != nullptr) {
-    Node* tmp = current->next;
-    delete current;
-    current = tmp;
-  }
-  list_size = 0;
+template <typename T, typename Allocator>
+s21::list<T, Allocator>::~list() {
+  clear();
 }
 
-template <typename T>
-s21::list<T>& s21::list<T>::operator=(const list& l) {
-  this->head = nullptr;
-  this->tail = nullptr;
-  this->list_size = 0;
-  Node* current = l.head;
-  while (current != nullptr) {
-    push_back(current->list_arr);
-    current = current->next;
+template <typename T, typename Allocator>
+s21::list<T, Allocator>& s21::list<T, Allocator>::operator=(const list& l) {
+  if (this != &l) {
+    list tmp(l, get_allocator());  // копия остается на нашем аллокаторе
+    swap(tmp);
   }
-  list_size = l.list_size;
   return *this;
 }
 
-template <typename T>
-s21::list<T>& s21::list<T>::operator=(list&& l) {
-  this->head = l.head;
-  this->tail = l.tail;
-  this->list_size = l.list_size;
-  l.tail = nullptr;
-  l.head = nullptr;
-  l.list_size = 0;
+template <typename T, typename Allocator>
+s21::list<T, Allocator>& s21::list<T, Allocator>::operator=(list&& l) {
+  if (this == &l) return *this;
+  using traits = std::allocator_traits<Allocator>;
+  if (traits::propagate_on_container_move_assignment::value ||
+      get_allocator() == l.get_allocator()) {
+    list tmp(std::move(l));  // старые узлы и пул уходят вместе с tmp
+    swap(tmp);
+  } else {
+    // аллокатор не переходит (как у std::pmr): значения переезжают в узлы
+    // из нашего пула, а узлы l остаются ему
+    list tmp(get_allocator());
+    for (auto it = l.begin(); it != l.end(); ++it)
+      tmp.emplace_back(std::move(*it));
+    swap(tmp);
+    l.clear();
+  }
   return *this;
 }
 
-template <typename T>
-typename s21::list<T>::const_reference s21::list<T>::front() const {
+template <typename T, typename Allocator>
+Allocator s21::list<T, Allocator>::get_allocator() const {
+  return Allocator(pool.get_allocator());
+}
+
+template <typename T, typename Allocator>
+typename s21::list<T, Allocator>::const_reference
+s21::list<T, Allocator>::front() const {
   if (list_size == 0) {
     throw std::out_of_range("the list is empty");
   }
-  return head->list_arr;
+  return value(sentinel.next);
 }
 
-template <typename T>
-typename s21::list<T>::const_reference s21::list<T>::back() const {
+template <typename T, typename Allocator>
+typename s21::list<T, Allocator>::const_reference
+s21::list<T, Allocator>::back() const {
   if (list_size == 0) {
     throw std::out_of_range("the list is empty");
   }
-  return tail->list_arr;
+  return value(sentinel.prev);
+}
+
+template <typename T, typename Allocator>
+typename s21::list<T, Allocator>::iterator s21::list<T, Allocator>::begin() {
+  return iterator(sentinel.next, &sentinel);
 }
 
-template <typename T>
-typename s21::list<T>::iterator s21::list<T>::begin() {
-  return iterator(head);
+template <typename T, typename Allocator>
+typename s21::list<T, Allocator>::iterator s21::list<T, Allocator>::end() {
+  return iterator(&sentinel, &sentinel);
 }
 
-template <typename T>
-typename s21::list<T>::iterator s21::list<T>::end() {
-  return iterator(nullptr);
+template <typename T, typename Allocator>
+typename s21::list<T, Allocator>::const_iterator
+s21::list<T, Allocator>::begin() const {
+  return cbegin();
 }
 
-template <typename T>
-typename s21::list<T>::const_iterator s21::list<T>::cbegin() const {
-  return const_iterator(head);
+template <typename T, typename Allocator>
+typename s21::list<T, Allocator>::const_iterator
+s21::list<T, Allocator>::end() const {
+  return cend();
 }
 
-template <typename T>
-typename s21::list<T>::const_iterator s21::list<T>::cend() const {
-  return const_iterator(nullptr);
+template <typename T, typename Allocator>
+typename s21::list<T, Allocator>::const_iterator
+s21::list<T, Allocator>::cbegin() const {
+  return const_iterator(sentinel.next, &sentinel);
 }
 
-template <typename T>
-bool s21::list<T>::empty() {
+template <typename T, typename Allocator>
+typename s21::list<T, Allocator>::const_iterator
+s21::list<T, Allocator>::cend() const {
+  return const_iterator(const_cast<NodeBase*>(&sentinel), &sentinel);
+}
+
+template <typename T, typename Allocator>
+bool s21::list<T, Allocator>::empty() {
   bool status = 0;
   if (list_size == 0) {
     status = 1;
@@ -148,254 +143,409 @@ bool s21::list<T>::empty() {
   return status;
 }
 
-template <typename T>
-typename s21::list<T>::size_type s21::list<T>::size() {
+template <typename T, typename Allocator>
+typename s21::list<T, Allocator>::size_type s21::list<T, Allocator>::size() {
   return list_size;
 }
 
-template <typename T>
-typename s21::list<T>::size_type s21::list<T>::max_size() {
+template <typename T, typename Allocator>
+typename s21::list<T, Allocator>::size_type
+s21::list<T, Allocator>::max_size() {
   return std::numeric_limits<int>::max();
 }
 
-template <typename T>
-void s21::list<T>::clear() {
-  Node* current = head;
-  while (current != nullptr) {
-    Node* tmp = current;
+template <typename T, typename Allocator>
+void s21::list<T, Allocator>::clear() {
+  NodeBase* current = sentinel.next;
+  while (current != &sentinel) {
+    NodeBase* tmp = current;
     current = current->next;
-    delete tmp;
+    destroyNode(tmp);
   }
-  head = nullptr;
-  tail = nullptr;
+  resetSentinel();
   list_size = 0;
 }
 
-template <typename T>
-typename s21::list<T>::iterator s21::list<T>::insert(iterator pos,
-                                                     const_reference value) {
-  Node* newNode = new Node;
-  newNode->list_arr = value;
+template <typename T, typename Allocator>
+typename s21::list<T, Allocator>::iterator
+s21::list<T, Allocator>::insert(iterator pos, const_reference value) {
+  return emplace(pos, value);
+}
 
-  if (pos == begin()) {
-    newNode->next = head;
-    if (head != nullptr) {
-      head->prev = newNode;
-    }
-    head = newNode;
-  } else if (pos == end()) {
-    if (tail != nullptr) {
-      tail->next = newNode;
-    } else {
-      head = newNode;  // Если список пуст, новый элемент становится головой
-    }
-    newNode->prev = tail;
-    tail = newNode;
-  } else {
-    newNode->next = pos.iter;
-    newNode->prev = pos.iter->prev;
-    pos.iter->prev->next = newNode;
-    pos.iter->prev = newNode;
-  }
+template <typename T, typename Allocator>
+typename s21::list<T, Allocator>::iterator
+s21::list<T, Allocator>::insert(iterator pos, value_type&& value) {
+  return emplace(pos, std::move(value));
+}
 
+template <typename T, typename Allocator>
+template <typename... Args>
+typename s21::list<T, Allocator>::iterator
+s21::list<T, Allocator>::emplace(const_iterator pos, Args&&... args) {
+  Node* newNode = createNode(std::forward<Args>(args)...);
+  linkRange(pos.iter, newNode, newNode);
   ++list_size;
-  return iterator(newNode);
+  return iterator(newNode, &sentinel);
 }
 
-template <typename T>
-void s21::list<T>::erase(iterator pos) {
-  if (pos == end() || pos.iter == nullptr) {
-    throw std::out_of_range(
-        "Iterator is not valid or points to the end of the list");
-  }
+template <typename T, typename Allocator>
+template <typename... Args>
+typename s21::list<T, Allocator>::reference
+s21::list<T, Allocator>::emplace_back(Args&&... args) {
+  return *emplace(cend(), std::forward<Args>(args)...);
+}
 
-  Node* nodeToDelete = pos.iter;
+template <typename T, typename Allocator>
+template <typename... Args>
+typename s21::list<T, Allocator>::reference
+s21::list<T, Allocator>::emplace_front(Args&&... args) {
+  return *emplace(cbegin(), std::forward<Args>(args)...);
+}
 
-  if (nodeToDelete == head) {
-    head = nodeToDelete->next;
-    if (head != nullptr) {
-      head->prev = nullptr;
-    }
-  } else {
-    nodeToDelete->prev->next = nodeToDelete->next;
-    if (nodeToDelete->next != nullptr) {
-      nodeToDelete->next->prev = nodeToDelete->prev;
-    } else {
-      tail = nodeToDelete->prev;
-    }
+template <typename T, typename Allocator>
+typename s21::list<T, Allocator>::iterator
+s21::list<T, Allocator>::erase(iterator pos) {
+  if (pos.iter == &sentinel) {
+    throw std::out_of_range(
+        "Iterator is not valid or points to the end of the list");
   }
 
-  delete nodeToDelete;
+  NodeBase* nodeToDelete = pos.iter;
+  NodeBase* next = nodeToDelete->next;
+  unlinkRange(nodeToDelete, nodeToDelete);
+  destroyNode(nodeToDelete);
   list_size--;
+  return iterator(next, &sentinel);
 }
 
-template <typename T>
-void s21::list<T>::push_front(const_reference value) {
-  Node* tmp = new Node;
-  tmp->list_arr = value;
-  tmp->next = head;
-  tmp->prev = nullptr;
-
-  if (head == nullptr) {
-    head = tmp;
-    tail = tmp;
-  } else {
-    head->prev = tmp;
-    head = tmp;
-  }
+template <typename T, typename Allocator>
+void s21::list<T, Allocator>::push_front(const_reference value) {
+  emplace_front(value);
+}
 
-  list_size++;
+template <typename T, typename Allocator>
+void s21::list<T, Allocator>::push_front(value_type&& value) {
+  emplace_front(std::move(value));
 }
 
-template <typename T>
-void s21::list<T>::pop_front() {
-  Node* tmp = nullptr;
+template <typename T, typename Allocator>
+void s21::list<T, Allocator>::pop_front() {
   if (list_size == 0) {
     throw std::out_of_range("the list is empty");
   }
-  tmp = head;
-  head = head->next;
-  if (head != nullptr) {
-    head->prev = nullptr;
-  }
-  delete tmp;
-  list_size--;
+  erase(begin());
 }
 
-template <typename T>
-void s21::list<T>::push_back(const_reference value) {
-  Node* newNode = new Node;
-  newNode->list_arr = value;
-  newNode->next = nullptr;
-  newNode->prev = nullptr;
-  if (head == nullptr) {
-    head = tail = newNode;
-  } else {
-    newNode->prev = tail;
-    tail->next = newNode;
-    tail = newNode;
-  }
-  list_size++;
+template <typename T, typename Allocator>
+void s21::list<T, Allocator>::push_back(const_reference value) {
+  emplace_back(value);
 }
 
-template <typename T>
-void s21::list<T>::pop_back() {
+template <typename T, typename Allocator>
+void s21::list<T, Allocator>::push_back(value_type&& value) {
+  emplace_back(std::move(value));
+}
+
+template <typename T, typename Allocator>
+void s21::list<T, Allocator>::pop_back() {
   if (list_size == 0) {
     throw std::out_of_range("the list is empty");
   }
-  if (list_size == 1) {
-    delete tail;
-    head = nullptr;
-    tail = nullptr;
-  } else {
-    Node* prev_tail = tail->prev;
-    delete tail;
-    tail = prev_tail;
-    tail->next = nullptr;
+  erase(iterator(sentinel.prev, &sentinel));
+}
+
+template <typename T, typename Allocator>
+void s21::list<T, Allocator>::swap(list& other) {
+  std::swap(sentinel, other.sentinel);
+  std::swap(list_size, other.list_size);
+  fixSentinel();
+  other.fixSentinel();
+  pool.swap(other.pool);
+}
+
+template <typename T, typename Allocator>
+void s21::list<T, Allocator>::merge(list& other) {
+  merge(other, std::less<value_type>());
+}
+
+// Оба списка должны быть отсортированы по comp. Узлы other вплетаются
+// в *this без выделения памяти, равные элементы *this остаются первыми.
+template <typename T, typename Allocator>
+template <typename Compare>
+void s21::list<T, Allocator>::merge(list& other, Compare comp) {
+  if (this == &other || other.list_size == 0) {
+    return;
+  }
+  pool.adopt(other.pool);
+
+  NodeBase* current = sentinel.next;
+  NodeBase* incoming = other.sentinel.next;
+  while (incoming != &other.sentinel && current != &sentinel) {
+    if (comp(value(incoming), value(current))) {
+      NodeBase* next = incoming->next;
+      linkRange(current, incoming, incoming);
+      incoming = next;
+    } else {
+      current = current->next;
+    }
+  }
+  if (incoming != &other.sentinel) {
+    linkRange(&sentinel, incoming, other.sentinel.prev);
   }
 
-  list_size--;
+  list_size += other.list_size;
+  other.resetSentinel();
+  other.list_size = 0;
 }
 
-template <typename T>
-void s21::list<T>::swap(list& other) {
-  s21::list<T> tmp(*this);
-  *this = other;
-  other = tmp;
+template <typename T, typename Allocator>
+void s21::list<T, Allocator>::splice(const_iterator pos, list& other) {
+  if (this == &other || other.list_size == 0) {
+    return;
+  }
+  pool.adopt(other.pool);
+  linkRange(pos.iter, other.sentinel.next, other.sentinel.prev);
+  list_size += other.list_size;
+  other.resetSentinel();
+  other.list_size = 0;
 }
 
-template <typename T>
-void s21::list<T>::merge(list& other) {
-  Node* current = other.head;
-  while (current != nullptr) {
-    push_back(current->list_arr);
-    current = current->next;
+template <typename T, typename Allocator>
+void s21::list<T, Allocator>::splice(const_iterator pos, list& other,
+                                     const_iterator it) {
+  NodeBase* node = it.iter;
+  if (this != &other) {
+    pool.adopt(other.pool);
+    --other.list_size;
+    ++list_size;
+  } else if (node == pos.iter || node->next == pos.iter) {
+    return;  // узел уже стоит на месте
   }
-  other.clear();
-  sort();
-}
-
-template <typename T>
-void s21::list<T>::splice(const_iterator pos, list& other) {
-  if (!other.empty()) {
-    iterator pos_ = iterator(pos.iter);
-    iterator it = other.begin();
-    for (size_t i = 0; i < other.size(); ++i) {
-      insert(pos_, *it);
-      ++it;
+  unlinkRange(node, node);
+  linkRange(pos.iter, node, node);
+}
+
+// Для разных списков диапазон приходится пересчитать, чтобы обновить
+// размеры, само перемещение узлов - O(1).
+template <typename T, typename Allocator>
+void s21::list<T, Allocator>::splice(const_iterator pos, list& other,
+                          const_iterator first, const_iterator last) {
+  if (first == last) {
+    return;
+  }
+  NodeBase* last_node = last.iter->prev;
+  if (this != &other) {
+    size_type count = 1;
+    for (NodeBase* node = first.iter; node != last_node; node = node->next) {
+      ++count;
     }
-    other.clear();  // Освобождаем память, занимаемую узлами other
+    pool.adopt(other.pool);
+    other.list_size -= count;
+    list_size += count;
+  } else if (pos.iter == last.iter) {
+    return;  // диапазон уже стоит перед pos
   }
+  unlinkRange(first.iter, last_node);
+  linkRange(pos.iter, first.iter, last_node);
 }
 
-template <typename T>
-void s21::list<T>::reverse() {
-  Node* current = head;
-  Node* temp = nullptr;
-  while (current != nullptr) {
-    temp = current->prev;
-    current->prev = current->next;
-    current->next = temp;
-    current = current->prev;
+// Вставляет цепочку [first, last] перед pos. Размер списка не меняет.
+template <typename T, typename Allocator>
+void s21::list<T, Allocator>::linkRange(NodeBase* pos, NodeBase* first,
+                             NodeBase* last) noexcept {
+  NodeBase* before = pos->prev;
+  first->prev = before;
+  last->next = pos;
+  before->next = first;
+  pos->prev = last;
+}
+
+// Вырезает цепочку [first, last], связи внутри неё не трогает.
+template <typename T, typename Allocator>
+void s21::list<T, Allocator>::unlinkRange(NodeBase* first,
+                                          NodeBase* last) noexcept {
+  first->prev->next = last->next;
+  last->next->prev = first->prev;
+}
+
+template <typename T, typename Allocator>
+void s21::list<T, Allocator>::resetSentinel() noexcept {
+  sentinel.next = &sentinel;
+  sentinel.prev = &sentinel;
+}
+
+// Перенаправляет крайние узлы на sentinel после копирования его связей.
+template <typename T, typename Allocator>
+void s21::list<T, Allocator>::fixSentinel() noexcept {
+  if (list_size == 0) {
+    resetSentinel();
+  } else {
+    sentinel.next->prev = &sentinel;
+    sentinel.prev->next = &sentinel;
   }
-  temp = head;
-  head = tail;
-  tail = temp;
 }
 
-template <typename T>
-void s21::list<T>::unique() {
-  if (head == nullptr || head->next == nullptr) {
+template <typename T, typename Allocator>
+void s21::list<T, Allocator>::reverse() {
+  NodeBase* current = &sentinel;
+  do {
+    std::swap(current->next, current->prev);
+    current = current->prev;
+  } while (current != &sentinel);
+}
+
+template <typename T, typename Allocator>
+void s21::list<T, Allocator>::unique() {
+  if (list_size < 2) {
     throw std::out_of_range("the list is empty");
   }
 
-  Node* current = head;
-  Node* next_node = current->next;
+  NodeBase* current = sentinel.next;
+  NodeBase* next_node = current->next;
 
-  while (next_node != nullptr) {
-    if (current->list_arr == next_node->list_arr) {
-      current->next = next_node->next;
-      if (next_node->next != nullptr) {
-        next_node->next->prev = current;
-      }
-      delete next_node;
-      next_node = current->next;
+  while (next_node != &sentinel) {
+    if (value(current) == value(next_node)) {
+      unlinkRange(next_node, next_node);
+      destroyNode(next_node);
       list_size--;
     } else {
       current = next_node;
-      next_node = next_node->next;
     }
+    next_node = current->next;
   }
+}
 
-  tail = current;
-  ;
+template <typename T, typename Allocator>
+void s21::list<T, Allocator>::sort() {
+  sort(std::less<value_type>());
 }
 
-template <typename T>
-void s21::list<T>::sort() {
+// Восходящая сортировка слиянием: bins[i] хранит отсортированную серию
+// из 2^i узлов, новый узел "переносится" по разрядам как в двоичном
+// счётчике. Узлы только перевязываются по next, prev и кольцо через
+// sentinel восстанавливаются одним проходом в конце. Сортировка устойчива.
+// Если comp бросит, все цепочки сшиваются обратно в кольцо: список
+// остаётся целым, но порядок узлов не определён.
+template <typename T, typename Allocator>
+template <typename Compare>
+void s21::list<T, Allocator>::sort(Compare comp) {
   if (list_size <= 1) {
     return;
   }
 
-  Node* sorted = nullptr;
+  const int kBins = 64;
+  NodeBase* bins[kBins] = {};
+  int filled = 0;
+  NodeBase* carry = nullptr;
+  NodeBase* sorted = nullptr;
+
+  sentinel.prev->next = nullptr;  // серии - цепочки, оканчивающиеся nullptr
+  NodeBase* current = sentinel.next;
+  try {
+    while (current != nullptr) {
+      carry = current;
+      current = current->next;
+      carry->next = nullptr;
+
+      int i = 0;
+      for (; i < filled && bins[i] != nullptr; ++i) {
+        mergeRuns(bins[i], carry, comp);  // bins[i] старше carry
+        carry = bins[i];
+        bins[i] = nullptr;
+      }
+      bins[i] = carry;
+      carry = nullptr;
+      if (i == filled) ++filled;
+    }
+
+    for (int i = 0; i < filled; ++i) {
+      if (bins[i] != nullptr) {
+        mergeRuns(bins[i], sorted, comp);
+        sorted = bins[i];
+        bins[i] = nullptr;
+      }
+    }
+  } catch (...) {
+    NodeBase* tail = &sentinel;
+    appendChain(tail, sorted);
+    appendChain(tail, carry);
+    appendChain(tail, current);
+    for (int i = 0; i < filled; ++i) appendChain(tail, bins[i]);
+    tail->next = &sentinel;
+    sentinel.prev = tail;
+    throw;
+  }
 
-  while (head != nullptr) {
-    Node* current = head;
-    head = head->next;
-    current->next = nullptr;
+  NodeBase* tail = &sentinel;
+  appendChain(tail, sorted);
+  tail->next = &sentinel;
+  sentinel.prev = tail;
+}
 
-    if (sorted == nullptr || current->list_arr < sorted->list_arr) {
-      current->next = sorted;
-      sorted = current;
-    } else {
-      Node* temp = sorted;
-      while (temp->next != nullptr &&
-             !(current->list_arr < temp->next->list_arr)) {
-        temp = temp->next;
+// Сливает цепочку right в left (обе по next, отсортированы), результат
+// остаётся в left, right обнуляется. При равенстве первым идёт узел из
+// left, что и даёт устойчивость. Если comp бросит, в left оказываются все
+// узлы обеих цепочек, хотя и не по порядку.
+template <typename T, typename Allocator>
+template <typename Compare>
+void s21::list<T, Allocator>::mergeRuns(NodeBase*& left, NodeBase*& right,
+                                        Compare& comp) {
+  NodeBase* a = left;
+  NodeBase* b = right;
+  right = nullptr;
+  NodeBase* merged = nullptr;
+  NodeBase** link = &merged;
+  try {
+    while (a != nullptr && b != nullptr) {
+      if (comp(value(b), value(a))) {
+        *link = b;
+        b = b->next;
+      } else {
+        *link = a;
+        a = a->next;
       }
-      current->next = temp->next;
-      temp->next = current;
+      link = &(*link)->next;
     }
+  } catch (...) {
+    *link = a;
+    while (*link != nullptr) link = &(*link)->next;
+    *link = b;
+    left = merged;
+    throw;
+  }
+  *link = a != nullptr ? a : b;
+  left = merged;
+}
+
+// Пристраивает цепочку по next за tail, восстанавливая prev; tail
+// сдвигается на её последний узел.
+template <typename T, typename Allocator>
+void s21::list<T, Allocator>::appendChain(NodeBase*& tail,
+                                          NodeBase* chain) noexcept {
+  for (NodeBase* node = chain; node != nullptr; node = node->next) {
+    tail->next = node;
+    node->prev = tail;
+    tail = node;
   }
-  head = sorted;
-}
\ No newline at end of file
+}
+
+template <typename T, typename Allocator>
+template <typename... Args>
+typename s21::list<T, Allocator>::Node*
+s21::list<T, Allocator>::createNode(Args&&... args) {
+  Node* node = pool.allocate();
+  try {
+    new (node) Node(std::forward<Args>(args)...);
+  } catch (...) {
+    pool.deallocate(node);
+    throw;
+  }
+  return node;
+}
+
+template <typename T, typename Allocator>
+void s21::list<T, Allocator>::destroyNode(NodeBase* node) noexcept {
+  Node* full = static_cast<Node*>(node);
+  full->~Node();
+  pool.deallocate(full);
+}
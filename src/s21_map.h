@@ -1,329 +1,288 @@
 #ifndef S21_CONTAINERS_SRC_S21_MAP_H_
 #define S21_CONTAINERS_SRC_S21_MAP_H_
 
+#include <functional>
 #include <initializer_list>
 #include <iostream>
 #include <limits>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <tuple>
+
+#include "s21_tree.h"
 
 namespace s21 {
-template <typename Key, typename T>
+// Compare   - строгое слабое упорядочивание; прозрачный компаратор вроде
+//             std::less<> включает поиск по значениям других типов
+// Allocator - аллокатор пар; узлы выделяются его копией
+// Ranked    - хранить размеры поддеревьев ради nth(), rank() и count_range()
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>,
+          bool Ranked = false>
 class map {
  public:
+  using key_type = Key;
+  using mapped_type = T;
   using value_type = std::pair<const Key, T>;
   using reference = value_type &;
   using const_reference = const value_type &;
+  using size_type = size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+
+ private:
+  using tree_type = tree<Key, value_type, pair_first_key<value_type>, Compare,
+                         false, Ranked, Allocator>;
+
+ public:
+  using Node = typename tree_type::Node;
+  // operator-> итератора возвращает узел, поэтому значение доступно как
+  // it->data
+  using iterator =
+      typename tree_type::template Iterator<reference, const Node *>;
+  using const_iterator = typename tree_type::const_iterator;
+  using node_type = typename tree_type::node_type;
+  using insert_return_type = node_insert_return<iterator, node_type>;
 
-  struct Node {
-    value_type data;
-    Node *left;
-    Node *right;
-    Node *parent;
-
-    inline Node(const value_type &data) noexcept
-        : data(data), left(nullptr), right(nullptr), parent(nullptr) {}
-  };
-
-  class iterator {
-   public:
-    inline iterator(Node *current = nullptr) noexcept : current_(current) {}
-
-    reference operator*() const noexcept { return current_->data; }
-    const Node *operator->() const noexcept { return current_; }
-
-    iterator &operator++() noexcept {
-      if (current_->right) {  // Если есть правое поддерево, переходим к
-                              // минимальному элементу в нем
-        current_ = getMinNode(current_->right);
-      } else {  // Иначе, находим первого родителя, у которого текущий узел не
-                // находится в правом поддереве
-        Node *prev = current_;
-        current_ = current_->parent;
-        while (current_ && current_->right == prev) {
-          prev = current_;
-          current_ = current_->parent;
-        }
-      }
-      return *this;
-    }
-    iterator operator++(int) noexcept {
-      iterator temp = *this;
-      ++(*this);
-      return temp;
-    }
-
-    iterator &operator--() noexcept {
-      if (current_->left)  // Если есть левое поддерево, переходим к
-                           // минимальному элементу в нем
-        current_ = getMinNode(current_->left);
-
-      else {  // Иначе, находим первого родителя, у которого текущий узел не
-              // находится в левом поддереве
-        Node *prev = current_;
-        current_ = current_->parent;
-        while (current_ && current_->left == prev) {
-          prev = current_;
-          current_ = current_->parent;
-        }
-      }
-      return *this;
-    }
-
-    iterator operator--(int) {
-      iterator temp = *this;
-      --(*this);
-      return temp;
-    }
-
-    bool operator==(const iterator &other) const noexcept {
-      return current_ == other.current_;
-    }
-    bool operator!=(const iterator &other) const noexcept {
-      return current_ != other.current_;
-    }
-
-   private:
-    Node *current_;
-
-    Node *getMinNode(Node *node) const noexcept {
-      Node *current = node;
-      while (current->left) current = current->left;
-      return current;
-    }
-  };
   // default constructor, creates empty map
-  map() noexcept { rootPtr = nullptr, m_size = 0; }
+  map() noexcept {}
+  // creates an empty map whose nodes come from alloc
+  explicit map(const Allocator &alloc) : tree_(alloc) {}
   // initializer list constructor, creates the map initizialized using
   // std::initializer_list
   map(std::initializer_list<value_type> const &items) : map() {
-    for (const auto &item : items) insert(item);
+    insert(items.begin(), items.end());
   }
-  // copy constructor
-  map(const map &other) : map() {
-    for (const auto &item : other) insert(item);
+  // builds a map from a range sorted by key in O(n); of equal keys the first
+  // one is kept
+  template <typename InputIt>
+  static map from_sorted(InputIt first, InputIt last) {
+    map result;
+    result.assign_sorted(first, last);
+    return result;
   }
+  // copy constructor
+  map(const map &other) : tree_(other.tree_) {}
   // move constructor
-  map(map &&other) : map() { swap(other); }
+  map(map &&other) : tree_(std::move(other.tree_)) {}
   // destructor
-  ~map() { clear(); }
+  ~map() {}
 
   map &operator=(const map &other) {
-    clear();
-    for (const auto &item : other) insert(item);
+    tree_ = other.tree_;
     return *this;
   }
   // assignment operator overload for moving object
   map &operator=(map &&other) {
-    clear();
-    swap(other);
+    tree_ = std::move(other.tree_);
     return *this;
   }
 
   // access specified element with bounds checking
   inline T &at(const Key &key) const {
-    Node *node = findNode(key, rootPtr);
-    if (node)
-      return node->data.second;
-    else
-      throw std::out_of_range("Key not found");
+    auto it = tree_.find(key);
+    if (it == tree_.end()) throw std::out_of_range("Key not found");
+
+    return it->second;
   }
 
   // access or insert specified element
   inline T &operator[](const Key &key) {
-    Node *node = findNode(key, rootPtr);
-    if (node)
-      return node->data.second;
-    else {
-      value_type newKeyValue = std::make_pair(key, T());
-      insert(newKeyValue);
-      return findNode(key, rootPtr)->data.second;
-    }
+    return (*try_emplace(key).first).second;
   }
 
-  // returns an iterator to the beginning
-  inline iterator begin() const {
-    if (rootPtr != nullptr) return iterator(getMinNode(rootPtr));
-
-    return end();
+  inline T &operator[](Key &&key) {
+    return (*try_emplace(std::move(key)).first).second;
   }
+
+  // returns an iterator to the beginning
+  inline iterator begin() const noexcept { return iterator(tree_.begin()); }
   // returns an iterator to the end
-  inline iterator end() const noexcept { return iterator(nullptr); }
+  inline iterator end() const noexcept { return iterator(tree_.end()); }
 
   // checks whether the container is empty
-  inline bool empty() const noexcept { return m_size == 0; }
+  inline bool empty() const noexcept { return tree_.empty(); }
   // returns the number of elements
-  inline size_t size() const noexcept { return m_size; }
+  inline size_t size() const noexcept { return tree_.size(); }
   // returns the maximum possible number of elements
-  inline size_t max_size() const { return std::numeric_limits<size_t>::max(); }
+  inline size_t max_size() const { return tree_.max_size(); }
+  // returns the function that compares keys
+  inline key_compare key_comp() const { return tree_.key_comp(); }
+  // returns the allocator the nodes come from
+  inline allocator_type get_allocator() const { return tree_.get_allocator(); }
 
   // clears the contents
-  inline void clear() {
-    clearNodes(rootPtr);
-    m_size = 0;
+  inline void clear() { tree_.clear(); }
+
+  // replaces the contents with a range sorted by key in O(n); throws
+  // std::invalid_argument and keeps the old contents if it is not sorted
+  template <typename InputIt>
+  void assign_sorted(InputIt first, InputIt last) {
+    tree_.assign_sorted(first, last);
   }
 
   // inserts node and returns iterator to where the element is in the container
   // and bool denoting whether the insertion took place
   std::pair<iterator, bool> insert(const value_type &value) {
-    Node *newNode = new Node(value);
-    Node *parent = nullptr;
-    Node *current = rootPtr;
-
-    while (current) {
-      parent = current;
-      if (value.first < current->data.first)
-        current = current->left;
-
-      else if (value.first > current->data.first)
-        current = current->right;
-
-      else {
-        delete newNode;
-        return std::make_pair(iterator(current), false);
-      }
-    }
-
-    newNode->parent = parent;
-
-    if (!parent)
-      rootPtr = newNode;
-
-    else if (value.first < parent->data.first)
-      parent->left = newNode;
+    auto result = tree_.insert(value);
+    return std::make_pair(iterator(result.first), result.second);
+  }
 
-    else
-      parent->right = newNode;
+  std::pair<iterator, bool> insert(value_type &&value) {
+    auto result = tree_.insert(std::move(value));
+    return std::make_pair(iterator(result.first), result.second);
+  }
 
-    m_size++;
-    return std::make_pair(iterator(newNode), true);
+  // inserts an extracted node without allocating; if the key exists the
+  // node is handed back in the result
+  insert_return_type insert(node_type &&node) {
+    auto result = tree_.insert(std::move(node));
+    return {iterator(result.first), result.second, std::move(node)};
   }
 
   // inserts value by key and returns iterator to where the element is in the
   // container and bool denoting whether the insertion took place
   std::pair<iterator, bool> insert(const Key &key, const T &obj) {
-    return insert(std::make_pair(key, obj));
+    return try_emplace(key, obj);
+  }
+
+  // inserts a range; large batches are sorted and merged in with one
+  // rebuild of the tree
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last) {
+    tree_.insert(first, last);
   }
 
   // inserts an element or assigns to the current element if the key already
   // exists
   std::pair<iterator, bool> insert_or_assign(const Key &key, const T &obj) {
-    Node *node = findNode(key, rootPtr);
-    if (node) {
-      node->data.second = obj;
-      return std::make_pair(iterator(node), false);
-    } else
-      return insert(std::make_pair(key, obj));
+    auto result = try_emplace(key, obj);
+    if (!result.second) (*result.first).second = obj;
+
+    return result;
   }
 
-  // erases element at pos
-  void erase(iterator pos) {
-    const Node *node = pos.operator->();
-
-    // Если удаляемый узел не имеет детей или имеет только одно дитя
-    if (!node->left)
-      transplant(const_cast<Node *>(node),
-                 const_cast<Node *>(node->right));  // явное приведение типов
-    else if (!node->right)
-      transplant(const_cast<Node *>(node),
-                 const_cast<Node *>(node->left));  // явное приведение типов
-
-    else {  // Если удаляемый узел имеет двух детей, заменяем его следующим
-            // узлом в отсортированном порядке
-      Node *successor = getMinNode(
-          const_cast<Node *>(node->right));  // явное приведение типов
-      if (successor->parent != node) {
-        transplant(
-            const_cast<Node *>(successor),
-            const_cast<Node *>(successor->right));  // явное приведение типов
-        successor->right = node->right;
-        successor->right->parent = successor;
-      }
-      transplant(const_cast<Node *>(node),
-                 const_cast<Node *>(successor));  // явное приведение типов
-      successor->left = node->left;
-      successor->left->parent = successor;
-    }
-
-    delete node;
-    m_size--;
+  // constructs the element in place; the node is discarded if the key exists
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    auto result = tree_.emplace(std::forward<Args>(args)...);
+    return std::make_pair(iterator(result.first), result.second);
   }
 
-  // swaps the contents
-  inline void swap(map &other) {
-    std::swap(rootPtr, other.rootPtr);
-    std::swap(m_size, other.m_size);
+  // constructs the mapped value from args only if key is not present yet
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key &key, Args &&...args) {
+    auto result = tree_.try_emplace(
+        key, std::piecewise_construct, std::forward_as_tuple(key),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+    return std::make_pair(iterator(result.first), result.second);
   }
 
-  // splices nodes from another container
-  void merge(map &other) {
-    if (this != &other) {
-      for (const auto &item : other) insert(item);
-      other.clear();
-    }
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(Key &&key, Args &&...args) {
+    auto result = tree_.try_emplace(
+        key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+    return std::make_pair(iterator(result.first), result.second);
   }
 
-  bool contains(const Key &key) const noexcept {
-    Node *current = rootPtr;
+  // erases element at pos
+  void erase(iterator pos) { tree_.erase(pos); }
+  // erases elements in [first, last), returns last
+  iterator erase(iterator first, iterator last) {
+    return tree_.erase(first, last);
+  }
 
-    while (current != nullptr) {
-      if (key == current->data.first)
-        return true;
-      else if (key < current->data.first)
-        current = current->left;
-      else
-        current = current->right;
-    }
+  // unlinks the element at pos and returns it as a node handle
+  node_type extract(iterator pos) { return tree_.extract(pos); }
+  // unlinks the element with key, if any
+  node_type extract(const Key &key) { return tree_.extract(key); }
 
-    return false;
-  }
+  // swaps the contents
+  inline void swap(map &other) { tree_.swap(other.tree_); }
 
- private:
-  Node *rootPtr;
-  size_t m_size;
-
-  inline Node *findNode(const Key &key, Node *node) const {
-    if (node == nullptr || key == node->data.first) return node;
-    if (key < node->data.first)
-      return findNode(key, node->left);
-    else
-      return findNode(key, node->right);
-  }
+  // splices nodes from another container without allocating; elements whose
+  // keys are already present stay in other
+  void merge(map &other) { tree_.merge(other.tree_); }
+
+  // finds element with specific key
+  iterator find(const Key &key) const { return iterator(tree_.find(key)); }
+  // returns the number of elements with key, 0 or 1
+  size_type count(const Key &key) const { return tree_.count(key); }
+  bool contains(const Key &key) const noexcept { return tree_.contains(key); }
 
-  inline void clearNodes(Node *&node) {
-    if (node != nullptr) {
-      clearNodes(node->left);
-      clearNodes(node->right);
-      delete node;
-      node = nullptr;
-    }
+  // returns an iterator to the first element with key not less than key
+  iterator lower_bound(const Key &key) const {
+    return iterator(tree_.lower_bound(key));
+  }
+  // returns an iterator to the first element with key greater than key
+  iterator upper_bound(const Key &key) const {
+    return iterator(tree_.upper_bound(key));
+  }
+  // returns the range of elements with the given key
+  std::pair<iterator, iterator> equal_range(const Key &key) const {
+    return {lower_bound(key), upper_bound(key)};
   }
 
-  Node *getMinNode(Node *node) const {
-    Node *current = node;
+  // lookup by any type comparable with Key, enabled by a transparent
+  // Compare such as std::less<>: find(std::string_view) on a
+  // map<std::string, T, std::less<>> builds no temporary string
+  template <typename K, typename C = Compare, if_transparent<C> = 0>
+  iterator find(const K &key) const { return iterator(tree_.find(key)); }
 
-    while (current->left) current = current->left;
+  template <typename K, typename C = Compare, if_transparent<C> = 0>
+  size_type count(const K &key) const { return tree_.count(key); }
 
-    return current;
-  }
+  template <typename K, typename C = Compare, if_transparent<C> = 0>
+  bool contains(const K &key) const { return tree_.contains(key); }
 
-  inline void transplant(Node *oldNode, Node *newNode) {
-    if (!oldNode->parent)
-      rootPtr = newNode;
+  template <typename K, typename C = Compare, if_transparent<C> = 0>
+  iterator lower_bound(const K &key) const {
+    return iterator(tree_.lower_bound(key));
+  }
 
-    else if (oldNode == oldNode->parent->left)
-      oldNode->parent->left = newNode;
+  template <typename K, typename C = Compare, if_transparent<C> = 0>
+  iterator upper_bound(const K &key) const {
+    return iterator(tree_.upper_bound(key));
+  }
 
-    else
-      oldNode->parent->right = newNode;
+  template <typename K, typename C = Compare, if_transparent<C> = 0>
+  std::pair<iterator, iterator> equal_range(const K &key) const {
+    return {lower_bound(key), upper_bound(key)};
+  }
 
-    if (newNode) newNode->parent = oldNode->parent;
+  // returns the k-th element in key order, or end() if k >= size(); O(log n),
+  // available only when Ranked is set
+  iterator nth(size_type k) const { return iterator(tree_.nth(k)); }
+  // returns the number of elements with keys less than key
+  size_type rank(const Key &key) const { return tree_.rank(key); }
+  // returns the number of elements with keys in [lo, hi)
+  size_type count_range(const Key &lo, const Key &hi) const {
+    return tree_.count_range(lo, hi);
   }
+
+ private:
+  tree_type tree_;
 };
 
-template <typename... Args>
-inline void insert_many(map<int, std::string> &myMap, Args &&...args) {
-  (myMap.insert(std::forward<Args>(args)), ...);
+template <typename Key, typename T, typename Compare = std::less<Key>>
+using ranked_map =
+    map<Key, T, Compare, std::allocator<std::pair<const Key, T>>, true>;
+
+namespace pmr {
+template <typename Key, typename T, typename Compare = std::less<Key>>
+using map = s21::map<Key, T, Compare,
+                     std::pmr::polymorphic_allocator<std::pair<const Key, T>>>;
+}  // namespace pmr
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          bool Ranked, typename... Args>
+inline void insert_many(map<Key, T, Compare, Allocator, Ranked> &myMap,
+                        Args &&...args) {
+  (myMap.emplace(std::forward<Args>(args)), ...);
 }
 
 }  // namespace s21
 
-#endif  //  S21_CONTAINERS_SRC_S21_MAP_H_
\ No newline at end of file
+#endif  //  S21_CONTAINERS_SRC_S21_MAP_H_
@@ -0,0 +1,165 @@
+#ifndef S21_CONTAINERS_SRC_S21_MPMC_QUEUE_H_
+#define S21_CONTAINERS_SRC_S21_MPMC_QUEUE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "s21_cache_line.h"
+
+namespace s21 {
+
+// Ограниченная очередь без блокировок для многих писателей и читателей
+// (кольцо с номерами последовательности, схема Д. Вьюкова). У каждой
+// ячейки свой счетчик sequence:
+//   sequence == pos          - ячейка свободна для записи с номером pos;
+//   sequence == pos + 1      - в ней лежит элемент с номером pos;
+//   sequence == pos + Capacity - элемент забран, ячейка ждет записи
+//                              следующего круга.
+// Писатель захватывает номер CAS-ом по enqueue_, читатель - по dequeue_,
+// а публикует результат release-записью в sequence своей ячейки. Так
+// писатели и читатели конкурируют только между собой, а не друг с другом.
+//
+// Элемент строится до захвата ячейки и переносится в нее перемещением:
+// захваченную ячейку нельзя оставить пустой, иначе читатель этого круга
+// будет ждать ее вечно. Поэтому перемещение T не должно бросать.
+template <typename T, std::size_t Capacity>
+class mpmc_queue {
+  static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                "mpmc_queue capacity must be a power of two, at least 2");
+  static_assert(std::is_nothrow_move_constructible_v<T> &&
+                    std::is_nothrow_move_assignable_v<T>,
+                "mpmc_queue elements must be nothrow movable");
+
+ public:
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = std::size_t;
+
+  mpmc_queue() noexcept {
+    for (size_type i = 0; i < Capacity; ++i)
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+  mpmc_queue(const mpmc_queue &) = delete;
+  mpmc_queue &operator=(const mpmc_queue &) = delete;
+
+  ~mpmc_queue() {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      size_type pos;
+      while (Cell *cell = claim(dequeue_, 1, pos)) cell->item()->~value_type();
+    }
+  }
+
+  // non-blocking; return false when the queue is full, an rvalue argument
+  // is then left untouched
+  inline bool try_push(const_reference value) { return try_emplace(value); }
+  inline bool try_push(value_type &&value) { return place(value); }
+
+  template <typename... Args>
+  bool try_emplace(Args &&...args) {
+    value_type value(std::forward<Args>(args)...);
+    return place(value);
+  }
+
+  // non-blocking; returns false when the queue is empty
+  bool try_pop(reference out) noexcept {
+    size_type pos;
+    Cell *cell = claim(dequeue_, 1, pos);
+    if (cell == nullptr) return false;
+    T *item = cell->item();
+    out = std::move(*item);
+    item->~value_type();
+    cell->sequence.store(pos + Capacity, std::memory_order_release);
+    return true;
+  }
+
+  // blocking forms: wait while the queue is full (push) or empty (pop)
+  inline void push(const_reference value) { emplace(value); }
+  inline void push(value_type &&value) {
+    for (unsigned spins = 0; !place(value); ++spins) backoff(spins);
+  }
+
+  template <typename... Args>
+  void emplace(Args &&...args) {
+    value_type value(std::forward<Args>(args)...);
+    for (unsigned spins = 0; !place(value); ++spins) backoff(spins);
+  }
+
+  void pop(reference out) noexcept {
+    for (unsigned spins = 0; !try_pop(out); ++spins) backoff(spins);
+  }
+
+  // snapshots: other threads may change the queue right after the call
+  inline bool empty() const noexcept { return size() == 0; }
+
+  inline size_type size() const noexcept {
+    const size_type head = dequeue_.load(std::memory_order_acquire);
+    const size_type tail = enqueue_.load(std::memory_order_acquire);
+    // между чтениями читатели могли уйти вперед
+    return tail > head ? tail - head : 0;
+  }
+
+  static constexpr size_type capacity() noexcept { return Capacity; }
+
+ private:
+  struct alignas(kCacheLineSize) Cell {
+    std::atomic<size_type> sequence;
+    alignas(T) unsigned char bytes[sizeof(T)];
+
+    inline T *item() noexcept {
+      return std::launder(reinterpret_cast<T *>(bytes));
+    }
+  };
+
+  // Захватывает следующий номер pos счетчика counter. Ячейка готова, когда
+  // ее sequence равен pos + ready (0 - для записи, 1 - для чтения). Если
+  // sequence отстает, очередь полна или пуста и возвращается nullptr; если
+  // обгоняет, номер уже забрал другой поток.
+  Cell *claim(std::atomic<size_type> &counter, size_type ready,
+              size_type &pos) noexcept {
+    pos = counter.load(std::memory_order_relaxed);
+    for (;;) {
+      Cell &cell = cells_[pos & (Capacity - 1)];
+      const size_type sequence = cell.sequence.load(std::memory_order_acquire);
+      const auto lag = static_cast<std::ptrdiff_t>(sequence - (pos + ready));
+      if (lag == 0) {
+        if (counter.compare_exchange_weak(pos, pos + 1,
+                                          std::memory_order_relaxed))
+          return &cell;
+      } else if (lag < 0) {
+        return nullptr;
+      } else {
+        pos = counter.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // moves value into the next free cell; value is left intact when full
+  bool place(value_type &value) noexcept {
+    size_type pos;
+    Cell *cell = claim(enqueue_, 0, pos);
+    if (cell == nullptr) return false;
+    new (cell->item()) value_type(std::move(value));
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  // короткое ожидание на месте, затем уступаем процессор
+  static void backoff(unsigned spins) noexcept {
+    if (spins >= kSpinLimit) std::this_thread::yield();
+  }
+
+  static constexpr unsigned kSpinLimit = 64;
+
+  alignas(kCacheLineSize) std::atomic<size_type> enqueue_{0};
+  alignas(kCacheLineSize) std::atomic<size_type> dequeue_{0};
+  Cell cells_[Capacity];
+};
+
+}  // namespace s21
+
+#endif  // S21_CONTAINERS_SRC_S21_MPMC_QUEUE_H_
@@ -1,408 +1,517 @@
 #ifndef S21_CONTAINERS_SRC_S21_MULTISET_H_
 #define S21_CONTAINERS_SRC_S21_MULTISET_H_
 
+#include <functional>
 #include <initializer_list>
+#include <iterator>
 #include <limits>
+#include <memory>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+#include "s21_tree.h"
 
 namespace s21 {
-template <typename Key>
+// Compare   - строгое слабое упорядочивание; прозрачный компаратор вроде
+//             std::less<> включает поиск по значениям других типов
+// Allocator - аллокатор ключей; узлы выделяются его копией
+// Ranked    - хранить размеры поддеревьев ради nth(), rank() и count_range()
+// Compact   - хранить равные ключи в одном узле со счетчиком копий (см.
+//             специализацию ниже)
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>, bool Ranked = false,
+          bool Compact = false>
 class multiset {
+  static_assert(!Compact, "compact multiset does not support Ranked");
+
  private:
-  struct Node {
-    Key key;
-    size_t count;
-    Node *left;
-    Node *right;
-    Node *parent;
+  using tree_type =
+      tree<Key, Key, identity_key<Key>, Compare, true, Ranked, Allocator>;
 
-    Node(Key key)
-        : key(key), count(1), left(nullptr), right(nullptr), parent(nullptr) {}
-  };
+  tree_type tree_;
 
-  Node *rootPtr;
-  size_t m_size;
+ public:
+  using iterator = typename tree_type::iterator;
+  using const_iterator = typename tree_type::const_iterator;
 
-  void clear(Node *node) {
-    if (node == nullptr) {
-      return;
-    }
-    clear(node->left);
-    clear(node->right);
-    delete node;
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using node_type = typename tree_type::node_type;
+
+  multiset() noexcept {}
+
+  explicit multiset(const Allocator &alloc) : tree_(alloc) {}
+
+  multiset(std::initializer_list<Key> const &items) : multiset() {
+    insert(items.begin(), items.end());
+  }
+
+  template <typename InputIt>
+  static multiset from_sorted(InputIt first, InputIt last) {
+    multiset ms;
+    ms.assign_sorted(first, last);
+    return ms;
   }
 
-  inline Node *copy(Node *node, Node *parent) {
-    if (node == nullptr) return nullptr;
+  multiset(const multiset &ms) : tree_(ms.tree_) {}
+
+  multiset(multiset &&ms) : tree_(std::move(ms.tree_)) {}
+
+  ~multiset() {}
 
-    Node *new_node = new Node(node->key);
-    new_node->count = node->count;
-    new_node->left = copy(node->left, new_node);
-    new_node->right = copy(node->right, new_node);
-    new_node->parent = parent;
-    return new_node;
+  multiset &operator=(multiset &&ms) {
+    tree_ = std::move(ms.tree_);
+    return *this;
   }
 
-  void erase_node(Node *node) {
-    if (node->left == nullptr && node->right == nullptr) {
-      if (node->parent == nullptr)
-        rootPtr = nullptr;
+  inline iterator begin() const noexcept { return tree_.begin(); }
 
-      else if (node->parent->left == node)
-        node->parent->left = nullptr;
+  inline iterator end() const noexcept { return tree_.end(); }
 
-      else
-        node->parent->right = nullptr;
+  inline bool empty() const noexcept { return tree_.empty(); }
 
-    }
+  inline size_t size() const noexcept { return tree_.size(); }
 
-    else if (node->left == nullptr) {
-      if (node->parent == nullptr) {
-        rootPtr = node->right;
-        rootPtr->parent = nullptr;
-      }
+  inline size_t max_size() { return std::numeric_limits<size_t>::max(); }
 
-      else if (node->parent->left == node) {
-        node->parent->left = node->right;
-        node->right->parent = node->parent;
-      }
+  inline key_compare key_comp() const { return tree_.key_comp(); }
 
-      else {
-        node->parent->right = node->right;
-        node->right->parent = node->parent;
-      }
-    }
+  inline allocator_type get_allocator() const { return tree_.get_allocator(); }
 
-    else if (node->right == nullptr) {
-      if (node->parent == nullptr) {
-        rootPtr = node->left;
-        rootPtr->parent = nullptr;
-      }
+  inline void clear() { tree_.clear(); }
 
-      else if (node->parent->left == node) {
-        node->parent->left = node->left;
-        node->left->parent = node->parent;
-      }
+  template <typename InputIt>
+  inline void assign_sorted(InputIt first, InputIt last) {
+    tree_.assign_sorted(first, last);
+  }
 
-      else {
-        node->parent->right = node->left;
-        node->left->parent = node->parent;
-      }
-    }
+  inline iterator insert(const Key &value) {
+    return tree_.insert(value).first;
+  }
 
-    else {
-      Node *successor = node->right;
-      while (successor->left != nullptr) successor = successor->left;
+  inline iterator insert(Key &&value) {
+    return tree_.insert(std::move(value)).first;
+  }
 
-      node->key = successor->key;
-      node->count = successor->count;
-      erase_node(successor);
-    }
-    delete node;
+  template <typename InputIt>
+  inline void insert(InputIt first, InputIt last) {
+    tree_.insert(first, last);
   }
 
-  Node *find_node(const Key &key) const {
-    Node *current = rootPtr;
-    while (current != nullptr) {
-      if (key < current->key)
-        current = current->left;
-      else if (key > current->key)
-        current = current->right;
-      else
-        return current;
-    }
-    return nullptr;
+  inline iterator insert(node_type &&node) {
+    return tree_.insert(std::move(node)).first;
   }
 
-  Node *lower_bound_helper(const Key &key) const {
-    Node *current = rootPtr;
-    Node *lower_bound = nullptr;
-    while (current != nullptr) {
-      if (key <= current->key) {
-        lower_bound = current;
-        current = current->left;
-      }
+  template <typename... Args>
+  inline iterator emplace(Args &&...args) {
+    return tree_.emplace(std::forward<Args>(args)...).first;
+  }
 
-      else
-        current = current->right;
-    }
-    return lower_bound;
+  inline void erase(iterator pos) { tree_.erase(pos); }
+
+  inline iterator erase(iterator first, iterator last) {
+    return tree_.erase(first, last);
   }
 
-  Node *upper_bound_helper(const Key &key) const {
-    Node *current = rootPtr;
-    Node *upper_bound = nullptr;
-    while (current != nullptr) {
-      if (key < current->key) {
-        upper_bound = current;
-        current = current->left;
-      }
+  inline node_type extract(iterator pos) { return tree_.extract(pos); }
 
-      else
-        current = current->right;
-    }
-    return upper_bound;
+  inline node_type extract(const Key &key) { return tree_.extract(key); }
+
+  inline void swap(multiset &other) { tree_.swap(other.tree_); }
+
+  // relinks all nodes of other without allocating
+  inline void merge(multiset &other) { tree_.merge(other.tree_); }
+
+  inline size_t count(const Key &key) const { return tree_.count(key); }
+
+  inline iterator find(const Key &key) const { return tree_.find(key); }
+
+  inline bool contains(const Key &key) const { return tree_.contains(key); }
+
+  inline std::pair<iterator, iterator> equal_range(const Key &key) const {
+    return tree_.equal_range(key);
   }
 
-  void merge_helper(multiset &other, Node *node) {
-    if (node != nullptr) {
-      insert(node->key);
-      merge_helper(other, node->left);
-      merge_helper(other, node->right);
-      other.erase_node(node);
-    }
+  inline iterator lower_bound(const Key &key) const {
+    return tree_.lower_bound(key);
   }
 
- public:
-  class iterator {
-   public:
-    Node *node;
+  inline iterator upper_bound(const Key &key) const {
+    return tree_.upper_bound(key);
+  }
 
-    iterator(Node *node) : node(node) {}
+  template <typename K, typename C = Compare, if_transparent<C> = 0>
+  inline size_t count(const K &key) const { return tree_.count(key); }
 
-    iterator &operator++() {
-      if (node->right == nullptr) {
-        while (node->parent != nullptr && node->parent->right == node)
-          node = node->parent;
+  template <typename K, typename C = Compare, if_transparent<C> = 0>
+  inline iterator find(const K &key) const { return tree_.find(key); }
 
-        node = node->parent;
-      }
+  template <typename K, typename C = Compare, if_transparent<C> = 0>
+  inline bool contains(const K &key) const { return tree_.contains(key); }
 
-      else {
-        node = node->right;
-        while (node->left != nullptr) node = node->left;
-      }
-      return *this;
-    }
+  template <typename K, typename C = Compare, if_transparent<C> = 0>
+  inline std::pair<iterator, iterator> equal_range(const K &key) const {
+    return tree_.equal_range(key);
+  }
 
-    iterator operator++(int) {
-      iterator temp = *this;
-      ++(*this);
-      return temp;
-    }
+  template <typename K, typename C = Compare, if_transparent<C> = 0>
+  inline iterator lower_bound(const K &key) const {
+    return tree_.lower_bound(key);
+  }
 
-    iterator &operator--() {
-      if (node->left == nullptr) {
-        while (node->parent != nullptr && node->parent->left == node)
-          node = node->parent;
-        node = node->parent;
-      }
+  template <typename K, typename C = Compare, if_transparent<C> = 0>
+  inline iterator upper_bound(const K &key) const {
+    return tree_.upper_bound(key);
+  }
 
-      else {
-        node = node->left;
-        while (node->right != nullptr) node = node->right;
-      }
-      return *this;
-    }
+  inline iterator nth(size_t k) const { return tree_.nth(k); }
 
-    iterator operator--(int) {
-      iterator temp = *this;
-      --(*this);
-      return temp;
-    }
+  inline size_t rank(const Key &key) const { return tree_.rank(key); }
 
-    Key &operator*() const { return node->key; }
+  inline size_t count_range(const Key &lo, const Key &hi) const {
+    return tree_.count_range(lo, hi);
+  }
+};
 
-    Key *operator->() const { return &(node->key); }
+// Компактный multiset: все копии ключа живут в одном узле уникального
+// дерева вместе со счетчиком, поэтому память растет с числом различных
+// ключей, а не с числом вставок. Итератор - пара (узел, номер копии) и
+// по-прежнему проходит каждую копию. count() и erase(key) работают за
+// O(log n), erase(pos) лишь уменьшает счетчик узла. Узлы не извлекаются
+// поштучно, поэтому extract() и node_type здесь нет.
+template <typename Key, typename Compare, typename Allocator>
+class multiset<Key, Compare, Allocator, false, true> {
+ private:
+  struct Entry {
+    Entry(const Key &k, std::size_t n) : key(k), copies(n) {}
+    Entry(Key &&k, std::size_t n) : key(std::move(k)), copies(n) {}
 
-    bool operator==(const iterator &other) const { return node == other.node; }
+    Key key;
+    std::size_t copies;
+  };
 
-    bool operator!=(const iterator &other) const { return node != other.node; }
+  struct EntryKey {
+    inline const Key &operator()(const Entry &entry) const noexcept {
+      return entry.key;
+    }
   };
 
-  class const_iterator {
-   private:
-    const Node *node;
+  using tree_type = tree<Key, Entry, EntryKey, Compare, false, false,
+                         typename std::allocator_traits<
+                             Allocator>::template rebind_alloc<Entry>>;
+  using node_iterator = typename tree_type::iterator;
 
+  tree_type tree_;
+  std::size_t size_ = 0;
+
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+
+  class iterator {
    public:
-    const_iterator(const Node *node) : node(node) {}
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Key;
+    using difference_type = std::ptrdiff_t;
+    using reference = const Key &;
+    using pointer = const Key *;
 
-    const_iterator &operator++() {
-      if (node->right == nullptr) {
-        while (node->parent != nullptr && node->parent->right == node)
-          node = node->parent;
+    iterator() noexcept : node_(), copy_(0) {}
 
-        node = node->parent;
-      }
+    inline reference operator*() const noexcept { return node_->key; }
+    inline pointer operator->() const noexcept { return &node_->key; }
 
-      else {
-        node = node->right;
-        while (node->left != nullptr) node = node->left;
+    iterator &operator++() noexcept {
+      if (++copy_ == node_->copies) {
+        ++node_;
+        copy_ = 0;
       }
       return *this;
     }
 
-    const_iterator operator++(int) {
-      const_iterator temp = *this;
+    inline iterator operator++(int) noexcept {
+      iterator temp = *this;
       ++(*this);
       return temp;
     }
 
-    const_iterator &operator--() {
-      if (node->left == nullptr) {
-        while (node->parent != nullptr && node->parent->left == node)
-          node = node->parent;
-
-        node = node->parent;
-      }
-
-      else {
-        node = node->left;
-        while (node->right != nullptr) node = node->right;
+    iterator &operator--() noexcept {
+      if (copy_ == 0) {
+        --node_;
+        copy_ = node_->copies - 1;
+      } else {
+        --copy_;
       }
       return *this;
     }
 
-    const_iterator operator--(int) {
-      const_iterator temp = *this;
+    inline iterator operator--(int) noexcept {
+      iterator temp = *this;
       --(*this);
       return temp;
     }
 
-    const Key &operator*() const { return node->key; }
-
-    const Key *operator->() const { return &(node->key); }
-
-    bool operator==(const const_iterator &other) const {
-      return node == other.node;
+    inline bool operator==(const iterator &other) const noexcept {
+      return node_ == other.node_ && copy_ == other.copy_;
     }
 
-    bool operator!=(const const_iterator &other) const {
-      return node != other.node;
+    inline bool operator!=(const iterator &other) const noexcept {
+      return !(*this == other);
     }
+
+   private:
+    iterator(node_iterator node, size_type copy) noexcept
+        : node_(node), copy_(copy) {}
+
+    node_iterator node_;
+    size_type copy_;
+
+    friend class multiset;
   };
 
-  multiset() noexcept : rootPtr(nullptr), m_size(0) {}
+  using const_iterator = iterator;
+
+  multiset() noexcept {}
 
   multiset(std::initializer_list<Key> const &items) : multiset() {
-    for (const Key &item : items) insert(item);
+    insert(items.begin(), items.end());
+  }
+
+  // серии равных ключей сворачиваются в счетчики, дерево строится за O(n)
+  template <typename InputIt>
+  static multiset from_sorted(InputIt first, InputIt last) {
+    multiset ms;
+    ms.assign_sorted(first, last);
+    return ms;
   }
 
-  multiset(const multiset &ms)
-      : rootPtr(copy(ms.rootPtr, nullptr)), m_size(ms.m_size) {}
+  multiset(const multiset &ms) : tree_(ms.tree_), size_(ms.size_) {}
 
-  multiset(multiset &&ms) : rootPtr(ms.rootPtr), m_size(ms.m_size) {
-    ms.rootPtr = nullptr;
-    ms.m_size = 0;
+  explicit multiset(const Allocator &alloc) : tree_(alloc) {}
+
+  multiset(multiset &&ms) : tree_(std::move(ms.tree_)), size_(ms.size_) {
+    ms.size_ = 0;
   }
 
-  ~multiset() { clear(); }
+  ~multiset() {}
 
   multiset &operator=(multiset &&ms) {
-    clear();
-    rootPtr = ms.rootPtr;
-    m_size = ms.m_size;
-    ms.rootPtr = nullptr;
-    ms.m_size = 0;
+    tree_ = std::move(ms.tree_);
+    size_ = ms.size_;
+    ms.size_ = 0;
     return *this;
   }
 
-  iterator begin() const noexcept {
-    Node *current = rootPtr;
-    while (current != nullptr && current->left != nullptr)
-      current = current->left;
-
-    return iterator(current);
-  }
+  inline iterator begin() const noexcept { return {tree_.begin(), 0}; }
 
-  inline iterator end() const noexcept { return iterator(nullptr); }
+  inline iterator end() const noexcept { return {tree_.end(), 0}; }
 
-  inline bool empty() const noexcept { return m_size == 0; }
+  inline bool empty() const noexcept { return size_ == 0; }
 
-  inline size_t size() const noexcept { return m_size; }
+  inline size_t size() const noexcept { return size_; }
 
   inline size_t max_size() { return std::numeric_limits<size_t>::max(); }
 
+  // число различных ключей, то есть занятых узлов
+  inline size_t distinct_size() const noexcept { return tree_.size(); }
+
+  inline key_compare key_comp() const { return tree_.key_comp(); }
+
+  inline allocator_type get_allocator() const {
+    return allocator_type(tree_.get_allocator());
+  }
+
   inline void clear() {
-    clear(rootPtr);
-    rootPtr = nullptr;
-    m_size = 0;
-  }
-
-  iterator insert(const Key &value) {
-    Node *current = rootPtr;
-    Node *parent = nullptr;
-    while (current != nullptr) {
-      parent = current;
-      if (value < current->key)
-        current = current->left;
+    tree_.clear();
+    size_ = 0;
+  }
+
+  template <typename InputIt>
+  void assign_sorted(InputIt first, InputIt last) {
+    std::vector<Entry> runs;
+    size_t total = 0;
+    auto comp = tree_.key_comp();
+    for (; first != last; ++first, ++total) {
+      if (!runs.empty() && !comp(runs.back().key, *first) &&
+          !comp(*first, runs.back().key))
+        ++runs.back().copies;
       else
-        current = current->right;
+        runs.emplace_back(*first, 1);
     }
-    Node *node = new Node(value);
-    node->parent = parent;
-    if (parent == nullptr)
-      rootPtr = node;
-    else if (value < parent->key)
-      parent->left = node;
-    else
-      parent->right = node;
-    m_size++;
-    return iterator(node);
+    tree_.assign_sorted(runs.begin(), runs.end());
+    size_ = total;
   }
 
-  inline void erase(iterator pos) {
-    Node *node = pos.node;
-    erase_node(node);
-    m_size--;
+  inline iterator insert(const Key &value) { return insert_copies(value, 1); }
+
+  inline iterator insert(Key &&value) {
+    return insert_copies(std::move(value), 1);
   }
 
-  inline void swap(multiset &other) {
-    std::swap(rootPtr, other.rootPtr);
-    std::swap(m_size, other.m_size);
+  template <typename InputIt>
+  inline void insert(InputIt first, InputIt last) {
+    for (; first != last; ++first) insert(*first);
   }
 
-  inline void merge(multiset &other) {
-    if (this != &other) merge_helper(other, other.rootPtr);
+  template <typename... Args>
+  inline iterator emplace(Args &&...args) {
+    return insert(Key(std::forward<Args>(args)...));
+  }
 
-    other.clear();
+  // удаляет одну копию; узел освобождается вместе с последней
+  void erase(iterator pos) {
+    --size_;
+    if (--pos.node_->copies == 0) tree_.erase(pos.node_);
   }
 
-  size_t count(const Key &key) const {
-    size_t count = 0;
-    Node *current = rootPtr;
-    while (current != nullptr) {
-      if (key == current->key) count += current->count;
+  // удаляет все копии key за O(log n) и возвращает их число
+  size_type erase(const Key &key) {
+    node_iterator node = tree_.find(key);
+    if (node == tree_.end()) return 0;
+    const size_type removed = node->copies;
+    tree_.erase(node);
+    size_ -= removed;
+    return removed;
+  }
 
-      if (key < current->key)
-        current = current->left;
+  void swap(multiset &other) {
+    tree_.swap(other.tree_);
+    std::swap(size_, other.size_);
+  }
 
-      else
-        current = current->right;
+  // Переносит все копии other без выделения памяти. Для ключа, который
+  // здесь уже есть, к счетчику прибавляются копии other, а узел other
+  // удаляется; узлы с новыми ключами перевешиваются целиком. Узел other
+  // не трогается, пока не отвязан от него, поэтому исключение из
+  // сравнения оставляет оба контейнера целыми.
+  void merge(multiset &other) {
+    if (&other == this) return;
+    for (node_iterator it = other.tree_.begin(); it != other.tree_.end();) {
+      node_iterator mine = tree_.find(it->key);
+      if (mine == tree_.end()) {
+        ++it;
+        continue;
+      }
+      mine->copies += it->copies;
+      size_ += it->copies;
+      other.size_ -= it->copies;
+      it = other.tree_.erase(it);
     }
-    return count;
+    try {
+      tree_.merge(other.tree_);
+    } catch (...) {
+      const size_type stayed = other.countNodes();
+      size_ += other.size_ - stayed;
+      other.size_ = stayed;
+      throw;
+    }
+    size_ += other.size_;
+    other.size_ = 0;
   }
 
-  inline iterator find(const Key &key) const {
-    Node *node = find_node(key);
-    return iterator(node);
-  }
+  inline size_t count(const Key &key) const { return countCopies(key); }
 
-  inline bool contains(const Key &key) const {
-    return find_node(key) != nullptr;
-  }
+  inline iterator find(const Key &key) const { return {tree_.find(key), 0}; }
+
+  inline bool contains(const Key &key) const { return tree_.contains(key); }
 
   inline std::pair<iterator, iterator> equal_range(const Key &key) const {
-    return std::make_pair(iterator(lower_bound(key)),
-                          iterator(upper_bound(key)));
+    return {lower_bound(key), upper_bound(key)};
   }
 
   inline iterator lower_bound(const Key &key) const {
-    Node *node = lower_bound_helper(key);
-    return iterator(node);
+    return {tree_.lower_bound(key), 0};
   }
 
   inline iterator upper_bound(const Key &key) const {
-    Node *node = upper_bound_helper(key);
-    return iterator(node);
+    return {tree_.upper_bound(key), 0};
+  }
+
+  template <typename K, typename C = Compare, if_transparent<C> = 0>
+  inline size_t count(const K &key) const { return countCopies(key); }
+
+  template <typename K, typename C = Compare, if_transparent<C> = 0>
+  inline iterator find(const K &key) const { return {tree_.find(key), 0}; }
+
+  template <typename K, typename C = Compare, if_transparent<C> = 0>
+  inline bool contains(const K &key) const { return tree_.contains(key); }
+
+  template <typename K, typename C = Compare, if_transparent<C> = 0>
+  inline std::pair<iterator, iterator> equal_range(const K &key) const {
+    return {lower_bound(key), upper_bound(key)};
+  }
+
+  template <typename K, typename C = Compare, if_transparent<C> = 0>
+  inline iterator lower_bound(const K &key) const {
+    return {tree_.lower_bound(key), 0};
+  }
+
+  template <typename K, typename C = Compare, if_transparent<C> = 0>
+  inline iterator upper_bound(const K &key) const {
+    return {tree_.upper_bound(key), 0};
+  }
+
+ private:
+  // Добавляет n копий value и возвращает итератор на последнюю из них.
+  // При n == 0 ничего не вставляет: узел с нулем копий сломал бы обход и
+  // count; возвращает первую имеющуюся копию или end().
+  template <typename Arg>
+  iterator insert_copies(Arg &&value, size_type n) {
+    if (n == 0) return find(value);
+    node_iterator node =
+        tree_.try_emplace(value, std::forward<Arg>(value), 0).first;
+    node->copies += n;
+    size_ += n;
+    return {node, node->copies - 1};
+  }
+
+  // сумма счетчиков по узлам, O(n)
+  size_type countNodes() const noexcept {
+    size_type total = 0;
+    for (node_iterator it = tree_.begin(); it != tree_.end(); ++it)
+      total += it->copies;
+    return total;
+  }
+
+  template <typename K>
+  size_t countCopies(const K &key) const {
+    node_iterator node = tree_.find(key);
+    return node == tree_.end() ? 0 : node->copies;
   }
 };
 
-template <typename Key, typename... Args>
-void insert_many(multiset<Key> &ms, Args &&...args) {
+template <typename Key, typename Compare = std::less<Key>>
+using ranked_multiset = multiset<Key, Compare, std::allocator<Key>, true>;
+
+template <typename Key, typename Compare = std::less<Key>>
+using compact_multiset =
+    multiset<Key, Compare, std::allocator<Key>, false, true>;
+
+namespace pmr {
+template <typename Key, typename Compare = std::less<Key>>
+using multiset =
+    s21::multiset<Key, Compare, std::pmr::polymorphic_allocator<Key>>;
+}  // namespace pmr
+
+template <typename Key, typename Compare, typename Allocator, bool Ranked,
+          bool Compact, typename... Args>
+void insert_many(multiset<Key, Compare, Allocator, Ranked, Compact> &ms,
+                 Args &&...args) {
   (void)std::initializer_list<int>{
-      ((void)ms.insert(std::forward<Args>(args)), 0)...};
+      ((void)ms.emplace(std::forward<Args>(args)), 0)...};
 }
 
 }  // namespace s21
 
-#endif  //  S21_CONTAINERS_SRC_S21_MULTISET_H_
\ No newline at end of file
+#endif  //  S21_CONTAINERS_SRC_S21_MULTISET_H_
@@ -0,0 +1,176 @@
+#ifndef S21_CONTAINERS_SRC_S21_NODE_POOL_H
+#define S21_CONTAINERS_SRC_S21_NODE_POOL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+
+// Пул узлов одного типа. Память берётся блоками (chunk), каждый следующий
+// блок вдвое больше предыдущего, пока не достигнет kMaxChunkBytes.
+// Освобождённые узлы попадают в односвязный free list и выдаются повторно,
+// так что контейнер в установившемся режиме вообще не обращается к malloc.
+// Пул не потокобезопасен и не конструирует узлы: allocate() отдаёт сырую
+// память.
+//
+// Память блоков выдает Allocator (по умолчанию std::allocator), поэтому
+// пул можно посадить на std::pmr-ресурс: при арене запросов узлы живут в ее
+// буфере, а освобождение блоков сводится к ее сбросу.
+//
+// Блоки принадлежат арене, которой пул владеет совместно с другими пулами.
+// Если узлы переезжают в чужой контейнер (splice, merge), его пул вызывает
+// adopt() и тоже держит арену источника, поэтому узел можно вернуть в любой
+// пул, который его "усыновил". Арена освобождается вместе с последним
+// таким пулом. Арена хранит копию аллокатора, которым выделены ее блоки, и
+// возвращает их ему же, даже если переживет исходный пул.
+template <typename Node, typename Allocator = std::allocator<Node>>
+class node_pool {
+ public:
+  using size_type = std::size_t;
+  using allocator_type = Allocator;
+
+  node_pool() noexcept = default;
+  explicit node_pool(const Allocator& alloc) noexcept : alloc_(alloc) {}
+  node_pool(const node_pool&) = delete;
+  node_pool& operator=(const node_pool&) = delete;
+  node_pool(node_pool&& other) noexcept : alloc_(other.alloc_) {
+    swap(other);
+  }
+  node_pool& operator=(node_pool&&) = delete;
+  ~node_pool() = default;
+
+  Node* allocate() {
+    Slot* slot = free_;
+    if (slot != nullptr) {
+      free_ = slot->next;
+    } else {
+      if (cursor_ == end_) grow();
+      slot = cursor_++;
+    }
+    return reinterpret_cast<Node*>(slot);
+  }
+
+  void deallocate(Node* node) noexcept {
+    Slot* slot = reinterpret_cast<Slot*>(node);
+    slot->next = free_;
+    free_ = slot;
+  }
+
+  // после вызова *this может освобождать узлы, выделенные other
+  void adopt(const node_pool& other) {
+    if (other.arena_ != nullptr) share(other.arena_);
+    for (const auto& arena : other.borrowed_) share(arena);
+  }
+
+  // аллокаторы меняются местами, только если они передаются при обмене;
+  // иначе они должны быть равны, как всегда равны std::allocator
+  void swap(node_pool& other) noexcept {
+    using traits = std::allocator_traits<unit_allocator>;
+    if constexpr (traits::propagate_on_container_swap::value)
+      std::swap(alloc_, other.alloc_);
+    arena_.swap(other.arena_);
+    borrowed_.swap(other.borrowed_);
+    std::swap(free_, other.free_);
+    std::swap(cursor_, other.cursor_);
+    std::swap(end_, other.end_);
+    std::swap(capacity_, other.capacity_);
+  }
+
+  // число узлов, под которые уже выделена память
+  size_type capacity() const noexcept { return capacity_; }
+
+  allocator_type get_allocator() const noexcept {
+    return allocator_type(alloc_);
+  }
+
+ private:
+  union Slot {
+    Slot* next;
+    alignas(Node) unsigned char storage[sizeof(Node)];
+  };
+
+  // заголовок блока, слоты лежат сразу за ним
+  struct Chunk {
+    Chunk* next;
+    size_type units;  // размер блока в Unit, нужен для deallocate
+  };
+
+  static constexpr std::size_t kAlign =
+      std::max(alignof(Slot), alignof(Chunk));
+
+  // единица выделения: аллокатор, перепривязанный к Unit, сам обеспечивает
+  // выравнивание блока
+  struct alignas(kAlign) Unit {
+    unsigned char bytes[kAlign];
+  };
+
+  using unit_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Unit>;
+  using unit_traits = std::allocator_traits<unit_allocator>;
+
+  struct Arena {
+    Chunk* chunks = nullptr;
+    unit_allocator alloc;
+
+    explicit Arena(const unit_allocator& a) : alloc(a) {}
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+    ~Arena() {
+      while (chunks != nullptr) {
+        Chunk* next = chunks->next;
+        unit_traits::deallocate(alloc, reinterpret_cast<Unit*>(chunks),
+                                chunks->units);
+        chunks = next;
+      }
+    }
+  };
+
+  static constexpr std::size_t kHeaderBytes =
+      (sizeof(Chunk) + alignof(Slot) - 1) / alignof(Slot) * alignof(Slot);
+  static constexpr size_type kFirstChunkSlots = 16;
+  static constexpr std::size_t kMaxChunkBytes = 64 * 1024;
+  static constexpr size_type kMaxChunkSlots =
+      std::max<size_type>(kFirstChunkSlots, kMaxChunkBytes / sizeof(Slot));
+
+  void grow() {
+    if (arena_ == nullptr)
+      arena_ = std::allocate_shared<Arena>(alloc_, alloc_);
+    size_type slots = std::min(
+        kMaxChunkSlots, capacity_ == 0 ? kFirstChunkSlots : capacity_);
+    const size_type units =
+        (kHeaderBytes + slots * sizeof(Slot) + sizeof(Unit) - 1) / sizeof(Unit);
+    void* memory = unit_traits::allocate(arena_->alloc, units);
+    Chunk* chunk = static_cast<Chunk*>(memory);
+    chunk->units = units;
+    chunk->next = arena_->chunks;
+    arena_->chunks = chunk;
+    char* first = static_cast<char*>(memory) + kHeaderBytes;
+    cursor_ = reinterpret_cast<Slot*>(first);
+    end_ = cursor_ + slots;
+    capacity_ += slots;
+  }
+
+  void share(const std::shared_ptr<Arena>& arena) {
+    if (arena == arena_) return;
+    for (const auto& held : borrowed_) {
+      if (held == arena) return;
+    }
+    borrowed_.push_back(arena);
+  }
+
+  unit_allocator alloc_;
+  std::shared_ptr<Arena> arena_;  // блоки, выделенные этим пулом
+  std::vector<std::shared_ptr<Arena>> borrowed_;  // арены усыновлённых узлов
+  Slot* free_ = nullptr;
+  Slot* cursor_ = nullptr;  // следующий ни разу не выданный слот
+  Slot* end_ = nullptr;
+  size_type capacity_ = 0;
+};
+
+}  // namespace s21
+
+#endif  // S21_CONTAINERS_SRC_S21_NODE_POOL_H
@@ -1,10 +1,13 @@
 #ifndef S21_CONTAINERS_SRC_S21_QUEUE_H
 #define S21_CONTAINERS_SRC_S21_QUEUE_H
 
-#include "s21_list.h"
+#include <memory>
+#include <type_traits>
+
+#include "s21_deque.h"
 
 namespace s21 {
-template <class T, class Container = s21::list<T>>
+template <class T, class Container = s21::deque<T>>
 class queue {
  public:
   using value_type = T;
@@ -13,6 +16,10 @@ class queue {
   using size_type = std::size_t;
 
   queue() : que() {}
+  // forwards the allocator to the underlying container
+  template <class Alloc, typename = std::enable_if_t<
+                             std::uses_allocator_v<Container, Alloc>>>
+  explicit queue(const Alloc &alloc) : que(alloc) {}
   queue(std::initializer_list<value_type> const &items) : que(items) {}
   queue(queue &&q) : que(std::move(q.que)) {}
   queue(const queue &q) : que(q.que) {}
@@ -38,17 +45,27 @@ class queue {
   size_type size() { return que.size(); }
 
   void push(const_reference value) { que.push_back(value); }
+  void push(value_type &&value) { que.push_back(std::move(value)); }
+  template <typename... Args>
+  reference emplace(Args &&...args) {
+    return que.emplace_back(std::forward<Args>(args)...);
+  }
   void pop() { que.pop_front(); }
-  void swap(queue &other) { this->que.swap(other); }
+  void swap(queue &other) { this->que.swap(other.que); }
 
   template <typename... Args>
   void insert_many_back(Args &&...args) {
-    (push(std::forward<Args>(args)), ...);
+    (emplace(std::forward<Args>(args)), ...);
   }
 
  private:
   Container que;
 };
+
+namespace pmr {
+template <class T>
+using queue = s21::queue<T, s21::pmr::deque<T>>;
+}  // namespace pmr
 }  // namespace s21
 
 #endif  // S21_CONTAINERS_SRC_S21_QUEUE_H
\ No newline at end of file
@@ -1,340 +1,193 @@
 #ifndef S21_CONTAINERS_SRC_S21_SET_H_
 #define S21_CONTAINERS_SRC_S21_SET_H_
 
+#include <functional>
 #include <initializer_list>
 #include <iostream>
 #include <limits>
+#include <memory>
+#include <memory_resource>
+
+#include "s21_tree.h"
 
 namespace s21 {
-template <class Key>
+// Compare   - строгое слабое упорядочивание; прозрачный компаратор вроде
+//             std::less<> включает поиск по значениям других типов
+// Allocator - аллокатор ключей; узлы выделяются его копией
+// Ranked    - хранить размеры поддеревьев ради nth(), rank() и count_range()
+template <class Key, class Compare = std::less<Key>,
+          class Allocator = std::allocator<Key>, bool Ranked = false>
 class set {
  private:
-  struct Node {
-    Key value;
-    Node *left;
-    Node *right;
-    Node *parent;
-
-    inline Node(const Key &value) noexcept {
-      this->value = value;
-      left = nullptr;
-      right = nullptr;
-      parent = nullptr;
-    }
-  };
-
-  Node *rootPtr;
-  size_t m_size;
+  using tree_type =
+      tree<Key, Key, identity_key<Key>, Compare, false, Ranked, Allocator>;
+
+  tree_type tree_;
 
  public:
-  class iterator {
-   public:
-    Node *current;
-
-    iterator(Node *current) noexcept { this->current = current; }
-
-    iterator &operator++() {
-      if (current == nullptr) return *this;
-
-      if (current->right != nullptr) {
-        current = current->right;
-        while (current->left != nullptr) current = current->left;
-      }
-
-      else {
-        Node *parent = current->parent;
-        while (parent != nullptr && current == parent->right) {
-          current = parent;
-          parent = current->parent;
-        }
-        current = parent;
-      }
-      return *this;
-    }
-
-    iterator operator++(int) {
-      iterator temp = *this;
-      ++(*this);
-      return temp;
-    }
-
-    iterator &operator--() {
-      if (current == nullptr) return *this;
-
-      if (current->left != nullptr) {
-        current = current->left;
-        while (current->right != nullptr) current = current->right;
-      }
-
-      else {
-        Node *parent = current->parent;
-        if (parent == nullptr) return *this;
-        while (parent != nullptr && current == parent->left) {
-          current = parent;
-          parent = parent->parent;
-        }
-        current = parent;
-      }
-
-      return *this;
-    }
-
-    iterator operator--(int) {
-      iterator temp = *this;
-      --(*this);
-      return temp;
-    }
-
-    Key &operator*() const { return current->value; }
-
-    bool operator==(const iterator &other) const {
-      return current == other.current;
-    }
-
-    bool operator!=(const iterator &other) const { return !(*this == other); }
-  };
-
-  class const_iterator {
-   public:
-    const Node *current;
-
-    const_iterator(const Node *current) : current(current) {}
-
-    const_iterator &operator++() {
-      if (current == nullptr) return *this;
-
-      if (current->right != nullptr) {
-        current = current->right;
-        while (current->left != nullptr) current = current->left;
-      }
-
-      else {
-        const Node *parent = current->parent;
-        while (parent != nullptr && current == parent->right) {
-          current = parent;
-          parent = current->parent;
-        }
-        current = parent;
-      }
-      return *this;
-    }
-
-    const_iterator &operator--() {
-      if (current == nullptr) return *this;
-
-      if (current->left != nullptr) {
-        current = current->left;
-        while (current->right != nullptr) current = current->right;
-      }
-
-      else {
-        const Node *parent = current->parent;
-        if (parent == nullptr) return *this;
-        while (parent != nullptr && current == parent->left) {
-          current = parent;
-          parent = parent->parent;
-        }
-        current = parent;
-      }
-
-      return *this;
-    }
-
-    const_iterator operator++(int) {
-      const_iterator temp = *this;
-      ++(*this);
-      return temp;
-    }
-
-    const_iterator operator--(int) {
-      const_iterator temp = *this;
-      --(*this);
-      return temp;
-    }
-
-    const Key &operator*() const { return current->value; }
-
-    bool operator==(const const_iterator &other) const {
-      return current == other.current;
-    }
-
-    bool operator!=(const const_iterator &other) const {
-      return !(*this == other);
-    }
-  };
+  using iterator = typename tree_type::iterator;
+  using const_iterator = typename tree_type::const_iterator;
 
   using key_type = Key;
   using value_type = Key;
   using reference = value_type &;
   using const_reference = const value_type &;
   using size_type = size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using node_type = typename tree_type::node_type;
+  using insert_return_type = node_insert_return<iterator, node_type>;
 
-  set() noexcept {
-    rootPtr = nullptr;
-    m_size = 0;
-  }
+  set() noexcept {}
+
+  explicit set(const Allocator &alloc) : tree_(alloc) {}
 
   set(std::initializer_list<value_type> const &items) : set() {
-    for (const auto &item : items) insert(item);
+    insert(items.begin(), items.end());
   }
 
-  set(const set &s) : set() {
-    for (const auto &item : s) insert(item);
+  template <typename InputIt>
+  static set from_sorted(InputIt first, InputIt last) {
+    set s;
+    s.assign_sorted(first, last);
+    return s;
   }
 
-  set(set &&s) : set() { swap(s); }
+  set(const set &s) : tree_(s.tree_) {}
 
-  ~set() { clear(); }
+  set(set &&s) : tree_(std::move(s.tree_)) {}
+
+  ~set() {}
 
   set &operator=(set &&s) {
-    swap(s);
+    // узлы меняются местами только внутри одного аллокатора
+    if (tree_.get_allocator() == s.tree_.get_allocator())
+      swap(s);
+    else
+      tree_ = std::move(s.tree_);
     return *this;
   }
 
-  iterator begin() const {
-    Node *current = rootPtr;
-    while (current != nullptr && current->left != nullptr)
-      current = current->left;
-
-    return iterator(current);
-  }
+  inline iterator begin() const noexcept { return tree_.begin(); }
 
-  inline iterator end() const { return iterator(nullptr); }
+  inline iterator end() const noexcept { return tree_.end(); }
 
-  inline bool empty() const noexcept { return m_size == 0; }
+  inline bool empty() const noexcept { return tree_.empty(); }
 
-  inline size_type size() noexcept { return m_size; }
+  inline size_type size() const noexcept { return tree_.size(); }
 
   inline size_type max_size() const { return std::numeric_limits<int>::max(); }
 
-  void clear() {
-    clear(rootPtr);
-    rootPtr = nullptr;
-    m_size = 0;
+  inline key_compare key_comp() const { return tree_.key_comp(); }
+
+  inline allocator_type get_allocator() const { return tree_.get_allocator(); }
+
+  inline void clear() { tree_.clear(); }
+
+  template <typename InputIt>
+  inline void assign_sorted(InputIt first, InputIt last) {
+    tree_.assign_sorted(first, last);
   }
 
   inline std::pair<iterator, bool> insert(const value_type &value) {
-    if (rootPtr == nullptr) {
-      rootPtr = new Node(value);
-      ++m_size;
-      return {iterator(rootPtr), true};
-    }
-
-    Node *current = rootPtr;
-    Node *parent = nullptr;
-
-    while (current != nullptr) {
-      if (value < current->value) {
-        parent = current;
-        current = current->left;
-      } else if (current->value < value) {
-        parent = current;
-        current = current->right;
-      } else
-        return {iterator(current), false};
-    }
-
-    if (value < parent->value) {
-      parent->left = new Node(value);
-      parent->left->parent = parent;
-      ++m_size;
-      return {iterator(parent->left), true};
-    } else {
-      parent->right = new Node(value);
-      parent->right->parent = parent;
-      ++m_size;
-      return {iterator(parent->right), true};
-    }
+    return tree_.insert(value);
+  }
+
+  inline std::pair<iterator, bool> insert(value_type &&value) {
+    return tree_.insert(std::move(value));
+  }
+
+  template <typename InputIt>
+  inline void insert(InputIt first, InputIt last) {
+    tree_.insert(first, last);
+  }
+
+  insert_return_type insert(node_type &&node) {
+    auto result = tree_.insert(std::move(node));
+    return {result.first, result.second, std::move(node)};
   }
 
-  void erase(iterator pos) {
-    Node *current = pos.current;
-    if (pos.current == nullptr) return;
-    --m_size;
-    if (current->left == nullptr && current->right == nullptr) {  // no children
-      if (current->parent == nullptr)  // deleting the root
-        rootPtr = nullptr;
-
-      else if (pos.current == current->parent->left)
-        current->parent->left = nullptr;
-
-      else
-        current->parent->right = nullptr;
-      delete pos.current;
-    }
-
-    else if (current->left == nullptr ||
-             current->right == nullptr) {  // one child
-      Node *child = current->left != nullptr ? current->left : current->right;
-      child->parent = current->parent;
-      if (current->parent == nullptr)  // deleting the root
-        rootPtr = child;
-
-      else if (current == current->parent->left)
-        current->parent->left = child;
-
-      else
-        current->parent->right = child;
-
-      delete pos.current;
-    }
-
-    else {  // two children
-      Node *successor = current->right;
-      while (successor->left != nullptr) successor = successor->left;
-
-      current->value = successor->value;
-      erase(iterator(successor));
-    }
+  template <typename... Args>
+  inline std::pair<iterator, bool> emplace(Args &&...args) {
+    return tree_.emplace(std::forward<Args>(args)...);
   }
 
-  void swap(set &other) {
-    std::swap(rootPtr, other.rootPtr);
-    std::swap(m_size, other.m_size);
+  inline void erase(iterator pos) { tree_.erase(pos); }
+
+  inline iterator erase(iterator first, iterator last) {
+    return tree_.erase(first, last);
+  }
+
+  inline node_type extract(iterator pos) { return tree_.extract(pos); }
+
+  inline node_type extract(const Key &key) { return tree_.extract(key); }
+
+  inline void swap(set &other) { tree_.swap(other.tree_); }
+
+  // relinks nodes of other; keys already present here stay in other
+  inline void merge(set &other) { tree_.merge(other.tree_); }
+
+  inline iterator find(const Key &key) const { return tree_.find(key); }
+
+  inline bool contains(const Key &key) const { return tree_.contains(key); }
+
+  inline iterator lower_bound(const Key &key) const {
+    return tree_.lower_bound(key);
   }
 
-  void merge(set &other) {
-    if (&other != this) {
-      for (const auto &item : other) insert(item);
+  inline iterator upper_bound(const Key &key) const {
+    return tree_.upper_bound(key);
+  }
 
-      other.clear();
-    }
+  inline std::pair<iterator, iterator> equal_range(const Key &key) const {
+    return tree_.equal_range(key);
   }
 
-  iterator find(const Key &key) {
-    Node *current = rootPtr;
+  template <typename K, typename C = Compare, if_transparent<C> = 0>
+  inline iterator find(const K &key) const { return tree_.find(key); }
 
-    while (current != nullptr) {
-      if (key < current->value)
-        current = current->left;
+  template <typename K, typename C = Compare, if_transparent<C> = 0>
+  inline bool contains(const K &key) const { return tree_.contains(key); }
 
-      else if (current->value < key)
-        current = current->right;
+  template <typename K, typename C = Compare, if_transparent<C> = 0>
+  inline iterator lower_bound(const K &key) const {
+    return tree_.lower_bound(key);
+  }
 
-      else
-        return iterator(current);
-    }
+  template <typename K, typename C = Compare, if_transparent<C> = 0>
+  inline iterator upper_bound(const K &key) const {
+    return tree_.upper_bound(key);
+  }
 
-    return iterator(nullptr);
+  template <typename K, typename C = Compare, if_transparent<C> = 0>
+  inline std::pair<iterator, iterator> equal_range(const K &key) const {
+    return tree_.equal_range(key);
   }
 
-  inline bool contains(const Key &key) { return find(key) != end(); }
+  inline iterator nth(size_type k) const { return tree_.nth(k); }
 
- private:
-  void clear(Node *current) {
-    if (current != nullptr) {
-      clear(current->left);
-      clear(current->right);
-      delete current;
-    }
+  inline size_type rank(const Key &key) const { return tree_.rank(key); }
+
+  inline size_type count_range(const Key &lo, const Key &hi) const {
+    return tree_.count_range(lo, hi);
   }
 };
 
-template <typename Key, typename... Args>
-void insert_many(set<Key> &s, Args &&...args) {
-  (void)std::initializer_list<int>{(s.insert(std::forward<Args>(args)), 0)...};
+template <class Key, class Compare = std::less<Key>>
+using ranked_set = set<Key, Compare, std::allocator<Key>, true>;
+
+namespace pmr {
+template <class Key, class Compare = std::less<Key>>
+using set = s21::set<Key, Compare, std::pmr::polymorphic_allocator<Key>>;
+}  // namespace pmr
+
+template <typename Key, typename Compare, typename Allocator, bool Ranked,
+          typename... Args>
+void insert_many(set<Key, Compare, Allocator, Ranked> &s, Args &&...args) {
+  (void)std::initializer_list<int>{
+      (s.emplace(std::forward<Args>(args)), 0)...};
 }
 
 }  // namespace s21
 
-#endif  //  S21_CONTAINERS_SRC_S21_SET_H_
\ No newline at end of file
+#endif  //  S21_CONTAINERS_SRC_S21_SET_H_
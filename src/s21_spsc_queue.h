@@ -0,0 +1,165 @@
+#ifndef S21_CONTAINERS_SRC_S21_SPSC_QUEUE_H_
+#define S21_CONTAINERS_SRC_S21_SPSC_QUEUE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "s21_cache_line.h"
+
+namespace s21 {
+
+// Ограниченная очередь без блокировок для одного писателя и одного
+// читателя. Методы записи (push, emplace, push_n) вызывает только поток
+// писателя, методы чтения (front, pop, pop_n) - только поток читателя;
+// empty, size и capacity можно звать из обоих.
+//
+// Индексы головы и хвоста растут без ограничения, ячейка - индекс по
+// маске Capacity - 1. Каждый индекс пишет только один поток, и они лежат
+// в разных строках кэша. Рядом с каждым лежит копия чужого индекса: поток
+// перечитывает чужую строку, только когда копия говорит, что очередь
+// полна (писатель) или пуста (читатель).
+template <typename T, std::size_t Capacity>
+class spsc_queue {
+  static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                "spsc_queue capacity must be a power of two");
+
+ public:
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = std::size_t;
+
+  spsc_queue() noexcept = default;
+  spsc_queue(const spsc_queue &) = delete;
+  spsc_queue &operator=(const spsc_queue &) = delete;
+
+  ~spsc_queue() {
+    if constexpr (!std::is_trivially_destructible_v<T>)
+      while (!empty()) pop();
+  }
+
+  // writer side; return false and leave the queue unchanged when it is full
+  inline bool push(const_reference value) { return emplace(value); }
+  inline bool push(value_type &&value) { return emplace(std::move(value)); }
+
+  template <typename... Args>
+  bool emplace(Args &&...args) {
+    const size_type tail = producer_.index.load(std::memory_order_relaxed);
+    if (tail - producer_.cached == Capacity) {
+      producer_.cached = consumer_.index.load(std::memory_order_acquire);
+      if (tail - producer_.cached == Capacity) return false;
+    }
+    new (slot(tail)) value_type(std::forward<Args>(args)...);
+    producer_.index.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // pushes up to n elements from first and publishes them with a single
+  // store; returns how many fit
+  template <typename InputIt>
+  size_type push_n(InputIt first, size_type n) {
+    const size_type tail = producer_.index.load(std::memory_order_relaxed);
+    size_type free = Capacity - (tail - producer_.cached);
+    if (free < n) {
+      producer_.cached = consumer_.index.load(std::memory_order_acquire);
+      free = Capacity - (tail - producer_.cached);
+    }
+    if (n > free) n = free;
+    for (size_type i = 0; i < n; ++i, ++first) {
+      try {
+        new (slot(tail + i)) value_type(*first);
+      } catch (...) {
+        producer_.index.store(tail + i, std::memory_order_release);
+        throw;
+      }
+    }
+    producer_.index.store(tail + n, std::memory_order_release);
+    return n;
+  }
+
+  // reader side; the queue must not be empty
+  inline reference front() noexcept {
+    return *slot(consumer_.index.load(std::memory_order_relaxed));
+  }
+
+  inline void pop() noexcept {
+    const size_type head = consumer_.index.load(std::memory_order_relaxed);
+    slot(head)->~value_type();
+    consumer_.index.store(head + 1, std::memory_order_release);
+  }
+
+  // moves out the element at the front; returns false if there is none
+  bool try_pop(reference out) {
+    if (!readable()) return false;
+    out = std::move(front());
+    pop();
+    return true;
+  }
+
+  // moves up to n elements into out and frees their slots with a single
+  // store; returns how many were taken
+  template <typename OutputIt>
+  size_type pop_n(OutputIt out, size_type n) {
+    const size_type head = consumer_.index.load(std::memory_order_relaxed);
+    size_type ready = consumer_.cached - head;
+    if (ready < n) {
+      consumer_.cached = producer_.index.load(std::memory_order_acquire);
+      ready = consumer_.cached - head;
+    }
+    if (n > ready) n = ready;
+    for (size_type i = 0; i < n; ++i, ++out) {
+      T *item = slot(head + i);
+      *out = std::move(*item);
+      item->~value_type();
+    }
+    consumer_.index.store(head + n, std::memory_order_release);
+    return n;
+  }
+
+  // exact only when called from the reader or the writer while the other
+  // side is idle; otherwise a snapshot
+  inline bool empty() const noexcept { return size() == 0; }
+
+  inline size_type size() const noexcept {
+    // head не обгоняет tail, поэтому head читается первым
+    const size_type head = consumer_.index.load(std::memory_order_acquire);
+    return producer_.index.load(std::memory_order_acquire) - head;
+  }
+
+  static constexpr size_type capacity() noexcept { return Capacity; }
+
+ private:
+  // индекс одной стороны и ее копия индекса другой стороны
+  struct alignas(kCacheLineSize) Side {
+    std::atomic<size_type> index{0};
+    size_type cached = 0;
+  };
+
+  struct Slot {
+    alignas(T) unsigned char bytes[sizeof(T)];
+  };
+
+  inline T *slot(size_type index) noexcept {
+    return std::launder(
+        reinterpret_cast<T *>(slots_[index & (Capacity - 1)].bytes));
+  }
+
+  // reader side: refreshes the cached tail when the queue looks empty
+  inline bool readable() noexcept {
+    const size_type head = consumer_.index.load(std::memory_order_relaxed);
+    if (head != consumer_.cached) return true;
+    consumer_.cached = producer_.index.load(std::memory_order_acquire);
+    return head != consumer_.cached;
+  }
+
+  Side producer_;  // хвост и последняя увиденная писателем голова
+  Side consumer_;  // голова и последний увиденный читателем хвост
+  alignas(kCacheLineSize) Slot slots_[Capacity];
+};
+
+}  // namespace s21
+
+#endif  // S21_CONTAINERS_SRC_S21_SPSC_QUEUE_H_
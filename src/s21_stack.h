@@ -1,10 +1,13 @@
 #ifndef S21_CONTAINERS_SRC_S21_STACK_H
 #define S21_CONTAINERS_SRC_S21_STACK_H
 
-#include "s21_list.h"
+#include <memory>
+#include <type_traits>
+
+#include "s21_deque.h"
 
 namespace s21 {
-template <class T, class Container = s21::list<T>>
+template <class T, class Container = s21::deque<T>>
 class stack {
  public:
   using value_type = T;
@@ -13,6 +16,10 @@ class stack {
   using size_type = std::size_t;  // Fixed the type for size_type
 
   stack() : st() {}
+  // forwards the allocator to the underlying container
+  template <class Alloc, typename = std::enable_if_t<
+                             std::uses_allocator_v<Container, Alloc>>>
+  explicit stack(const Alloc &alloc) : st(alloc) {}
   stack(std::initializer_list<value_type> const &items) : st(items) {}
   stack(stack &&s) : st(std::move(s.st)) {}
   stack(const stack &s) : st(s.st) {}
@@ -36,18 +43,28 @@ class stack {
   size_type size() { return st.size(); }
 
   void push(const_reference value) { this->st.push_back(value); }
+  void push(value_type &&value) { this->st.push_back(std::move(value)); }
+  template <typename... Args>
+  reference emplace(Args &&...args) {
+    return this->st.emplace_back(std::forward<Args>(args)...);
+  }
   void pop() { this->st.pop_back(); }
-  void swap(stack &other) { this->st.swap(other); }
+  void swap(stack &other) { this->st.swap(other.st); }
 
   template <typename... Args>
   void insert_many_front(Args &&...args) {
-    (push(std::forward<Args>(args)), ...);
+    (emplace(std::forward<Args>(args)), ...);
   }
 
  private:
   Container st;
 };
 
+namespace pmr {
+template <class T>
+using stack = s21::stack<T, s21::pmr::deque<T>>;
+}  // namespace pmr
+
 }  // namespace s21
 
 #endif  // S21_CONTAINERS_SRC_S21_STACK_H
\ No newline at end of file
@@ -0,0 +1,209 @@
+#ifndef S21_CONTAINERS_SRC_S21_THREAD_POOL_H_
+#define S21_CONTAINERS_SRC_S21_THREAD_POOL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "s21_vector.h"
+#include "s21_work_stealing_deque.h"
+
+namespace s21 {
+
+// Пул потоков с кражей работы. У каждого рабочего потока свой
+// work_stealing_deque; поток, вызвавший parallel_for, работает вместе с
+// пулом на собственном деке.
+//
+// parallel_for делит [first, last) на куски по grain элементов. Задача -
+// диапазон номеров кусков, упакованный в 64 бита. Исполнитель делит свою
+// задачу пополам, пока не останется один кусок, и кладет верхние половины
+// к себе в дек; бездельники крадут сверху самые крупные из них. Так
+// нагрузка выравнивается сама, даже если куски неравны по стоимости.
+//
+// Вызовы parallel_for из разных потоков выполняются по очереди. Вложенный
+// вызов parallel_for из тела цикла не поддерживается.
+class thread_pool {
+ public:
+  using size_type = std::size_t;
+
+  // one thread fewer than the hardware has: the caller of parallel_for
+  // is the remaining worker
+  explicit thread_pool(size_type workers = defaultWorkers())
+      : deques_(workers + 1) {
+    threads_.reserve(workers);
+    try {
+      for (size_type i = 0; i < workers; ++i)
+        threads_.emplace_back([this, i] { workerLoop(i); });
+    } catch (...) {
+      // запущенные потоки еще joinable, их разрушение вызвало бы terminate
+      stopWorkers();
+      throw;
+    }
+  }
+  thread_pool(const thread_pool &) = delete;
+  thread_pool &operator=(const thread_pool &) = delete;
+
+  ~thread_pool() { stopWorkers(); }
+
+  // worker threads, not counting the caller
+  inline size_type size() const noexcept { return threads_.size(); }
+
+  // Calls body(begin, end) on disjoint subranges covering [first, last) and
+  // returns when all of them are done. grain is the subrange length, 0
+  // picks about eight subranges per thread. The first exception thrown by
+  // body is rethrown here after the other subranges finish.
+  template <typename RandomIt, typename Body>
+  void parallel_for(RandomIt first, RandomIt last, Body &&body,
+                    size_type grain = 0) {
+    const size_type n = static_cast<size_type>(std::distance(first, last));
+    if (n == 0) return;
+    const size_type threads = deques_.size();
+    if (grain == 0) grain = std::max<size_type>(1, n / (8 * threads));
+    // номер куска должен помещаться в 32 бита упакованной задачи
+    grain = std::max(grain, n / kMaxChunks + 1);
+    const size_type chunks = (n + grain - 1) / grain;
+
+    auto run = [&](size_type begin, size_type end) {
+      body(first + begin, first + end);
+    };
+    Job job;
+    job.context = &run;
+    job.run = [](void *context, size_type begin, size_type end) {
+      (*static_cast<decltype(run) *>(context))(begin, end);
+    };
+    job.size = n;
+    job.grain = grain;
+    job.remaining.store(chunks, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> serial(submit_);
+    const size_type self = threads - 1;
+    deques_[self].push(pack(0, chunks));
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      job_ = &job;
+      ++generation_;
+    }
+    wake_.notify_all();
+
+    work(job, self);
+
+    // рабочие берут задание под mutex_, после сброса job_ новых не будет;
+    // ждем тех, кто еще смотрит на job
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      job_ = nullptr;
+    }
+    while (active_.load(std::memory_order_acquire) != 0)
+      std::this_thread::yield();
+    if (job.error) std::rethrow_exception(job.error);
+  }
+
+ private:
+  static constexpr size_type kMaxChunks = 0xffffffffU;
+
+  struct Job {
+    void (*run)(void *context, size_type begin, size_type end);
+    void *context;
+    size_type size;
+    size_type grain;
+    std::atomic<size_type> remaining;
+    std::mutex error_mutex;
+    std::exception_ptr error;
+  };
+
+  void stopWorkers() noexcept {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread &thread : threads_) thread.join();
+  }
+
+  static size_type defaultWorkers() {
+    const unsigned hardware = std::thread::hardware_concurrency();
+    return hardware > 1 ? hardware - 1 : 0;
+  }
+
+  static inline std::uint64_t pack(size_type begin, size_type end) noexcept {
+    return static_cast<std::uint64_t>(begin) << 32 |
+           static_cast<std::uint64_t>(end);
+  }
+
+  void workerLoop(size_type self) {
+    std::uint64_t seen = 0;
+    for (;;) {
+      Job *job;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+        if (stop_) return;
+        seen = generation_;
+        job = job_;
+        if (job == nullptr) continue;  // задание уже закончилось
+        active_.fetch_add(1, std::memory_order_relaxed);
+      }
+      work(*job, self);
+      active_.fetch_sub(1, std::memory_order_release);
+    }
+  }
+
+  // runs tasks from the own deque, then steals, until every chunk is done
+  void work(Job &job, size_type self) {
+    std::uint64_t task;
+    while (job.remaining.load(std::memory_order_acquire) != 0) {
+      if (deques_[self].try_pop(task) || steal(self, task))
+        execute(job, self, task);
+      else
+        std::this_thread::yield();
+    }
+  }
+
+  bool steal(size_type self, std::uint64_t &task) {
+    const size_type threads = deques_.size();
+    for (size_type k = 1; k < threads; ++k)
+      if (deques_[(self + k) % threads].try_steal(task)) return true;
+    return false;
+  }
+
+  void execute(Job &job, size_type self, std::uint64_t task) {
+    size_type low = static_cast<size_type>(task >> 32);
+    size_type high = static_cast<size_type>(task & kMaxChunks);
+    while (high - low > 1) {
+      const size_type middle = low + (high - low) / 2;
+      deques_[self].push(pack(middle, high));
+      high = middle;
+    }
+    const size_type begin = low * job.grain;
+    const size_type end = std::min(job.size, begin + job.grain);
+    try {
+      job.run(job.context, begin, end);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(job.error_mutex);
+      if (!job.error) job.error = std::current_exception();
+    }
+    job.remaining.fetch_sub(1, std::memory_order_acq_rel);
+  }
+
+  s21::vector<work_stealing_deque<std::uint64_t>> deques_;
+  s21::vector<std::thread> threads_;
+
+  std::mutex submit_;  // один parallel_for за раз
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  Job *job_ = nullptr;
+  std::uint64_t generation_ = 0;
+  bool stop_ = false;
+  std::atomic<size_type> active_{0};
+};
+
+}  // namespace s21
+
+#endif  // S21_CONTAINERS_SRC_S21_THREAD_POOL_H_
@@ -0,0 +1,1213 @@
+#ifndef S21_CONTAINERS_SRC_S21_TREE_H_
+#define S21_CONTAINERS_SRC_S21_TREE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+
+// Извлекает ключ из хранимого значения: для set/multiset ключ - само значение
+template <typename Key>
+struct identity_key {
+  inline const Key &operator()(const Key &value) const noexcept {
+    return value;
+  }
+};
+
+// Извлекает ключ из пары ключ-значение (для map)
+template <typename Pair>
+struct pair_first_key {
+  inline const typename Pair::first_type &operator()(
+      const Pair &value) const noexcept {
+    return value.first;
+  }
+};
+
+// Результат insert(node_type &&) уникального контейнера, как в std: если
+// ключ уже есть, узел возвращается вызывающему в node.
+template <typename Iterator, typename NodeType>
+struct node_insert_return {
+  Iterator position;
+  bool inserted;
+  NodeType node;
+};
+
+// Компаратор прозрачен, если объявляет is_transparent, как std::less<>:
+// тогда поиск принимает значения любого сравнимого с ключом типа, и
+// find(std::string_view) в map<std::string, T> не строит временную строку.
+template <typename Compare, typename = void>
+struct is_transparent : std::false_type {};
+
+template <typename Compare>
+struct is_transparent<Compare, std::void_t<typename Compare::is_transparent>>
+    : std::true_type {};
+
+template <typename Compare>
+using if_transparent = std::enable_if_t<is_transparent<Compare>::value, int>;
+
+// Общее красно-черное дерево, на котором построены set, multiset и map.
+//
+// Key        - тип ключа, по которому упорядочены элементы
+// Value      - тип хранимого значения
+// KeyOfValue - функтор, возвращающий ключ хранимого значения
+// Compare    - строгое слабое упорядочивание ключей
+// Multi      - разрешены ли равные ключи (true для multiset)
+// Ranked     - хранить в узлах размеры поддеревьев; включает nth(), rank()
+//              и count_range() за O(log n), но каждая вставка и удаление
+//              обновляют размеры на пути до корня
+// Allocator  - аллокатор значений; узлы выделяются его копией,
+//              перепривязанной к Node
+//
+// Дерево хранит служебный узел header_: его parent указывает на корень, left
+// - на минимальный узел, right - на максимальный. header_ служит end(), поэтому
+// begin() работает за O(1), а --end() дает последний элемент. Корень всегда
+// черный, а header_ - красный, что позволяет отличить их при декременте.
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Compare = std::less<Key>, bool Multi = false,
+          bool Ranked = false, typename Allocator = std::allocator<Value>>
+class tree {
+ public:
+  using key_type = Key;
+  using value_type = Value;
+  using size_type = std::size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+
+  struct NoSubtreeSize {};
+
+  struct NodeBase {
+    NodeBase *left;
+    NodeBase *right;
+    NodeBase *parent;
+    bool red;
+    // число узлов в поддереве, включая этот; без Ranked поле пустое и
+    // помещается в выравнивание после red
+    std::conditional_t<Ranked, size_type, NoSubtreeSize> subtree;
+  };
+
+  struct Node : NodeBase {
+    Value data;
+
+    template <typename... Args>
+    explicit Node(Args &&...args)
+        : NodeBase{nullptr, nullptr, nullptr, true, {}},
+          data(std::forward<Args>(args)...) {}
+  };
+
+  using node_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+  using node_traits = std::allocator_traits<node_allocator>;
+
+  // Pointer - тип, возвращаемый operator->. Обычно это указатель на значение,
+  // но map исторически отдает указатель на сам узел (it->data).
+  template <typename Reference, typename Pointer>
+  class Iterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Value;
+    using difference_type = std::ptrdiff_t;
+    using reference = Reference;
+    using pointer = Pointer;
+
+    inline Iterator(const NodeBase *node = nullptr) noexcept
+        : node_(const_cast<NodeBase *>(node)) {}
+
+    // iterator неявно приводится к const_iterator, остальные преобразования
+    // между итераторами одного дерева (например, для map) - только явные
+    template <typename OtherReference, typename OtherPointer,
+              std::enable_if_t<std::is_convertible_v<OtherPointer, Pointer>,
+                               int> = 0>
+    inline Iterator(const Iterator<OtherReference, OtherPointer> &other) noexcept
+        : node_(other.node_) {}
+
+    template <typename OtherReference, typename OtherPointer,
+              std::enable_if_t<!std::is_convertible_v<OtherPointer, Pointer>,
+                               int> = 0>
+    explicit inline Iterator(
+        const Iterator<OtherReference, OtherPointer> &other) noexcept
+        : node_(other.node_) {}
+
+    inline Reference operator*() const noexcept {
+      return static_cast<Node *>(node_)->data;
+    }
+
+    inline Pointer operator->() const noexcept {
+      if constexpr (std::is_convertible_v<Node *, Pointer>)
+        return static_cast<Node *>(node_);
+      else
+        return &static_cast<Node *>(node_)->data;
+    }
+
+    inline Iterator &operator++() noexcept {
+      node_ = increment(node_);
+      return *this;
+    }
+
+    inline Iterator operator++(int) noexcept {
+      Iterator temp = *this;
+      ++(*this);
+      return temp;
+    }
+
+    inline Iterator &operator--() noexcept {
+      node_ = decrement(node_);
+      return *this;
+    }
+
+    inline Iterator operator--(int) noexcept {
+      Iterator temp = *this;
+      --(*this);
+      return temp;
+    }
+
+    inline bool operator==(const Iterator &other) const noexcept {
+      return node_ == other.node_;
+    }
+
+    inline bool operator!=(const Iterator &other) const noexcept {
+      return node_ != other.node_;
+    }
+
+   private:
+    NodeBase *node_;
+
+    template <typename, typename>
+    friend class Iterator;
+    friend class tree;
+  };
+
+  using iterator = Iterator<Value &, Value *>;
+  using const_iterator = Iterator<const Value &, const Value *>;
+
+  // Владеющий указатель на узел, извлеченный из дерева (node handle из
+  // C++17). Узел можно изменить и вставить в другое дерево того же типа
+  // с равным аллокатором без выделения памяти и копирования значения.
+  class node_type {
+   public:
+    using value_type = Value;
+    using allocator_type = Allocator;
+
+    node_type() noexcept : node_(nullptr) {}
+    node_type(node_type &&other) noexcept
+        : node_(other.node_), alloc_(std::move(other.alloc_)) {
+      other.node_ = nullptr;
+    }
+    node_type &operator=(node_type &&other) noexcept {
+      if (this != &other) {
+        reset();
+        node_ = other.node_;
+        alloc_ = std::move(other.alloc_);
+        other.node_ = nullptr;
+      }
+      return *this;
+    }
+    node_type(const node_type &) = delete;
+    node_type &operator=(const node_type &) = delete;
+    ~node_type() { reset(); }
+
+    inline allocator_type get_allocator() const {
+      return allocator_type(alloc_);
+    }
+
+    inline bool empty() const noexcept { return node_ == nullptr; }
+    explicit inline operator bool() const noexcept { return node_ != nullptr; }
+
+    inline Value &value() const noexcept { return node_->data; }
+
+    // для map: ключ можно поменять до повторной вставки
+    template <typename V = Value>
+    inline std::remove_const_t<typename V::first_type> &key() const noexcept {
+      return const_cast<std::remove_const_t<typename V::first_type> &>(
+          node_->data.first);
+    }
+
+    template <typename V = Value>
+    inline typename V::second_type &mapped() const noexcept {
+      return node_->data.second;
+    }
+
+    void swap(node_type &other) noexcept {
+      std::swap(node_, other.node_);
+      std::swap(alloc_, other.alloc_);
+    }
+
+   private:
+    node_type(Node *node, const node_allocator &alloc) noexcept
+        : node_(node), alloc_(alloc) {}
+
+    Node *release() noexcept {
+      Node *node = node_;
+      node_ = nullptr;
+      return node;
+    }
+
+    void reset() noexcept {
+      if (node_ == nullptr) return;
+      node_traits::destroy(alloc_, node_);
+      node_traits::deallocate(alloc_, node_, 1);
+      node_ = nullptr;
+    }
+
+    Node *node_;
+    node_allocator alloc_;
+
+    friend class tree;
+  };
+
+  tree() noexcept(noexcept(Allocator())) : tree(Allocator()) {}
+
+  explicit tree(const Allocator &alloc) noexcept : alloc_(alloc) { reset(); }
+
+  tree(const tree &other)
+      : tree(node_traits::select_on_container_copy_construction(other.alloc_)) {
+    copyFrom(other);
+  }
+
+  tree(tree &&other) noexcept : tree(std::move(other.alloc_)) {
+    swapNodes(other);
+  }
+
+  ~tree() { clear(); }
+
+  tree &operator=(const tree &other) {
+    if (this != &other) {
+      clear();
+      if constexpr (node_traits::propagate_on_container_copy_assignment::value)
+        alloc_ = other.alloc_;
+      copyFrom(other);
+    }
+    return *this;
+  }
+
+  tree &operator=(tree &&other) noexcept(kMoveKeepsNodes) {
+    if (this == &other) return *this;
+    clear();
+    if constexpr (kMoveKeepsNodes) {
+      if constexpr (node_traits::propagate_on_container_move_assignment::value)
+        alloc_ = std::move(other.alloc_);
+      swapNodes(other);
+    } else if (alloc_ == other.alloc_) {
+      swapNodes(other);
+    } else {
+      moveValuesFrom(other);
+    }
+    return *this;
+  }
+
+  inline allocator_type get_allocator() const noexcept {
+    return allocator_type(alloc_);
+  }
+
+  inline iterator begin() const noexcept { return iterator(header_.left); }
+  inline iterator end() const noexcept { return iterator(&header_); }
+
+  inline bool empty() const noexcept { return size_ == 0; }
+  inline size_type size() const noexcept { return size_; }
+  inline size_type max_size() const noexcept {
+    return std::numeric_limits<size_type>::max() / sizeof(Node);
+  }
+  inline key_compare key_comp() const { return comp_; }
+
+  void clear() noexcept {
+    destroy(root());
+    reset();
+  }
+
+  // аллокаторы, которые не передаются при обмене, должны быть равны
+  void swap(tree &other) noexcept {
+    swapNodes(other);
+    if constexpr (node_traits::propagate_on_container_swap::value)
+      std::swap(alloc_, other.alloc_);
+  }
+
+  // Для уникального дерева возвращает пару (узел, была ли вставка); для Multi
+  // вставка происходит всегда, равные ключи попадают после существующих.
+  template <typename Arg>
+  std::pair<iterator, bool> insert(Arg &&value) {
+    InsertPos pos = findInsertPos(KeyOfValue()(value));
+    if (pos.existing) return {iterator(pos.existing), false};
+
+    Node *node = createNode(std::forward<Arg>(value));
+    return {insertAt(pos, node), true};
+  }
+
+  // Строит значение прямо в новом узле. Ключ известен только после
+  // построения, поэтому для дубликата в уникальном дереве узел освобождается.
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    Node *node = createNode(std::forward<Args>(args)...);
+    InsertPos pos = findInsertPos(keyOf(node));
+    if (pos.existing) {
+      destroyNode(node);
+      return {iterator(pos.existing), false};
+    }
+    return {insertAt(pos, node), true};
+  }
+
+  // Ищет key и строит значение из args, только если ключа еще нет
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key &key, Args &&...args) {
+    InsertPos pos = findInsertPos(key);
+    if (pos.existing) return {iterator(pos.existing), false};
+
+    Node *node = createNode(std::forward<Args>(args)...);
+    return {insertAt(pos, node), true};
+  }
+
+  // Заменяет содержимое элементами отсортированного по ключу диапазона и
+  // строит сбалансированное дерево за O(n) без единого сравнения на спуске.
+  // В уникальном дереве из равных соседей остается первый. Если диапазон
+  // не отсортирован, бросает std::invalid_argument и дерево не меняется.
+  template <typename InputIt>
+  void assign_sorted(InputIt first, InputIt last) {
+    NodeBase head{};
+    NodeBase *tail = &head;
+    size_type count = 0;
+    try {
+      for (; first != last; ++first) {
+        Node *node = createNode(*first);
+        if (tail != &head && comp_(keyOf(node), keyOf(tail))) {
+          destroyNode(node);
+          throw std::invalid_argument("assign_sorted: range is not sorted");
+        }
+        if (!Multi && tail != &head && !comp_(keyOf(tail), keyOf(node))) {
+          destroyNode(node);
+          continue;
+        }
+        tail->right = node;
+        tail = node;
+        ++count;
+      }
+    } catch (...) {
+      tail->right = nullptr;
+      destroyChain(head.right);
+      throw;
+    }
+    tail->right = nullptr;
+    clear();
+    buildBalanced(head.right, count);
+  }
+
+  // Пакетная вставка. Маленький пакет вставляется поэлементно за
+  // O(m log n); большой сортируется, сливается с уже имеющимися узлами,
+  // развернутыми в цепочку, и дерево перестраивается за O(n + m log m).
+  // Узлы при этом не копируются, итераторы остаются действительными.
+  // Равные ключи обрабатываются как при вставке по одному.
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last) {
+    std::vector<NodeBase *> batch;
+    try {
+      // место в batch берется до создания узла, чтобы узел не потерялся,
+      // если push_back бросит
+      for (; first != last; ++first) {
+        batch.push_back(nullptr);
+        batch.back() = createNode(*first);
+      }
+    } catch (...) {
+      if (!batch.empty() && batch.back() == nullptr) batch.pop_back();
+      destroyNodes(batch.begin(), batch.end());
+      throw;
+    }
+    if (batch.empty()) return;
+
+    auto next = batch.begin();
+    if (batch.size() * kRebuildRatio < size_) {
+      try {
+        for (; next != batch.end(); ++next) insertNode(*next);
+      } catch (...) {
+        destroyNodes(next, batch.end());
+        throw;
+      }
+      return;
+    }
+
+    // Если сравнение бросит внутри stable_sort, в batch могут остаться
+    // повторы одних указателей и пропасть другие, поэтому на время
+    // сортировки узлы владеются цепочкой по right.
+    for (size_type i = 0; i + 1 < batch.size(); ++i)
+      batch[i]->right = batch[i + 1];
+    batch.back()->right = nullptr;
+    NodeBase *owned = batch.front();
+    try {
+      std::stable_sort(batch.begin(), batch.end(),
+                       [this](const NodeBase *a, const NodeBase *b) {
+                         return comp_(keyOf(a), keyOf(b));
+                       });
+    } catch (...) {
+      destroyChain(owned);
+      throw;
+    }
+    NodeBase *old = toVine();
+    NodeBase head{};
+    NodeBase *tail = &head;
+    size_type count = 0;
+    try {
+      while (old != nullptr || next != batch.end()) {
+        // на равных ключах старый узел идет первым; вход сдвигается только
+        // после всех сравнений, чтобы бросок не потерял узел
+        const bool take_old =
+            next == batch.end() ||
+            (old != nullptr && !comp_(keyOf(*next), keyOf(old)));
+        NodeBase *node = take_old ? old : *next;
+        const bool duplicate =
+            !Multi && tail != &head && !comp_(keyOf(tail), keyOf(node));
+        if (take_old)
+          old = old->right;
+        else
+          ++next;
+        if (duplicate) {
+          destroyNode(node);
+          continue;
+        }
+        tail->right = node;
+        tail = node;
+        ++count;
+      }
+    } catch (...) {
+      // Слитое не больше оставшегося в обоих входах, поэтому слитая
+      // цепочка и остаток старых узлов вместе отсортированы: дерево
+      // строится из них, а не вставленные новые узлы удаляются.
+      destroyNodes(next, batch.end());
+      tail->right = old;
+      for (; old != nullptr; old = old->right) ++count;
+      buildBalanced(head.right, count);
+      throw;
+    }
+    tail->right = nullptr;
+    buildBalanced(head.right, count);
+  }
+
+  // элемент с номером k по порядку (с нуля); end(), если k >= size()
+  iterator nth(size_type k) const noexcept {
+    static_assert(Ranked, "nth() requires a tree with subtree sizes");
+    NodeBase *node = root();
+    while (node) {
+      const size_type left = subtreeSize(node->left);
+      if (k < left) {
+        node = node->left;
+      } else if (k == left) {
+        return iterator(node);
+      } else {
+        k -= left + 1;
+        node = node->right;
+      }
+    }
+    return end();
+  }
+
+  // число элементов с ключом меньше key, то есть номер lower_bound(key)
+  size_type rank(const Key &key) const {
+    static_assert(Ranked, "rank() requires a tree with subtree sizes");
+    size_type result = 0;
+    NodeBase *node = root();
+    while (node) {
+      if (comp_(keyOf(node), key)) {
+        result += subtreeSize(node->left) + 1;
+        node = node->right;
+      } else {
+        node = node->left;
+      }
+    }
+    return result;
+  }
+
+  // число элементов с ключом из полуинтервала [lo, hi)
+  size_type count_range(const Key &lo, const Key &hi) const {
+    if (!comp_(lo, hi)) return 0;
+    return rank(hi) - rank(lo);
+  }
+
+  // отсоединяет узел pos от дерева и передает его во владение node_type
+  template <typename Reference, typename Pointer>
+  node_type extract(Iterator<Reference, Pointer> pos) noexcept {
+    NodeBase *node = pos.node_;
+    unlink(node);
+    return node_type(static_cast<Node *>(node), alloc_);
+  }
+
+  // извлекает первый элемент с ключом key; пустой node_type, если его нет
+  node_type extract(const Key &key) {
+    iterator pos = find(key);
+    return pos == end() ? node_type() : extract(pos);
+  }
+
+  // Вставляет узел из node без выделения памяти. Если в уникальном дереве
+  // ключ уже есть, узел остается в node, и возвращается позиция дубликата.
+  std::pair<iterator, bool> insert(node_type &&node) {
+    if (node.empty()) return {end(), false};
+    InsertPos pos = findInsertPos(keyOf(node.node_));
+    if (pos.existing) return {iterator(pos.existing), false};
+    return {insertAt(pos, node.release()), true};
+  }
+
+  // Перевешивает узлы other в это дерево без выделения памяти и копирования
+  // значений. Элементы, ключи которых здесь уже есть, остаются в other.
+  void merge(tree &other) {
+    if (this == &other) return;
+    NodeBase *node = other.header_.left;
+    while (node != other.header()) {
+      NodeBase *next = increment(node);
+      InsertPos pos = findInsertPos(keyOf(node));
+      if (!pos.existing) {
+        other.unlink(node);
+        insertAt(pos, node);
+      }
+      node = next;
+    }
+  }
+
+  // удаляет узел pos и возвращает итератор того же вида на следующий элемент
+  template <typename Reference, typename Pointer>
+  Iterator<Reference, Pointer> erase(Iterator<Reference, Pointer> pos) noexcept {
+    NodeBase *node = pos.node_;
+    Iterator<Reference, Pointer> next(increment(node));
+    unlink(node);
+    destroyNode(node);
+    return next;
+  }
+
+  // Удаляет полуинтервал [first, last) за один проход и возвращает last.
+  // Весь диапазон освобождается обходом без перебалансировки. Перестраивать
+  // дерево из оставшихся узлов невыгодно даже при удалении половины:
+  // разворот в цепочку и сборка обходят все n узлов вразброс по памяти, а
+  // каждое удаление стоит амортизированно O(1) поворотов.
+  template <typename Reference, typename Pointer>
+  Iterator<Reference, Pointer> erase(
+      Iterator<Reference, Pointer> first,
+      Iterator<Reference, Pointer> last) noexcept {
+    if (first.node_ == header_.left && last.node_ == &header_) {
+      clear();
+      return last;
+    }
+    while (first != last) first = erase(first);
+    return last;
+  }
+
+  // удаляет все элементы с ключом key и возвращает их количество
+  size_type erase(const Key &key) {
+    iterator first = lower_bound(key);
+    iterator last = upper_bound(key);
+    size_type removed = 0;
+    while (first != last) {
+      first = erase(first);
+      ++removed;
+    }
+    return removed;
+  }
+
+  inline iterator find(const Key &key) const { return findKey(key); }
+
+  inline bool contains(const Key &key) const { return find(key) != end(); }
+
+  inline size_type count(const Key &key) const { return countKey(key); }
+
+  inline iterator lower_bound(const Key &key) const {
+    return iterator(lowerBound(key));
+  }
+
+  inline iterator upper_bound(const Key &key) const {
+    return iterator(upperBound(key));
+  }
+
+  inline std::pair<iterator, iterator> equal_range(const Key &key) const {
+    return {lower_bound(key), upper_bound(key)};
+  }
+
+  // Поиск по значению другого типа для прозрачного Compare: ключ
+  // сравнивается напрямую, без построения временного Key.
+  template <typename K, typename C = Compare, if_transparent<C> = 0>
+  inline iterator find(const K &key) const { return findKey(key); }
+
+  template <typename K, typename C = Compare, if_transparent<C> = 0>
+  inline bool contains(const K &key) const { return findKey(key) != end(); }
+
+  template <typename K, typename C = Compare, if_transparent<C> = 0>
+  inline size_type count(const K &key) const { return countKey(key); }
+
+  template <typename K, typename C = Compare, if_transparent<C> = 0>
+  inline iterator lower_bound(const K &key) const {
+    return iterator(lowerBound(key));
+  }
+
+  template <typename K, typename C = Compare, if_transparent<C> = 0>
+  inline iterator upper_bound(const K &key) const {
+    return iterator(upperBound(key));
+  }
+
+  template <typename K, typename C = Compare, if_transparent<C> = 0>
+  inline std::pair<iterator, iterator> equal_range(const K &key) const {
+    return {iterator(lowerBound(key)), iterator(upperBound(key))};
+  }
+
+ private:
+  // header_ изменяется только через неконстантные методы; в константных он
+  // нужен лишь как адрес для end()
+  mutable NodeBase header_;
+  size_type size_;
+  Compare comp_;
+  node_allocator alloc_;
+
+  // перемещение может забрать узлы, не сравнивая аллокаторы
+  static constexpr bool kMoveKeepsNodes =
+      node_traits::propagate_on_container_move_assignment::value ||
+      node_traits::is_always_equal::value;
+
+  // пакет от 1/kRebuildRatio размера дерева вливается перестройкой
+  static constexpr size_type kRebuildRatio = 16;
+
+  struct InsertPos {
+    NodeBase *parent;
+    bool left;
+    NodeBase *existing;
+  };
+
+  inline NodeBase *header() const noexcept { return &header_; }
+  inline NodeBase *root() const noexcept { return header_.parent; }
+
+  static inline const Key &keyOf(const NodeBase *node) noexcept {
+    return KeyOfValue()(static_cast<const Node *>(node)->data);
+  }
+
+  static inline size_type subtreeSize(const NodeBase *node) noexcept {
+    if constexpr (Ranked) {
+      return node ? node->subtree : 0;
+    } else {
+      return 0;
+    }
+  }
+
+  static inline void updateSize(NodeBase *node) noexcept {
+    if constexpr (Ranked) {
+      node->subtree = subtreeSize(node->left) + subtreeSize(node->right) + 1;
+    }
+  }
+
+  // узел появился или исчез под node: размеры меняются до самого корня
+  void growPath(NodeBase *node) noexcept {
+    if constexpr (Ranked) {
+      for (; node != header(); node = node->parent) ++node->subtree;
+    }
+  }
+
+  void shrinkPath(NodeBase *node) noexcept {
+    if constexpr (Ranked) {
+      for (; node != header(); node = node->parent) --node->subtree;
+    }
+  }
+
+  static inline bool isRed(const NodeBase *node) noexcept {
+    return node && node->red;
+  }
+
+  static inline NodeBase *minimum(NodeBase *node) noexcept {
+    while (node->left) node = node->left;
+    return node;
+  }
+
+  static inline NodeBase *maximum(NodeBase *node) noexcept {
+    while (node->right) node = node->right;
+    return node;
+  }
+
+  static NodeBase *increment(NodeBase *node) noexcept {
+    if (node->right) return minimum(node->right);
+
+    NodeBase *parent = node->parent;
+    while (node == parent->right) {
+      node = parent;
+      parent = parent->parent;
+    }
+    // если дерево из одного корня, node уже стоит на header_
+    if (node->right != parent) node = parent;
+    return node;
+  }
+
+  static NodeBase *decrement(NodeBase *node) noexcept {
+    if (node->red && node->parent->parent == node)  // header_ -> максимум
+      return node->right;
+    if (node->left) return maximum(node->left);
+
+    NodeBase *parent = node->parent;
+    while (node == parent->left) {
+      node = parent;
+      parent = parent->parent;
+    }
+    return parent;
+  }
+
+  void reset() noexcept {
+    header_.parent = nullptr;
+    header_.left = &header_;
+    header_.right = &header_;
+    header_.red = true;
+    size_ = 0;
+  }
+
+  // после обмена header_ корень должен ссылаться на новый адрес header_
+  void fixHeader() noexcept {
+    if (root()) {
+      root()->parent = &header_;
+    } else {
+      header_.left = &header_;
+      header_.right = &header_;
+    }
+  }
+
+  template <typename... Args>
+  Node *createNode(Args &&...args) {
+    Node *node = node_traits::allocate(alloc_, 1);
+    try {
+      node_traits::construct(alloc_, node, std::forward<Args>(args)...);
+    } catch (...) {
+      node_traits::deallocate(alloc_, node, 1);
+      throw;
+    }
+    return node;
+  }
+
+  void destroyNode(NodeBase *base) noexcept {
+    Node *node = static_cast<Node *>(base);
+    node_traits::destroy(alloc_, node);
+    node_traits::deallocate(alloc_, node, 1);
+  }
+
+  void swapNodes(tree &other) noexcept {
+    std::swap(header_, other.header_);
+    std::swap(size_, other.size_);
+    std::swap(comp_, other.comp_);
+    fixHeader();
+    other.fixHeader();
+  }
+
+  // Аллокатор остается прежним (как у std::pmr), поэтому значения other
+  // переезжают в новые узлы, а дерево строится сразу сбалансированным.
+  void moveValuesFrom(tree &other) {
+    comp_ = other.comp_;
+    NodeBase head{};
+    NodeBase *tail = &head;
+    try {
+      for (NodeBase *node = other.header_.left; node != other.header();
+           node = increment(node)) {
+        tail->right = createNode(std::move(static_cast<Node *>(node)->data));
+        tail = tail->right;
+      }
+    } catch (...) {
+      tail->right = nullptr;
+      destroyChain(head.right);
+      throw;
+    }
+    tail->right = nullptr;
+    buildBalanced(head.right, other.size_);
+    other.clear();
+  }
+
+  void destroy(NodeBase *node) noexcept {
+    while (node) {
+      destroy(node->right);
+      NodeBase *left = node->left;
+      destroyNode(node);
+      node = left;
+    }
+  }
+
+  NodeBase *clone(const NodeBase *node, NodeBase *parent) {
+    Node *copy = createNode(static_cast<const Node *>(node)->data);
+    copy->red = node->red;
+    copy->subtree = node->subtree;
+    copy->parent = parent;
+    try {
+      if (node->left) copy->left = clone(node->left, copy);
+      if (node->right) copy->right = clone(node->right, copy);
+    } catch (...) {
+      destroy(copy);
+      throw;
+    }
+    return copy;
+  }
+
+  void copyFrom(const tree &other) {
+    comp_ = other.comp_;
+    if (!other.root()) return;
+    header_.parent = clone(other.root(), &header_);
+    header_.left = minimum(root());
+    header_.right = maximum(root());
+    size_ = other.size_;
+  }
+
+  // вставляет готовый узел; дубликат в уникальном дереве освобождается
+  void insertNode(NodeBase *node) {
+    InsertPos pos = findInsertPos(keyOf(node));
+    if (pos.existing) {
+      destroyNode(node);
+    } else {
+      insertAt(pos, node);
+    }
+  }
+
+  template <typename It>
+  void destroyNodes(It first, It last) noexcept {
+    for (; first != last; ++first) destroyNode(*first);
+  }
+
+  // цепочка узлов, связанных через right
+  void destroyChain(NodeBase *node) noexcept {
+    while (node) {
+      NodeBase *next = node->right;
+      destroyNode(node);
+      node = next;
+    }
+  }
+
+  // Разворачивает дерево в цепочку по right в порядке обхода правыми
+  // поворотами (первая половина алгоритма Day-Stout-Warren), O(n) без
+  // дополнительной памяти. Дерево после этого пусто.
+  NodeBase *toVine() noexcept {
+    NodeBase head{};
+    head.right = root();
+    NodeBase *tail = &head;
+    NodeBase *rest = root();
+    while (rest) {
+      if (!rest->left) {
+        tail = rest;
+        rest = rest->right;
+      } else {
+        NodeBase *pivot = rest->left;
+        rest->left = pivot->right;
+        pivot->right = rest;
+        rest = pivot;
+        tail->right = pivot;
+      }
+    }
+    reset();
+    return head.right;
+  }
+
+  // Строит дерево из отсортированной цепочки в count узлов. Левое и правое
+  // поддеревья каждого узла отличаются по размеру не больше чем на один,
+  // поэтому все уровни, кроме последнего, заполнены: они черные, а узлы
+  // неполного последнего уровня красные.
+  void buildBalanced(NodeBase *chain, size_type count) noexcept {
+    if (count == 0) return;
+    size_type full = 0;  // число полных уровней, floor(log2(count + 1))
+    while ((size_type(2) << full) - 1 <= count) ++full;
+    header_.parent = buildSubtree(chain, count, 0, full, &header_);
+    header_.left = minimum(root());
+    header_.right = maximum(root());
+    size_ = count;
+  }
+
+  static NodeBase *buildSubtree(NodeBase *&chain, size_type count,
+                                size_type depth, size_type red_depth,
+                                NodeBase *parent) noexcept {
+    if (count == 0) return nullptr;
+    const size_type left_count = (count - 1) / 2;
+    NodeBase *left =
+        buildSubtree(chain, left_count, depth + 1, red_depth, nullptr);
+    NodeBase *node = chain;
+    chain = chain->right;
+    node->parent = parent;
+    node->left = left;
+    if (left) left->parent = node;
+    node->red = depth == red_depth;
+    node->right = buildSubtree(chain, count - 1 - left_count, depth + 1,
+                               red_depth, node);
+    if constexpr (Ranked) node->subtree = count;
+    return node;
+  }
+
+  template <typename K>
+  iterator findKey(const K &key) const {
+    NodeBase *node = lowerBound(key);
+    if (node == &header_ || comp_(key, keyOf(node))) return end();
+    return iterator(node);
+  }
+
+  template <typename K>
+  size_type countKey(const K &key) const {
+    if (!Multi) return findKey(key) != end() ? 1 : 0;
+
+    size_type result = 0;
+    for (NodeBase *node = lowerBound(key), *last = upperBound(key);
+         node != last; node = increment(node))
+      ++result;
+    return result;
+  }
+
+  template <typename K>
+  NodeBase *lowerBound(const K &key) const {
+    NodeBase *result = header();
+    NodeBase *node = root();
+    while (node) {
+      if (!comp_(keyOf(node), key)) {
+        result = node;
+        node = node->left;
+      } else {
+        node = node->right;
+      }
+    }
+    return result;
+  }
+
+  template <typename K>
+  NodeBase *upperBound(const K &key) const {
+    NodeBase *result = header();
+    NodeBase *node = root();
+    while (node) {
+      if (comp_(key, keyOf(node))) {
+        result = node;
+        node = node->left;
+      } else {
+        node = node->right;
+      }
+    }
+    return result;
+  }
+
+  // Спуск делает одно сравнение на уровень. Для уникального дерева равный
+  // ключ может быть только у предшественника точки вставки, его проверяем
+  // одним дополнительным сравнением.
+  InsertPos findInsertPos(const Key &key) const {
+    NodeBase *parent = header();
+    NodeBase *node = root();
+    bool left = true;
+    while (node) {
+      parent = node;
+      left = comp_(key, keyOf(node));
+      node = left ? node->left : node->right;
+    }
+
+    if (!Multi) {
+      NodeBase *candidate = parent;
+      if (left) {
+        if (candidate == header_.left) return {parent, left, nullptr};
+        candidate = decrement(candidate);
+      }
+      if (!comp_(keyOf(candidate), key)) return {parent, left, candidate};
+    }
+    return {parent, left, nullptr};
+  }
+
+  // node может прийти из другого дерева, поэтому связи и цвет задаются заново
+  iterator insertAt(const InsertPos &pos, NodeBase *node) noexcept {
+    NodeBase *parent = pos.parent;
+    node->parent = parent;
+    node->left = node->right = nullptr;
+    node->red = true;
+    if constexpr (Ranked) node->subtree = 1;
+    if (parent == header()) {
+      header_.parent = node;
+      header_.left = node;
+      header_.right = node;
+    } else if (pos.left) {
+      parent->left = node;
+      if (parent == header_.left) header_.left = node;
+    } else {
+      parent->right = node;
+      if (parent == header_.right) header_.right = node;
+    }
+
+    growPath(parent);
+    insertFixup(node);
+    ++size_;
+    return iterator(node);
+  }
+
+  // отсоединяет узел от дерева, не освобождая память
+  void unlink(NodeBase *node) noexcept {
+    if (node == header_.left)
+      header_.left = node->right ? minimum(node->right) : node->parent;
+    if (node == header_.right)
+      header_.right = node->left ? maximum(node->left) : node->parent;
+
+    NodeBase *child = nullptr;        // узел, занявший место удаленного
+    NodeBase *childParent = nullptr;  // его родитель (child может быть nullptr)
+    bool removedRed = node->red;
+
+    // из дерева физически уходит позиция node или его преемника
+    if constexpr (Ranked) {
+      NodeBase *removed =
+          node->left && node->right ? minimum(node->right) : node;
+      shrinkPath(removed->parent);
+    }
+
+    if (!node->left) {
+      child = node->right;
+      childParent = node->parent;
+      transplant(node, node->right);
+    } else if (!node->right) {
+      child = node->left;
+      childParent = node->parent;
+      transplant(node, node->left);
+    } else {  // два ребенка: на место узла встает его преемник
+      NodeBase *successor = minimum(node->right);
+      removedRed = successor->red;
+      child = successor->right;
+      if (successor->parent == node) {
+        childParent = successor;
+      } else {
+        childParent = successor->parent;
+        transplant(successor, successor->right);
+        successor->right = node->right;
+        successor->right->parent = successor;
+      }
+      transplant(node, successor);
+      successor->left = node->left;
+      successor->left->parent = successor;
+      successor->red = node->red;
+      successor->subtree = node->subtree;
+    }
+
+    if (!removedRed) eraseFixup(child, childParent);
+    --size_;
+  }
+
+  void transplant(NodeBase *oldNode, NodeBase *newNode) noexcept {
+    if (oldNode == root())
+      header_.parent = newNode;
+
+    else if (oldNode == oldNode->parent->left)
+      oldNode->parent->left = newNode;
+
+    else
+      oldNode->parent->right = newNode;
+
+    if (newNode) newNode->parent = oldNode->parent;
+  }
+
+  void rotateLeft(NodeBase *node) noexcept {
+    NodeBase *pivot = node->right;
+    node->right = pivot->left;
+    if (pivot->left) pivot->left->parent = node;
+    transplant(node, pivot);
+    pivot->left = node;
+    node->parent = pivot;
+    pivot->subtree = node->subtree;
+    updateSize(node);
+  }
+
+  void rotateRight(NodeBase *node) noexcept {
+    NodeBase *pivot = node->left;
+    node->left = pivot->right;
+    if (pivot->right) pivot->right->parent = node;
+    transplant(node, pivot);
+    pivot->right = node;
+    node->parent = pivot;
+    pivot->subtree = node->subtree;
+    updateSize(node);
+  }
+
+  // восстанавливает свойства дерева после вставки красного узла node
+  void insertFixup(NodeBase *node) noexcept {
+    while (node != root() && node->parent->red) {
+      NodeBase *parent = node->parent;
+      NodeBase *grandparent = parent->parent;
+      if (parent == grandparent->left) {
+        NodeBase *uncle = grandparent->right;
+        if (isRed(uncle)) {  // перекрашиваем и поднимаемся выше
+          parent->red = false;
+          uncle->red = false;
+          grandparent->red = true;
+          node = grandparent;
+        } else {
+          if (node == parent->right) {  // сводим "зигзаг" к прямой линии
+            rotateLeft(parent);
+            node = parent;
+            parent = node->parent;
+          }
+          parent->red = false;
+          grandparent->red = true;
+          rotateRight(grandparent);
+        }
+      } else {
+        NodeBase *uncle = grandparent->left;
+        if (isRed(uncle)) {
+          parent->red = false;
+          uncle->red = false;
+          grandparent->red = true;
+          node = grandparent;
+        } else {
+          if (node == parent->left) {
+            rotateRight(parent);
+            node = parent;
+            parent = node->parent;
+          }
+          parent->red = false;
+          grandparent->red = true;
+          rotateLeft(grandparent);
+        }
+      }
+    }
+    root()->red = false;
+  }
+
+  // восстанавливает свойства дерева после удаления черного узла; node занял
+  // его место (может быть nullptr), parent - родитель node
+  void eraseFixup(NodeBase *node, NodeBase *parent) noexcept {
+    while (node != root() && !isRed(node)) {
+      if (node == parent->left) {
+        NodeBase *sibling = parent->right;
+        if (isRed(sibling)) {
+          sibling->red = false;
+          parent->red = true;
+          rotateLeft(parent);
+          sibling = parent->right;
+        }
+        if (!isRed(sibling->left) && !isRed(sibling->right)) {
+          sibling->red = true;
+          node = parent;
+          parent = node->parent;
+        } else {
+          if (!isRed(sibling->right)) {
+            sibling->left->red = false;
+            sibling->red = true;
+            rotateRight(sibling);
+            sibling = parent->right;
+          }
+          sibling->red = parent->red;
+          parent->red = false;
+          sibling->right->red = false;
+          rotateLeft(parent);
+          node = root();
+        }
+      } else {
+        NodeBase *sibling = parent->left;
+        if (isRed(sibling)) {
+          sibling->red = false;
+          parent->red = true;
+          rotateRight(parent);
+          sibling = parent->left;
+        }
+        if (!isRed(sibling->left) && !isRed(sibling->right)) {
+          sibling->red = true;
+          node = parent;
+          parent = node->parent;
+        } else {
+          if (!isRed(sibling->left)) {
+            sibling->right->red = false;
+            sibling->red = true;
+            rotateLeft(sibling);
+            sibling = parent->left;
+          }
+          sibling->red = parent->red;
+          parent->red = false;
+          sibling->left->red = false;
+          rotateRight(parent);
+          node = root();
+        }
+      }
+    }
+    if (node) node->red = false;
+  }
+};
+
+}  // namespace s21
+
+#endif  // S21_CONTAINERS_SRC_S21_TREE_H_
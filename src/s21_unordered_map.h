@@ -0,0 +1,212 @@
+#ifndef S21_CONTAINERS_SRC_S21_UNORDERED_MAP_H_
+#define S21_CONTAINERS_SRC_S21_UNORDERED_MAP_H_
+
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <tuple>
+
+#include "s21_hash_table.h"
+#include "s21_tree.h"
+
+namespace s21 {
+
+// Неупорядоченный словарь на хеш-таблице с открытой адресацией. Пары
+// std::pair<const Key, T> лежат прямо в слотах; при перехешировании и
+// удалении таблица переносит их конструктором, перемещая и ключ, так что
+// const у ключа ничего не стоит.
+template <typename Key, typename T, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+class unordered_map {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const Key, T>;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+
+ private:
+  using table_type =
+      hash_table<Key, value_type, pair_first_key<value_type>, Hash, KeyEqual>;
+
+  template <typename K>
+  using key_arg = typename table_type::template key_arg<K>;
+
+ public:
+  using iterator = typename table_type::iterator;
+  using const_iterator = typename table_type::const_iterator;
+
+  // default constructor, creates empty map
+  unordered_map() noexcept {}
+  // creates an empty map ready for bucket_count elements
+  explicit unordered_map(size_type bucket_count, const Hash &hash = Hash(),
+                         const KeyEqual &equal = KeyEqual())
+      : table_(bucket_count, hash, equal) {}
+  // initializer list constructor; on duplicate keys the first one wins
+  unordered_map(std::initializer_list<value_type> const &items)
+      : unordered_map(items.begin(), items.end()) {}
+  // range constructor
+  template <typename InputIt>
+  unordered_map(InputIt first, InputIt last) {
+    insert(first, last);
+  }
+  // copy constructor
+  unordered_map(const unordered_map &other) = default;
+  // move constructor
+  unordered_map(unordered_map &&other) noexcept : unordered_map() {
+    swap(other);
+  }
+  // destructor
+  ~unordered_map() {}
+
+  unordered_map &operator=(const unordered_map &other) = default;
+  // assignment operator overload for moving object
+  unordered_map &operator=(unordered_map &&other) noexcept {
+    table_ = std::move(other.table_);
+    return *this;
+  }
+
+  // access specified element with bounds checking
+  template <typename K = Key>
+  T &at(const key_arg<K> &key) const {
+    auto it = table_.template find<K>(key);
+    if (it == table_.end()) throw std::out_of_range("Key not found");
+
+    return it->second;
+  }
+
+  // access or insert specified element
+  inline T &operator[](const Key &key) {
+    return try_emplace(key).first->second;
+  }
+
+  inline T &operator[](Key &&key) {
+    return try_emplace(std::move(key)).first->second;
+  }
+
+  // returns an iterator to the beginning
+  inline iterator begin() const noexcept { return table_.begin(); }
+  // returns an iterator to the end
+  inline iterator end() const noexcept { return table_.end(); }
+
+  // checks whether the container is empty
+  inline bool empty() const noexcept { return table_.empty(); }
+  // returns the number of elements
+  inline size_t size() const noexcept { return table_.size(); }
+  // returns the maximum possible number of elements
+  inline size_t max_size() const noexcept { return table_.max_size(); }
+
+  // returns the number of slots
+  inline size_type bucket_count() const noexcept {
+    return table_.bucket_count();
+  }
+  inline float load_factor() const noexcept { return table_.load_factor(); }
+  inline float max_load_factor() const noexcept {
+    return table_.max_load_factor();
+  }
+  // reserves space for n elements without rehashing
+  inline void reserve(size_type n) { table_.reserve(n); }
+
+  inline hasher hash_function() const { return table_.hash_function(); }
+  inline key_equal key_eq() const { return table_.key_eq(); }
+
+  // clears the contents
+  inline void clear() noexcept { table_.clear(); }
+
+  // inserts value and returns iterator to where the element is in the
+  // container and bool denoting whether the insertion took place
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return table_.insert(value);
+  }
+
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return table_.insert(std::move(value));
+  }
+
+  // inserts value by key
+  std::pair<iterator, bool> insert(const Key &key, const T &obj) {
+    return try_emplace(key, obj);
+  }
+
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last) {
+    for (; first != last; ++first) table_.emplace(*first);
+  }
+
+  // inserts an element or assigns to the current element if the key already
+  // exists
+  std::pair<iterator, bool> insert_or_assign(const Key &key, const T &obj) {
+    auto result = try_emplace(key, obj);
+    if (!result.second) result.first->second = obj;
+
+    return result;
+  }
+
+  // constructs the element and inserts it if the key is not present
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    return table_.emplace(std::forward<Args>(args)...);
+  }
+
+  // constructs the mapped value from args only if key is not present yet
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key &key, Args &&...args) {
+    return table_.try_emplace(
+        key, std::piecewise_construct, std::forward_as_tuple(key),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(Key &&key, Args &&...args) {
+    return table_.try_emplace(
+        key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  // erases element at pos, returns the iterator following it
+  iterator erase(const_iterator pos) { return table_.erase(pos); }
+  // erases element by key
+  template <typename K = Key>
+  size_type erase(const key_arg<K> &key) {
+    return table_.template erase<K>(key);
+  }
+
+  // swaps the contents
+  inline void swap(unordered_map &other) noexcept { table_.swap(other.table_); }
+
+  // moves elements of other whose keys are not present here; the rest
+  // stay in other, as with map::merge
+  void merge(unordered_map &other) { table_.merge(other.table_); }
+
+  template <typename K = Key>
+  iterator find(const key_arg<K> &key) const {
+    return table_.template find<K>(key);
+  }
+
+  template <typename K = Key>
+  bool contains(const key_arg<K> &key) const {
+    return table_.template contains<K>(key);
+  }
+
+  template <typename K = Key>
+  size_type count(const key_arg<K> &key) const {
+    return table_.template count<K>(key);
+  }
+
+ private:
+  table_type table_;
+};
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename... Args>
+inline void insert_many(unordered_map<Key, T, Hash, KeyEqual> &myMap,
+                        Args &&...args) {
+  (myMap.emplace(std::forward<Args>(args)), ...);
+}
+
+}  // namespace s21
+
+#endif  //  S21_CONTAINERS_SRC_S21_UNORDERED_MAP_H_
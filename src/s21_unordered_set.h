@@ -0,0 +1,147 @@
+#ifndef S21_CONTAINERS_SRC_S21_UNORDERED_SET_H_
+#define S21_CONTAINERS_SRC_S21_UNORDERED_SET_H_
+
+#include <functional>
+#include <initializer_list>
+
+#include "s21_hash_table.h"
+#include "s21_tree.h"
+
+namespace s21 {
+
+// Неупорядоченное множество на хеш-таблице с открытой адресацией.
+// Вставка может перехешировать таблицу и сделать итераторы
+// недействительными; удаление сдвигает элементы своей цепочки.
+template <class Key, class Hash = std::hash<Key>,
+          class KeyEqual = std::equal_to<Key>>
+class unordered_set {
+ private:
+  using table_type = hash_table<Key, Key, identity_key<Key>, Hash, KeyEqual>;
+
+  template <typename K>
+  using key_arg = typename table_type::template key_arg<K>;
+
+  table_type table_;
+
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+
+  // ключи нельзя менять на месте, поэтому оба итератора константные
+  using iterator = typename table_type::const_iterator;
+  using const_iterator = typename table_type::const_iterator;
+
+  unordered_set() noexcept {}
+
+  explicit unordered_set(size_type bucket_count, const Hash &hash = Hash(),
+                         const KeyEqual &equal = KeyEqual())
+      : table_(bucket_count, hash, equal) {}
+
+  unordered_set(std::initializer_list<value_type> const &items)
+      : unordered_set(items.begin(), items.end()) {}
+
+  template <typename InputIt>
+  unordered_set(InputIt first, InputIt last) {
+    insert(first, last);
+  }
+
+  unordered_set(const unordered_set &s) = default;
+
+  unordered_set(unordered_set &&s) noexcept : unordered_set() { swap(s); }
+
+  ~unordered_set() {}
+
+  unordered_set &operator=(const unordered_set &s) = default;
+
+  unordered_set &operator=(unordered_set &&s) noexcept {
+    table_ = std::move(s.table_);
+    return *this;
+  }
+
+  inline iterator begin() const noexcept { return table_.begin(); }
+
+  inline iterator end() const noexcept { return table_.end(); }
+
+  inline bool empty() const noexcept { return table_.empty(); }
+
+  inline size_type size() const noexcept { return table_.size(); }
+
+  inline size_type max_size() const noexcept { return table_.max_size(); }
+
+  inline size_type bucket_count() const noexcept {
+    return table_.bucket_count();
+  }
+
+  inline float load_factor() const noexcept { return table_.load_factor(); }
+
+  inline float max_load_factor() const noexcept {
+    return table_.max_load_factor();
+  }
+
+  inline void reserve(size_type n) { table_.reserve(n); }
+
+  inline hasher hash_function() const { return table_.hash_function(); }
+
+  inline key_equal key_eq() const { return table_.key_eq(); }
+
+  inline void clear() noexcept { table_.clear(); }
+
+  inline std::pair<iterator, bool> insert(const value_type &value) {
+    return table_.insert(value);
+  }
+
+  inline std::pair<iterator, bool> insert(value_type &&value) {
+    return table_.insert(std::move(value));
+  }
+
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last) {
+    for (; first != last; ++first) table_.insert(*first);
+  }
+
+  template <typename... Args>
+  inline std::pair<iterator, bool> emplace(Args &&...args) {
+    return table_.emplace(std::forward<Args>(args)...);
+  }
+
+  inline iterator erase(iterator pos) { return table_.erase(pos); }
+
+  template <typename K = Key>
+  inline size_type erase(const key_arg<K> &key) {
+    return table_.template erase<K>(key);
+  }
+
+  inline void swap(unordered_set &other) noexcept { table_.swap(other.table_); }
+
+  // moves keys of other that are not present here; duplicates stay in other
+  void merge(unordered_set &other) { table_.merge(other.table_); }
+
+  template <typename K = Key>
+  inline iterator find(const key_arg<K> &key) const {
+    return table_.template find<K>(key);
+  }
+
+  template <typename K = Key>
+  inline bool contains(const key_arg<K> &key) const {
+    return table_.template contains<K>(key);
+  }
+
+  template <typename K = Key>
+  inline size_type count(const key_arg<K> &key) const {
+    return table_.template count<K>(key);
+  }
+};
+
+template <typename Key, typename Hash, typename KeyEqual, typename... Args>
+void insert_many(unordered_set<Key, Hash, KeyEqual> &s, Args &&...args) {
+  (s.emplace(std::forward<Args>(args)), ...);
+}
+
+}  // namespace s21
+
+#endif  //  S21_CONTAINERS_SRC_S21_UNORDERED_SET_H_
@@ -1,13 +1,44 @@
 #ifndef S21_CONTAINERS_SRC_S21_VECTOR_H_
 #define S21_CONTAINERS_SRC_S21_VECTOR_H_
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
 #include <initializer_list>
 #include <iostream>
+#include <iterator>
 #include <limits>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 // Test vector class with some basic example operations and concepts
+//
+// Storage is raw memory: only the first m_size slots hold constructed
+// objects, the spare capacity [m_size, m_capacity) is never constructed.
+// Buffers come from Allocator; elements are placed into them directly.
 namespace s21 {
+
+// A type is trivially relocatable when moving an object to a new address and
+// abandoning the old bytes is equivalent to a bitwise copy. Containers then
+// relocate such elements with memcpy/memmove instead of per-element move and
+// destroy. Trivially copyable types qualify automatically; other types (for
+// example fixed-size messages with a user-declared destructor) may opt in:
+//
+//   template <>
+//   struct s21::is_trivially_relocatable<Message> : std::true_type {};
+template <class T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
 template <class T>
+inline constexpr bool is_trivially_relocatable_v =
+    is_trivially_relocatable<T>::value;
+
+template <class T, class Allocator = std::allocator<T>>
 class vector {
  public:
   using value_type = T;
@@ -17,74 +48,93 @@ class vector {
   using const_iterator = const T *;
   using size_type = size_t;
   using difference_type = std::ptrdiff_t;
+  using allocator_type = Allocator;
 
-  vector() {
-    m_capacity = 0;
-    m_size = 0;
-    arr = nullptr;
+  vector() noexcept(noexcept(Allocator())) : vector(Allocator()) {
   }  // default constructor (simplified syntax for assigning values to
      // attributes)
-  explicit vector(size_type n) {
-    if (n > 0) {
-      m_capacity = n;
-      m_size = n;
-      arr = new value_type[m_capacity];
-    }
+  explicit vector(const Allocator &alloc) noexcept
+      : m_size(0), m_capacity(0), arr(nullptr), m_alloc(alloc) {
+  }  // empty vector whose buffers come from alloc
+  explicit vector(size_type n, const Allocator &alloc = Allocator())
+      : vector(alloc) {
+    arr = allocate(n);
+    m_capacity = n;
+    for (; m_size < n; ++m_size) new (arr + m_size) value_type();
   }  // parametrized constructor for fixed size vector
-  vector(std::initializer_list<value_type> const &items) {
-    arr = new value_type[items.size()];
-    int i = 0;
-    for (auto it = items.begin(); it != items.end(); it++) {
-      arr[i] = *it;
-      i++;
-    }
-
-    m_size = items.size();
+  vector(std::initializer_list<value_type> const &items,
+         const Allocator &alloc = Allocator())
+      : vector(alloc) {
+    arr = allocate(items.size());
     m_capacity = items.size();
+    std::uninitialized_copy(items.begin(), items.end(), arr);
+    m_size = items.size();
   }  // initializer list constructor (allows creating lists
      // with initializer lists, see main.cpp)
-  vector(const vector &v) {
-    m_size = v.m_size;
+  vector(const vector &v)
+      : vector(v, alloc_traits::select_on_container_copy_construction(
+                      v.m_alloc)) {}  // copy constructor
+  vector(const vector &v, const Allocator &alloc) : vector(alloc) {
+    arr = allocate(v.m_capacity);
     m_capacity = v.m_capacity;
-    arr = new value_type[m_capacity];
-    for (size_type i = 0; i < m_size; ++i) arr[i] = v.arr[i];
-  }  // copy constructor with simplified syntax
-  vector(vector &&v) noexcept {
+    std::uninitialized_copy(v.arr, v.arr + v.m_size, arr);
     m_size = v.m_size;
-    m_capacity = v.m_capacity;
-    arr = v.arr;
+  }  // copy constructor placing the copy into alloc
+  vector(vector &&v) noexcept
+      : m_size(v.m_size),
+        m_capacity(v.m_capacity),
+        arr(v.arr),
+        m_alloc(std::move(v.m_alloc)) {
     v.arr = nullptr;
     v.m_size = 0;
     v.m_capacity = 0;
   }  // move constructor with simplified syntax
 
   vector &operator=(const vector &v) {
-    delete[] arr;
-    m_size = v.m_size;
-    m_capacity = v.m_capacity;
-    arr = new value_type[m_capacity];
-    for (size_type i = 0; i < m_size; ++i) arr[i] = v.arr[i];
-
+    if (&v != this) {
+      vector copy(v, alloc_traits::propagate_on_container_copy_assignment::value
+                         ? v.m_alloc
+                         : m_alloc);
+      swapStorage(copy);
+      if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+        std::swap(m_alloc, copy.m_alloc);  // the old buffer leaves with its
+                                           // own allocator
+    }
     return *this;
   }  // assigment values from one vector to another one
-  vector &operator=(vector &&v) {
-    if (&v != this) {
-      delete[] arr;
+  vector &operator=(vector &&v) noexcept(
+      alloc_traits::propagate_on_container_move_assignment::value ||
+      alloc_traits::is_always_equal::value) {
+    if (&v == this) return *this;
+    if (alloc_traits::propagate_on_container_move_assignment::value ||
+        m_alloc == v.m_alloc) {
+      release();
       arr = v.arr;
       m_size = v.m_size;
       m_capacity = v.m_capacity;
+      if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+        m_alloc = std::move(v.m_alloc);
       v.arr = nullptr;
       v.m_size = 0;
       v.m_capacity = 0;
+    } else {
+      // the allocator stays (as with std::pmr), so the elements are moved
+      // one by one into a buffer of our own
+      vector moved(m_alloc);
+      moved.reserve(v.m_size);
+      for (T *it = v.arr; it != v.arr + v.m_size; ++it)
+        moved.emplaceAt(moved.m_size, std::move(*it));
+      swapStorage(moved);
+      v.clear();
     }
     return *this;
   }  // assignment operator overload for moving object
 
-  ~vector() {
-    delete[] arr;
-    m_capacity = 0;
-    m_size = 0;
-  }  // destructor
+  inline allocator_type get_allocator() const noexcept {
+    return m_alloc;
+  }  // returns the allocator that owns the buffer
+
+  ~vector() { release(); }  // destructor
 
   inline value_type at(size_type i) const {
     if (i >= m_size) throw std::out_of_range("Index out of range");
@@ -107,125 +157,347 @@ class vector {
   inline iterator begin() const noexcept {
     return arr;
   }  // returns an iterator to the beginning
-  inline iterator end() noexcept {
-    return arr + size();
+  inline iterator end() const noexcept {
+    return arr + m_size;
   }  // returns an iterator to the end
 
   inline bool empty() const noexcept {
-    bool result = true;
-    if (m_size != 0) result = false;
-
-    return result;
+    return m_size == 0;
   }  // checks whether the container is empty
   inline size_type size() const noexcept { return m_size; }  // size getter
-  inline size_type max_size() const {
-    return std::numeric_limits<int>::max();
+  inline size_type max_size() const noexcept {
+    return std::numeric_limits<size_type>::max() / sizeof(value_type);
   }  // returns the maximum possible number of elements
   void reserve(size_type size) {
-    value_type *buff = new value_type[size];
-
-    for (size_t i = 0; i < m_size; ++i) buff[i] = std::move(arr[i]);
-
-    delete[] arr;
-    arr = buff;
-    m_capacity = size;
-  }  // allocate storage of size elements and copies current
-     // array elements to a newely allocated array
+    if (size > max_size()) throw std::length_error("vector::reserve");
+    if (size > m_capacity) reallocate(size);
+  }  // allocate raw storage for size elements and moves current
+     // elements into it; never shrinks and never constructs spare slots
   inline size_type capacity() const noexcept {
     return m_capacity;
   }  // capasity getter
   void shrink_to_fit() {
-    value_type *buff = new value_type[m_size];
-
-    for (size_t i = 0; i < m_size; ++i) buff[i] = std::move(arr[i]);
-
-    delete[] arr;
-    arr = buff;
-    m_capacity = m_size;
+    if (m_capacity > m_size) reallocate(m_size);
   }  // reduces memory usage by freeing unused memory
 
-  inline void clear() {
-    delete[] arr;
+  inline void clear() noexcept {
+    destroy(arr, arr + m_size);
     m_size = 0;
-    arr = nullptr;
-    value_type *buff = new value_type[m_capacity];
-    arr = buff;
-  }  // clears the contents
+  }  // clears the contents, keeps the capacity
 
   iterator insert(iterator pos, const_reference value) {
-    size_type index = pos - begin();
-
-    if (m_size >= m_capacity) reserve(m_size * 2);
-
-    value_type *tempArr = new value_type[m_capacity];
-
-    for (size_type i = 0; i < index; ++i) tempArr[i] = arr[i];
-
-    tempArr[index] = value;
-
-    for (size_type i = index; i < m_size; ++i) tempArr[i + 1] = arr[i];
-
-    delete[] arr;
-    arr = tempArr;
-
-    ++m_size;
-    return begin() + index;
+    return emplaceAt(pos - begin(), value);
   }  // inserts elements into concrete pos and returns
      // the iterator that points to the new element
-  void erase(iterator pos) {
-    if (pos >= begin() && pos < end()) {
-      size_t index = pos - begin();
-      for (size_t i = index; i < m_size - 1; ++i) arr[i] = arr[i + 1];
-      m_size--;
+  iterator insert(iterator pos, value_type &&value) {
+    return emplaceAt(pos - begin(), std::move(value));
+  }  // inserts an rvalue, moving it into place
+  template <class InputIt,
+            typename = std::enable_if_t<!std::is_integral_v<InputIt>>>
+  iterator insert(iterator pos, InputIt first, InputIt last) {
+    size_type index = pos - begin();
+    using category = typename std::iterator_traits<InputIt>::iterator_category;
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag, category>) {
+      insertRange(index, first, last,
+                  static_cast<size_type>(std::distance(first, last)));
+    } else {  // single pass: append, then rotate the batch into place once
+      size_type old_size = m_size;
+      for (; first != last; ++first) emplaceAt(m_size, *first);
+      std::rotate(arr + index, arr + old_size, arr + m_size);
     }
+    return begin() + index;
+  }  // inserts [first, last) before pos, shifting the tail only once
+  iterator erase(iterator pos) {
+    if (pos >= begin() && pos < end()) return erase(pos, pos + 1);
+    return pos;
   }  // erases element at pos
-  inline void push_back(value_type v) {
-    if (m_size != 0 && m_size >= m_capacity)
-      reserve(m_size * 2);
-
-    else if (m_size == 0)
-      reserve(1);
-
-    arr[m_size++] = v;
+  iterator erase(iterator first, iterator last) {
+    if (first >= last) return first;
+    size_type count = last - first;
+    if constexpr (kRelocatable) {
+      destroy(first, last);
+      std::memmove(static_cast<void *>(first), last,
+                   (end() - last) * sizeof(value_type));
+    } else {
+      iterator new_end = std::move(last, end(), first);
+      destroy(new_end, end());
+    }
+    m_size -= count;
+    return first;
+  }  // erases [first, last), moving the tail down only once
+  template <class... Args>
+  iterator emplace(const_iterator pos, Args &&...args) {
+    return emplaceAt(pos - arr, std::forward<Args>(args)...);
+  }  // constructs an element in place before pos
+  template <class... Args>
+  reference emplace_back(Args &&...args) {
+    return *emplaceAt(m_size, std::forward<Args>(args)...);
+  }  // constructs an element in place at the end
+  inline void push_back(const_reference value) {
+    emplaceAt(m_size, value);
   }  // append new element
+  inline void push_back(value_type &&value) {
+    emplaceAt(m_size, std::move(value));
+  }  // append new element, moving it
   inline void pop_back() {
-    value_type *data = (value_type *)arr;
-    data[m_size - 1].~T();
-    m_size--;
+    --m_size;
+    arr[m_size].~value_type();
   }  // removes the last element
-  inline void swap(vector &other) {
-    vector<T> temp(std::move(other));
-    other = std::move(*this);
-    *this = std::move(temp);
-  }  // swap the contents
+  inline void swap(vector &other) noexcept {
+    swapStorage(other);
+    if constexpr (alloc_traits::propagate_on_container_swap::value)
+      std::swap(m_alloc, other.m_alloc);
+  }  // swap the contents; allocators that do not propagate must be equal
 
   template <typename... Args>
   inline iterator insert_many(const_iterator pos, Args &&...args) {
     size_type index = pos - arr;
-    (insert_impl(index++, std::forward<Args>(args)), ...);
-    return arr + index;
-  }  // inserts new elements into the container directly before pos
+    if (index > m_size) throw std::out_of_range("Index out of range");
+
+    size_type old_size = m_size;
+    (emplaceAt(m_size, std::forward<Args>(args)), ...);
+    std::rotate(arr + index, arr + old_size, arr + m_size);
+    return arr + index + sizeof...(Args);
+  }  // constructs new elements in place at the end and rotates them before
+     // pos in a single pass
 
   template <typename... Args>
   inline void insert_many_back(Args &&...args) {
-    (push_back(std::forward<Args>(args)), ...);
+    (emplaceAt(m_size, std::forward<Args>(args)), ...);
   }  // appends new elements to the end of the container
 
  private:
+  using alloc_traits = std::allocator_traits<Allocator>;
+
   size_t m_size;
   size_t m_capacity;
   T *arr;
+  Allocator m_alloc;
+
+  // with the default allocator relocatable elements live in malloc'ed
+  // storage so that growth can use realloc, which may extend the block in
+  // place or remap its pages; any other allocator is used as is
+  static constexpr bool kRelocatable = is_trivially_relocatable_v<value_type>;
+  static constexpr bool kReallocatable =
+      kRelocatable && alignof(value_type) <= alignof(std::max_align_t) &&
+      std::is_same_v<Allocator, std::allocator<T>>;
+
+  T *allocate(size_type n) {
+    if (n == 0) return nullptr;
+    if constexpr (kReallocatable) {
+      void *p = std::malloc(n * sizeof(value_type));
+      if (!p) throw std::bad_alloc();
+      return static_cast<T *>(p);
+    } else {
+      return alloc_traits::allocate(m_alloc, n);
+    }
+  }  // raw storage for n elements, nothing is constructed
+
+  void deallocate(T *p, size_type n) noexcept {
+    if (p == nullptr) return;
+    if constexpr (kReallocatable)
+      std::free(p);
+    else
+      alloc_traits::deallocate(m_alloc, p, n);
+  }  // n must be the capacity p was allocated with
+
+  void swapStorage(vector &other) noexcept {
+    std::swap(arr, other.arr);
+    std::swap(m_size, other.m_size);
+    std::swap(m_capacity, other.m_capacity);
+  }
 
-  void insert_impl(size_type index, const_reference value) {
-    if (index > m_size) throw std::out_of_range("Index out of range");
+  static void destroy(T *first, T *last) noexcept {
+    if constexpr (!std::is_trivially_destructible_v<value_type>)
+      for (; first != last; ++first) first->~value_type();
+  }
 
-    if (m_size == m_capacity) reserve(m_capacity == 0 ? 1 : m_capacity * 2);
+  void release() noexcept {
+    destroy(arr, arr + m_size);
+    deallocate(arr, m_capacity);
+  }  // destroys the elements and frees the storage
+
+  size_type growth(size_type required) const {
+    if (required > max_size()) throw std::length_error("vector");
+    if (m_capacity >= max_size() / 2) return max_size();
+    return std::max(required, m_capacity * 2);
+  }  // geometric growth, at least required elements
+
+  void reallocate(size_type new_capacity) {
+    if constexpr (kReallocatable) {
+      if (new_capacity == 0) {
+        deallocate(arr, m_capacity);
+        arr = nullptr;
+      } else {
+        void *p = std::realloc(static_cast<void *>(arr),
+                               new_capacity * sizeof(value_type));
+        if (!p) throw std::bad_alloc();
+        arr = static_cast<T *>(p);
+      }
+      m_capacity = new_capacity;
+      return;
+    }
 
-    std::copy_backward(arr + index, arr + m_size, arr + m_size + 1);
-    arr[index] = value;
-    m_size++;
+    T *buff = allocate(new_capacity);
+    try {
+      relocate(arr, arr + m_size, buff);
+    } catch (...) {
+      deallocate(buff, new_capacity);
+      throw;
+    }
+    deallocate(arr, m_capacity);
+    arr = buff;
+    m_capacity = new_capacity;
+  }  // moves the elements into a buffer of new_capacity slots; relocatable
+     // elements are copied as raw bytes (or the block is realloc'ed)
+
+  static void relocate(T *first, T *last, T *dest) {
+    if constexpr (kRelocatable) {
+      if (first != last)
+        std::memcpy(static_cast<void *>(dest), first,
+                    (last - first) * sizeof(value_type));
+    } else {
+      transfer(first, last, dest);
+      destroy(first, last);
+    }
+  }  // moves [first, last) into raw storage at dest and ends the lifetime of
+     // the sources; the ranges must not overlap
+
+  static void transfer(T *first, T *last, T *dest) {
+    if constexpr (std::is_nothrow_move_constructible_v<value_type> ||
+                  !std::is_copy_constructible_v<value_type>)
+      std::uninitialized_move(first, last, dest);
+    else
+      std::uninitialized_copy(first, last, dest);
+  }  // constructs copies of [first, last) at dest, moving when that cannot
+     // throw; the sources stay alive, nothing is left at dest on failure
+
+  // Opens a hole of count raw slots at index in the current buffer. Only for
+  // relocatable types, where the tail can be shifted with memmove.
+  void openGap(size_type index, size_type count) noexcept {
+    std::memmove(static_cast<void *>(arr + index + count), arr + index,
+                 (m_size - index) * sizeof(value_type));
+  }
+
+  void closeGap(size_type index, size_type count) noexcept {
+    std::memmove(static_cast<void *>(arr + index), arr + index + count,
+                 (m_size - index) * sizeof(value_type));
+  }
+
+  // Moves the elements into a new buffer of new_capacity slots, leaving
+  // count raw slots at index. build(slot) constructs the new elements there
+  // before the old ones are touched, so it may still read from them. The
+  // old elements are destroyed only once both halves are in the new buffer,
+  // so a throwing copy leaves the vector as it was.
+  template <class Build>
+  void reallocateWithGap(size_type new_capacity, size_type index,
+                         size_type count, Build build) {
+    T *buff = allocate(new_capacity);
+    try {
+      build(buff + index);
+    } catch (...) {
+      deallocate(buff, new_capacity);
+      throw;
+    }
+    if constexpr (kRelocatable) {
+      relocate(arr, arr + index, buff);
+      relocate(arr + index, arr + m_size, buff + index + count);
+    } else {
+      try {
+        transfer(arr, arr + index, buff);
+        try {
+          transfer(arr + index, arr + m_size, buff + index + count);
+        } catch (...) {
+          destroy(buff, buff + index);
+          throw;
+        }
+      } catch (...) {
+        destroy(buff + index, buff + index + count);
+        deallocate(buff, new_capacity);
+        throw;
+      }
+      destroy(arr, arr + m_size);
+    }
+    deallocate(arr, m_capacity);
+    arr = buff;
+    m_capacity = new_capacity;
+    m_size += count;
   }
+
+  template <class... Args>
+  iterator emplaceAt(size_type index, Args &&...args) {
+    if (m_size == m_capacity) {
+      reallocateWithGap(growth(m_size + 1), index, 1, [&](T *slot) {
+        new (slot) value_type(std::forward<Args>(args)...);
+      });
+    } else if (index == m_size) {
+      new (arr + m_size) value_type(std::forward<Args>(args)...);
+      ++m_size;
+    } else {
+      // args may refer to an element of this vector, build before shifting
+      value_type value(std::forward<Args>(args)...);
+      if constexpr (kRelocatable) {
+        openGap(index, 1);
+        try {
+          new (arr + index) value_type(std::move(value));
+        } catch (...) {
+          closeGap(index, 1);
+          throw;
+        }
+        ++m_size;
+      } else {
+        new (arr + m_size) value_type(std::move(arr[m_size - 1]));
+        ++m_size;
+        std::move_backward(arr + index, arr + m_size - 2, arr + m_size - 1);
+        arr[index] = std::move(value);
+      }
+    }
+    return begin() + index;
+  }  // constructs one element at index, reallocating only when full
+
+  template <class ForwardIt>
+  void insertRange(size_type index, ForwardIt first, ForwardIt last,
+                   size_type count) {
+    if (count == 0) return;
+    if (m_size + count > m_capacity) {
+      reallocateWithGap(growth(m_size + count), index, count, [&](T *slot) {
+        std::uninitialized_copy(first, last, slot);
+      });
+    } else if constexpr (kRelocatable) {
+      openGap(index, count);
+      try {
+        std::uninitialized_copy(first, last, arr + index);
+      } catch (...) {
+        closeGap(index, count);
+        throw;
+      }
+      m_size += count;
+    } else {
+      T *pos = arr + index;
+      T *old_end = arr + m_size;
+      size_type after = m_size - index;
+      if (after > count) {
+        std::uninitialized_move(old_end - count, old_end, old_end);
+        m_size += count;
+        std::move_backward(pos, old_end - count, old_end);
+        std::copy(first, last, pos);
+      } else {
+        ForwardIt mid = first;
+        std::advance(mid, after);
+        std::uninitialized_copy(mid, last, old_end);
+        m_size += count - after;
+        std::uninitialized_move(pos, old_end, arr + m_size);
+        m_size += after;
+        std::copy(first, mid, pos);
+      }
+    }
+  }  // inserts count elements from [first, last) at index
 };
+
+namespace pmr {
+template <class T>
+using vector = s21::vector<T, std::pmr::polymorphic_allocator<T>>;
+}  // namespace pmr
 }  // namespace s21
 
 #endif  // S21_CONTAINERS_SRC_S21_VECTOR_H_
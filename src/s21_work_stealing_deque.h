@@ -0,0 +1,161 @@
+#ifndef S21_CONTAINERS_SRC_S21_WORK_STEALING_DEQUE_H_
+#define S21_CONTAINERS_SRC_S21_WORK_STEALING_DEQUE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "s21_cache_line.h"
+
+namespace s21 {
+
+// Дек Чейза-Лева для планировщика с кражей работы (вариант Lê, Pop, Cohen,
+// Zappa Nardelli для модели памяти C11). Владелец кладет и забирает задачи
+// с нижнего конца (push/try_pop, LIFO), остальные потоки крадут с верхнего
+// (try_steal, FIFO). Владелец и воры спорят только за последний элемент.
+//
+// Когда буфер полон, владелец копирует элементы в буфер вдвое больше.
+// Вор в этот момент может еще читать старый буфер, поэтому старые буферы
+// не освобождаются до разрушения дека: они связаны в список через
+// previous, а их суммарный размер меньше текущего.
+//
+// Вор читает ячейку одновременно с записью владельца в ту же ячейку
+// следующего круга, поэтому ячейки - атомарные, а T должен быть
+// тривиально копируемым и атомарным без блокировок: указатель на задачу,
+// индекс или упакованный диапазон.
+template <typename T>
+class work_stealing_deque {
+  static_assert(std::is_trivially_copyable_v<T> &&
+                    std::atomic<T>::is_always_lock_free,
+                "work_stealing_deque holds lock-free atomic values only");
+
+ public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+  // capacity is rounded up to a power of two
+  explicit work_stealing_deque(size_type capacity = 64)
+      : array_(new Array(roundUp(capacity), nullptr)) {}
+  work_stealing_deque(const work_stealing_deque &) = delete;
+  work_stealing_deque &operator=(const work_stealing_deque &) = delete;
+
+  ~work_stealing_deque() {
+    Array *array = array_.load(std::memory_order_relaxed);
+    while (array != nullptr) {
+      Array *previous = array->previous;
+      delete array;
+      array = previous;
+    }
+  }
+
+  // owner only
+  void push(T value) {
+    const std::int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    const std::int64_t top = top_.load(std::memory_order_acquire);
+    Array *array = array_.load(std::memory_order_relaxed);
+    if (bottom - top > static_cast<std::int64_t>(array->mask)) {
+      array = grow(array, top, bottom);
+    }
+    array->put(bottom, value);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+  }
+
+  // owner only; takes the most recently pushed value
+  bool try_pop(T &out) {
+    const std::int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    Array *array = array_.load(std::memory_order_relaxed);
+    bottom_.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t top = top_.load(std::memory_order_relaxed);
+    if (top > bottom) {  // пусто
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return false;
+    }
+    out = array->get(bottom);
+    if (top == bottom) {
+      // последний элемент: забирает тот, кто первым сдвинет top
+      const bool won = top_.compare_exchange_strong(
+          top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return won;
+    }
+    return true;
+  }
+
+  // any thread; takes the oldest value. Returns false when the deque is
+  // empty or another thread won the race for the same value.
+  bool try_steal(T &out) {
+    std::int64_t top = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const std::int64_t bottom = bottom_.load(std::memory_order_acquire);
+    if (top >= bottom) return false;
+    // acquire вместо consume: компиляторы все равно усиливают consume
+    Array *array = array_.load(std::memory_order_acquire);
+    T value = array->get(top);
+    if (!top_.compare_exchange_strong(top, top + 1,
+                                      std::memory_order_seq_cst,
+                                      std::memory_order_relaxed))
+      return false;
+    out = value;
+    return true;
+  }
+
+  // snapshots unless called by the owner with no thieves around
+  inline bool empty() const noexcept { return size() == 0; }
+
+  inline size_type size() const noexcept {
+    const std::int64_t top = top_.load(std::memory_order_acquire);
+    const std::int64_t bottom = bottom_.load(std::memory_order_acquire);
+    return bottom > top ? static_cast<size_type>(bottom - top) : 0;
+  }
+
+  inline size_type capacity() const noexcept {
+    return array_.load(std::memory_order_relaxed)->mask + 1;
+  }
+
+ private:
+  struct Array {
+    Array(size_type capacity, Array *previous_array)
+        : mask(capacity - 1),
+          previous(previous_array),
+          cells(new std::atomic<T>[capacity]) {}
+    ~Array() { delete[] cells; }
+
+    inline T get(std::int64_t index) const noexcept {
+      return cells[static_cast<size_type>(index) & mask].load(
+          std::memory_order_relaxed);
+    }
+    inline void put(std::int64_t index, T value) noexcept {
+      cells[static_cast<size_type>(index) & mask].store(
+          value, std::memory_order_relaxed);
+    }
+
+    size_type mask;
+    Array *previous;  // предыдущий, более мелкий буфер
+    std::atomic<T> *cells;
+  };
+
+  static size_type roundUp(size_type n) noexcept {
+    size_type capacity = 2;
+    while (capacity < n) capacity <<= 1;
+    return capacity;
+  }
+
+  // копирует живые [top, bottom) в буфер вдвое больше; индексы не меняются
+  Array *grow(Array *array, std::int64_t top, std::int64_t bottom) {
+    Array *bigger = new Array(2 * (array->mask + 1), array);
+    for (std::int64_t i = top; i < bottom; ++i) bigger->put(i, array->get(i));
+    array_.store(bigger, std::memory_order_release);
+    return bigger;
+  }
+
+  alignas(kCacheLineSize) std::atomic<std::int64_t> top_{0};
+  alignas(kCacheLineSize) std::atomic<std::int64_t> bottom_{0};
+  std::atomic<Array *> array_;
+};
+
+}  // namespace s21
+
+#endif  // S21_CONTAINERS_SRC_S21_WORK_STEALING_DEQUE_H_